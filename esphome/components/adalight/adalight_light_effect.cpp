@@ -41,9 +41,7 @@ void AdalightLightEffect::reset_frame_(light::AddressableLight &it) {
 }
 
 void AdalightLightEffect::blank_all_leds_(light::AddressableLight &it) {
-  for (int led = it.size(); led-- > 0;) {
-    it[led].set(Color::BLACK);
-  }
+  it.fill(0, it.size(), Color::BLACK);
   it.schedule_show();
 }
 
@@ -125,14 +123,7 @@ AdalightLightEffect::Frame AdalightLightEffect::parse_frame_(light::AddressableL
     return PARTIAL;
 
   // Apply lights
-  auto accepted_led_count = std::min<int>(led_count, it.size());
-  uint8_t *led_data = &frame_[6];
-
-  for (int led = 0; led < accepted_led_count; led++, led_data += 3) {
-    auto white = std::min(std::min(led_data[0], led_data[1]), led_data[2]);
-
-    it[led].set(Color(led_data[0], led_data[1], led_data[2], white));
-  }
+  it.write_pixels(0, &frame_[6], led_count, light::PIXEL_FORMAT_RGB_WHITE_MIN);
 
   it.schedule_show();
   return CONSUMED;
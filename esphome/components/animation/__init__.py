@@ -3,7 +3,7 @@ import logging
 from esphome import automation, core
 from esphome.components import font
 import esphome.components.image as espImage
-from esphome.components.image import CONF_USE_TRANSPARENCY
+from esphome.components.image import CONF_COMPRESSION, CONF_USE_TRANSPARENCY
 import esphome.config_validation as cv
 import esphome.codegen as cg
 from esphome.const import (
@@ -82,6 +82,9 @@ ANIMATION_SCHEMA = cv.Schema(
                     cv.Optional(CONF_REPEAT): cv.positive_int,
                 }
             ),
+            cv.Optional(CONF_COMPRESSION, default="NONE"): cv.enum(
+                espImage.IMAGE_COMPRESSION, upper=True
+            ),
             cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
         },
         validate_cross_dependencies,
@@ -121,6 +124,41 @@ async def animation_action_to_code(config, action_id, template_arg, args):
     return var
 
 
+def rle_encode_frames(data, width, height, frames, image_type):
+    """Compress the frames, each as a key frame or a delta to the frame before.
+
+    The result starts with a table of the offset of every frame, with the
+    highest bit set for delta frames.
+    """
+    frame_size = len(data) // frames
+    table = []
+    encoded = []
+    offset = frames * 4
+    previous = None
+    chain = 0
+    for frame_index in range(frames):
+        frame_data = data[frame_index * frame_size : (frame_index + 1) * frame_size]
+        pixels = espImage.split_pixels(frame_data, width, height, image_type)
+        frame = espImage.rle_encode(pixels, width, height)
+        is_delta = False
+        if previous is not None and chain + 1 < espImage.RLE_MAX_FRAMES:
+            delta = espImage.rle_encode(pixels, width, height, previous)
+            if len(delta) < len(frame):
+                frame = delta
+                is_delta = True
+        chain = chain + 1 if is_delta else 0
+        table.append(offset | (0x80000000 if is_delta else 0))
+        encoded += frame
+        offset += len(frame)
+        previous = pixels
+
+    _LOGGER.debug("Compressed %d frames from %d to %d bytes", frames, len(data), offset)
+    header = []
+    for entry in table:
+        header += [entry & 0xFF, (entry >> 8) & 0xFF, (entry >> 16) & 0xFF, entry >> 24]
+    return header + encoded
+
+
 async def to_code(config):
     from PIL import Image
 
@@ -278,6 +316,10 @@ async def to_code(config):
             f"Animation f{config[CONF_ID]} has not supported type {config[CONF_TYPE]}."
         )
 
+    compression = config[CONF_COMPRESSION]
+    if compression == "RLE":
+        data = rle_encode_frames(data, width, height, frames, config[CONF_TYPE])
+
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
     var = cg.new_Pvariable(
@@ -289,6 +331,8 @@ async def to_code(config):
         espImage.IMAGE_TYPE[config[CONF_TYPE]],
     )
     cg.add(var.set_transparency(transparent))
+    if compression != "NONE":
+        cg.add(var.set_compression(espImage.IMAGE_COMPRESSION[compression]))
     if loop_config := config.get(CONF_LOOP):
         start = loop_config[CONF_START_FRAME]
         end = loop_config.get(CONF_END_FRAME, frames)
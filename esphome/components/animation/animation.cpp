@@ -62,9 +62,34 @@ void Animation::set_frame(int frame) {
 }
 
 void Animation::update_data_start_() {
+  if (this->compression_ != image::IMAGE_COMPRESSION_NONE) {
+    // the frames are found through the offset table, see get_rle_frames_()
+    return;
+  }
   const uint32_t image_size = image_type_to_width_stride(this->width_, this->type_) * this->height_;
   this->data_start_ = this->animation_data_start_ + image_size * this->current_frame_;
 }
 
+static const uint32_t RLE_DELTA_FRAME = 0x80000000UL;
+
+uint32_t Animation::get_rle_frame_offset_(uint32_t frame) const {
+  const uint8_t *entry = this->animation_data_start_ + frame * 4;
+  return encode_uint32(progmem_read_byte(entry + 3), progmem_read_byte(entry + 2), progmem_read_byte(entry + 1),
+                       progmem_read_byte(entry));
+}
+
+size_t Animation::get_rle_frames_(const uint8_t **frames) const {
+  // codegen starts a new key frame before the chain of deltas gets longer than that
+  uint32_t key_frame = this->current_frame_;
+  while (key_frame > 0 && (this->get_rle_frame_offset_(key_frame) & RLE_DELTA_FRAME) != 0 &&
+         this->current_frame_ - key_frame + 1 < image::IMAGE_RLE_MAX_FRAMES)
+    key_frame--;
+
+  size_t count = 0;
+  for (uint32_t frame = key_frame; frame <= uint32_t(this->current_frame_); frame++)
+    frames[count++] = this->animation_data_start_ + (this->get_rle_frame_offset_(frame) & ~RLE_DELTA_FRAME);
+  return count;
+}
+
 }  // namespace animation
 }  // namespace esphome
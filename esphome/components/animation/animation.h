@@ -25,6 +25,13 @@ class Animation : public image::Image {
 
  protected:
   void update_data_start_();
+  /** With RLE compression the data starts with a table of 32 bit little endian offsets, one per frame.
+   *
+   * The highest bit of an offset is set for a delta frame, which only holds the pixels that differ from the frame
+   * before it. Delta frames are drawn by decoding the key frame before them and each delta up to the current frame.
+   */
+  size_t get_rle_frames_(const uint8_t **frames) const override;
+  uint32_t get_rle_frame_offset_(uint32_t frame) const;
 
   const uint8_t *animation_data_start_;
   int current_frame_;
@@ -47,6 +47,7 @@ SERVICE_ARG_NATIVE_TYPES = {
     "string[]": cg.std_vector.template(cg.std_string),
 }
 CONF_ENCRYPTION = "encryption"
+CONF_BATCH_DELAY = "batch_delay"
 
 
 def validate_encryption_key(value):
@@ -89,6 +90,11 @@ CONFIG_SCHEMA = cv.Schema(
                 cv.Required(CONF_KEY): validate_encryption_key,
             }
         ),
+        # Send the messages of this period together, trades latency for fewer packets.
+        # Off (0ms) by default.
+        cv.Optional(
+            CONF_BATCH_DELAY, default="0ms"
+        ): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_ON_CLIENT_CONNECTED): automation.validate_automation(
             single=True
         ),
@@ -107,6 +113,7 @@ async def to_code(config):
     cg.add(var.set_port(config[CONF_PORT]))
     cg.add(var.set_password(config[CONF_PASSWORD]))
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    cg.add(var.set_batch_delay(config[CONF_BATCH_DELAY]))
 
     for conf in config.get(CONF_SERVICES, []):
         template_args = []
@@ -20,6 +20,9 @@
 #ifdef USE_VOICE_ASSISTANT
 #include "esphome/components/voice_assistant/voice_assistant.h"
 #endif
+#ifdef USE_LOGGER
+#include "esphome/components/logger/logger.h"
+#endif
 
 namespace esphome {
 namespace api {
@@ -113,10 +116,30 @@ void APIConnection::loop() {
     this->read_message(buffer.data_len, buffer.type, &buffer.container[buffer.data_offset]);
     if (this->remove_)
       return;
+    // don't delay the response to the client
+    if (this->helper_->is_batching()) {
+      err = this->helper_->end_batch();
+      if (err != APIError::OK) {
+        on_fatal_error();
+        ESP_LOGW(TAG, "%s: Sending batch failed: %s errno=%d", this->client_combined_info_.c_str(),
+                 api_error_to_str(err), errno);
+        return;
+      }
+    }
   }
 
-  this->list_entities_iterator_.advance();
-  this->initial_state_iterator_.advance();
+  this->advance_iterator_batched_(this->list_entities_iterator_);
+  this->advance_iterator_batched_(this->initial_state_iterator_);
+
+  if (this->helper_->is_batching() && millis() - this->batch_start_ >= this->parent_->get_batch_delay()) {
+    err = this->helper_->end_batch();
+    if (err != APIError::OK) {
+      on_fatal_error();
+      ESP_LOGW(TAG, "%s: Sending batch failed: %s errno=%d", this->client_combined_info_.c_str(),
+               api_error_to_str(err), errno);
+      return;
+    }
+  }
 
   static uint32_t keepalive = 60000;
   static uint8_t max_ping_retries = 60;
@@ -151,7 +174,8 @@ void APIConnection::loop() {
 #ifdef USE_ESP32_CAMERA
   if (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
     uint32_t to_send = std::min((size_t) 1024, this->image_reader_.available());
-    auto buffer = this->create_buffer();
+    // fixed32 key = 1 (5 bytes), bytes data = 2 (up to 3 bytes header), bool done = 3 (2 bytes)
+    auto buffer = this->create_buffer(10 + to_send);
     // fixed32 key = 1;
     buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
     // bytes data = 2;
@@ -186,6 +210,34 @@ void APIConnection::loop() {
   }
 }
 
+bool APIConnection::is_idle_() {
+  // the loop is needed to send pending data and batches, and to go through the entities and subscriptions
+  if (this->remove_ || this->next_close_ || !this->ready_watched_ || this->helper_->is_batching() ||
+      !this->helper_->can_write_without_blocking())
+    return false;
+  if (!this->list_entities_iterator_.completed() || !this->initial_state_iterator_.completed() ||
+      this->state_subs_at_ != -1)
+    return false;
+#ifdef USE_ESP32_CAMERA
+  if (this->image_reader_.available())
+    return false;
+#endif
+  return true;
+}
+
+void APIConnection::advance_iterator_batched_(ComponentIterator &iterator) {
+  if (this->parent_->get_batch_delay() == 0) {
+    iterator.advance();
+    return;
+  }
+  // keep filling the batch until the iterator stops producing messages or the batch has been sent
+  size_t batch_size;
+  do {
+    batch_size = this->helper_->batch_size();
+    iterator.advance();
+  } while (this->helper_->is_batching() && this->helper_->batch_size() > batch_size);
+}
+
 std::string get_default_unique_id(const std::string &component_type, EntityBase *entity) {
   return App.get_name() + component_type + entity->get_object_id();
 }
@@ -894,8 +946,10 @@ void APIConnection::send_camera_state(std::shared_ptr<esp32_camera::CameraImage>
   if (this->image_reader_.available())
     return;
   if (image->was_requested_by(esphome::esp32_camera::API_REQUESTER) ||
-      image->was_requested_by(esphome::esp32_camera::IDLE))
+      image->was_requested_by(esphome::esp32_camera::IDLE)) {
     this->image_reader_.set_image(std::move(image));
+    this->parent_->enable_loop();
+  }
 }
 bool APIConnection::send_camera_info(esp32_camera::ESP32Camera *camera) {
   ListEntitiesCameraResponse msg;
@@ -1081,17 +1135,70 @@ void APIConnection::alarm_control_panel_command(const AlarmControlPanelCommandRe
 bool APIConnection::send_log_message(int level, const char *tag, const char *line) {
   if (this->log_subscription_ < level)
     return false;
+#ifdef USE_LOGGER
+  if (this->log_compact_)
+    return this->send_compact_log_message_(level, tag);
+#endif
 
   // Send raw so that we don't copy too much
-  auto buffer = this->create_buffer();
+  size_t line_length = strlen(line);
+  uint32_t msg_size = 0;
+  // LogLevel level = 1;
+  ProtoSize::add_uint32_field(msg_size, 1, static_cast<uint32_t>(level));
+  // string message = 3;
+  ProtoSize::add_string_field(msg_size, 3, line_length);
+  auto buffer = this->create_buffer(msg_size);
   // LogLevel level = 1;
   buffer.encode_uint32(1, static_cast<uint32_t>(level));
   // string message = 3;
-  buffer.encode_string(3, line, strlen(line));
+  buffer.encode_string(3, line, line_length);
   // SubscribeLogsResponse - 29
   return this->send_buffer(buffer, 29);
 }
 
+#ifdef USE_LOGGER
+bool APIConnection::send_compact_log_message_(int level, const char *tag) {
+  logger::LogRecord record = logger::global_logger->get_current_record();
+  size_t message_length = record.message_length;
+  if (message_length > 0 && record.message[message_length - 1] == '\n')
+    message_length--;
+
+  // tags are static strings, so they're identified by their address
+  uint32_t tag_id = 0;
+  while (tag_id < this->log_tags_.size() && this->log_tags_[tag_id] != tag)
+    tag_id++;
+  bool new_tag = tag_id == this->log_tags_.size();
+  size_t tag_length = new_tag ? strlen(tag) : 0;
+
+  uint32_t msg_size = 0;
+  ProtoSize::add_uint32_field(msg_size, 1, static_cast<uint32_t>(level));
+  ProtoSize::add_string_field(msg_size, 3, message_length);
+  ProtoSize::add_uint32_field(msg_size, 5, tag_id, true);
+  ProtoSize::add_string_field(msg_size, 6, tag_length);
+  ProtoSize::add_uint32_field(msg_size, 7, record.line);
+  ProtoSize::add_uint32_field(msg_size, 8, record.timestamp);
+  auto buffer = this->create_buffer(msg_size);
+  // LogLevel level = 1;
+  buffer.encode_uint32(1, static_cast<uint32_t>(level));
+  // string message = 3;
+  buffer.encode_string(3, record.message, message_length);
+  // uint32 tag_id = 5;
+  buffer.encode_uint32(5, tag_id, true);
+  // string tag = 6;
+  buffer.encode_string(6, tag, tag_length);
+  // uint32 line = 7;
+  buffer.encode_uint32(7, record.line);
+  // uint32 timestamp = 8;
+  buffer.encode_uint32(8, record.timestamp);
+  // SubscribeLogsResponse - 29
+  bool success = this->send_buffer(buffer, 29);
+  // only remember the tag once the client has received its name
+  if (success && new_tag)
+    this->log_tags_.push_back(tag);
+  return success;
+}
+#endif
+
 HelloResponse APIConnection::hello(const HelloRequest &msg) {
   this->client_info_ = msg.client_info;
   this->client_peername_ = this->helper_->getpeername();
@@ -1169,6 +1276,36 @@ DeviceInfoResponse APIConnection::device_info(const DeviceInfoRequest &msg) {
 #endif
   return resp;
 }
+#ifdef USE_PROFILER
+ProfilerStatsResponse APIConnection::profiler_stats(const ProfilerStatsRequest &msg) {
+  ProfilerStatsResponse resp{};
+  resp.period_ms = App.get_profile_period();
+  for (auto *component : App.get_components()) {
+    ProfilerComponentStats stats;
+    stats.source = component->get_component_source();
+    stats.setup_us = component->get_setup_stats().total_us;
+    stats.loop_count = component->get_loop_stats().count;
+    stats.loop_total_us = component->get_loop_stats().total_us;
+    stats.loop_max_us = component->get_loop_stats().max_us;
+    stats.scheduler_count = component->get_scheduler_stats().count;
+    stats.scheduler_total_us = component->get_scheduler_stats().total_us;
+    stats.scheduler_max_us = component->get_scheduler_stats().max_us;
+    resp.components.push_back(stats);
+  }
+  for (auto &profile : App.scheduler.get_profiles()) {
+    ProfilerSchedulerItemStats stats;
+    stats.source = profile.component != nullptr ? profile.component->get_component_source() : "";
+    stats.name = profile.name;
+    stats.count = profile.stats.count;
+    stats.total_us = profile.stats.total_us;
+    stats.max_us = profile.stats.max_us;
+    resp.scheduler_items.push_back(stats);
+  }
+  if (msg.reset)
+    App.reset_profile_stats();
+  return resp;
+}
+#endif
 void APIConnection::on_home_assistant_state_response(const HomeAssistantStateResponse &msg) {
   for (auto &it : this->parent_->get_state_subs()) {
     if (it.entity_id == msg.entity_id && it.attribute.value() == msg.attribute) {
@@ -1193,6 +1330,8 @@ void APIConnection::subscribe_home_assistant_states(const SubscribeHomeAssistant
 bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) {
   if (this->remove_)
     return false;
+  // the batch or any data that can't be written right away is sent from the loop
+  this->parent_->enable_loop();
   if (!this->helper_->can_write_without_blocking()) {
     delay(0);
     APIError err = this->helper_->loop();
@@ -1212,7 +1351,13 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
   }
 
-  APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+  if (!this->helper_->is_batching() && this->parent_->get_batch_delay() != 0) {
+    // collect the messages of the next batch_delay ms, so they're sent together
+    this->helper_->begin_batch();
+    this->batch_start_ = millis();
+  }
+
+  APIError err = this->helper_->write_protobuf_packet(message_type, buffer);
   if (err == APIError::WOULD_BLOCK)
     return false;
   if (err != APIError::OK) {
@@ -137,6 +137,10 @@ class APIConnection : public APIServerConnection {
   void alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) override;
 #endif
 
+#ifdef USE_PROFILER
+  ProfilerStatsResponse profiler_stats(const ProfilerStatsRequest &msg) override;
+#endif
+
   void on_disconnect_response(const DisconnectResponse &value) override;
   void on_ping_response(const PingResponse &value) override {
     // we initiated ping
@@ -159,6 +163,8 @@ class APIConnection : public APIServerConnection {
   }
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
+    this->log_compact_ = msg.compact;
+    this->log_tags_.clear();
     if (msg.dump_config)
       App.schedule_dump_config();
   }
@@ -179,9 +185,14 @@ class APIConnection : public APIServerConnection {
   void on_fatal_error() override;
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
-  ProtoWriteBuffer create_buffer() override {
+  ProtoWriteBuffer create_buffer(uint32_t reserve_size) override {
     // FIXME: ensure no recursive writes can happen
+    // reserve space for the frame header in front of the message, so it can be sent without copying it
+    uint8_t header_padding = this->helper_->frame_header_padding();
+    uint8_t footer_size = this->helper_->frame_footer_size();
     this->proto_write_buffer_.clear();
+    this->proto_write_buffer_.reserve(header_padding + reserve_size + footer_size);
+    this->proto_write_buffer_.resize(header_padding);
     return {&this->proto_write_buffer_};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
@@ -192,6 +203,13 @@ class APIConnection : public APIServerConnection {
   friend APIServer;
 
   bool send_(const void *buf, size_t len, bool force);
+#ifdef USE_LOGGER
+  bool send_compact_log_message_(int level, const char *tag);
+#endif
+  /// Advance the iterator as long as its messages are collected into the current batch.
+  void advance_iterator_batched_(ComponentIterator &iterator);
+  /// Whether the loop has nothing to do until the client sends data or a message is sent to it.
+  bool is_idle_();
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -200,6 +218,8 @@ class APIConnection : public APIServerConnection {
   } connection_state_{ConnectionState::WAITING_FOR_HELLO};
 
   bool remove_{false};
+  /// The server's loop is enabled when the socket has data to read.
+  bool ready_watched_{false};
 
   // Buffer used to encode proto messages
   // Re-use to prevent allocations
@@ -217,7 +237,11 @@ class APIConnection : public APIServerConnection {
 
   bool state_subscription_{false};
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
+  bool log_compact_{false};
+  /// Tags sent to the client in compact log mode, the index is the tag_id.
+  std::vector<const char *> log_tags_;
   uint32_t last_traffic_;
+  uint32_t batch_start_{0};
   uint32_t next_ping_retry_{0};
   uint8_t ping_retries_{0};
   bool sent_ping_{false};
@@ -11,6 +11,8 @@ namespace esphome {
 namespace api {
 
 static const char *const TAG = "api.socket";
+/// Send a batch once it has grown to about one TCP segment.
+static const size_t MAX_BATCH_SIZE = 1400;
 
 /// Is the given return value (from write syscalls) a wouldblock error?
 bool is_would_block(ssize_t ret) {
@@ -76,6 +78,31 @@ const char *api_error_to_str(APIError err) {
 // uncomment to log raw packets
 //#define HELPER_LOG_PACKETS
 
+APIError APIFrameHelper::flush_batch() {
+  if (this->batch_buf_.empty())
+    return APIError::OK;
+
+  struct iovec iov;
+  iov.iov_base = this->batch_buf_.data();
+  iov.iov_len = this->batch_buf_.size();
+  // write the whole batch at once instead of collecting it again
+  bool batching = this->batching_;
+  this->batching_ = false;
+  APIError err = this->write_raw_(&iov, 1);
+  this->batching_ = batching;
+  this->batch_buf_.clear();
+  return err;
+}
+APIError APIFrameHelper::add_to_batch_(const struct iovec *iov, int iovcnt) {
+  for (int i = 0; i < iovcnt; i++) {
+    this->batch_buf_.insert(this->batch_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
+                            reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+  }
+  if (this->batch_buf_.size() < MAX_BATCH_SIZE)
+    return APIError::OK;
+  return this->flush_batch();
+}
+
 #ifdef USE_API_NOISE
 static const char *const PROLOGUE_INIT = "NoiseAPIInit";
 
@@ -467,7 +494,7 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APINoiseFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+APIError APINoiseFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
   int err;
   APIError aerr;
   aerr = state_action_();
@@ -479,31 +506,26 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
     return APIError::WOULD_BLOCK;
   }
 
-  size_t padding = 0;
-  size_t msg_len = 4 + payload_len + padding;
-  size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
-  auto tmpbuf = std::unique_ptr<uint8_t[]>{new (std::nothrow) uint8_t[frame_len]};
-  if (tmpbuf == nullptr) {
-    HELPER_LOG("Could not allocate for writing packet");
-    return APIError::OUT_OF_MEMORY;
-  }
-
-  tmpbuf[0] = 0x01;  // indicator
-  // tmpbuf[1], tmpbuf[2] to be set later
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  // the message was encoded after the reserved header space
+  size_t payload_len = raw_buffer->size() - frame_header_padding_;
+  size_t msg_len = 4 + payload_len;
+  size_t mac_len = noise_cipherstate_get_mac_length(send_cipher_);
+  // grow into the reserved footer space, the cipher appends the MAC in place
+  raw_buffer->resize(raw_buffer->size() + mac_len);
+  uint8_t *buf_start = raw_buffer->data();
+
+  buf_start[0] = 0x01;  // indicator
+  // buf_start[1], buf_start[2] to be set later
   const uint8_t msg_offset = 3;
-  const uint8_t payload_offset = msg_offset + 4;
-  tmpbuf[msg_offset + 0] = (uint8_t) (type >> 8);  // type
-  tmpbuf[msg_offset + 1] = (uint8_t) type;
-  tmpbuf[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
-  tmpbuf[msg_offset + 3] = (uint8_t) payload_len;
-  // copy data
-  std::copy(payload, payload + payload_len, &tmpbuf[payload_offset]);
-  // fill padding with zeros
-  std::fill(&tmpbuf[payload_offset + payload_len], &tmpbuf[frame_len], 0);
+  buf_start[msg_offset + 0] = (uint8_t) (type >> 8);  // type
+  buf_start[msg_offset + 1] = (uint8_t) type;
+  buf_start[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
+  buf_start[msg_offset + 3] = (uint8_t) payload_len;
 
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, &tmpbuf[msg_offset], msg_len, frame_len - msg_offset);
+  noise_buffer_set_inout(mbuf, buf_start + msg_offset, msg_len, msg_len + mac_len);
   err = noise_cipherstate_encrypt(send_cipher_, &mbuf);
   if (err != 0) {
     state_ = State::FAILED;
@@ -512,11 +534,11 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
   }
 
   size_t total_len = 3 + mbuf.size;
-  tmpbuf[1] = (uint8_t) (mbuf.size >> 8);
-  tmpbuf[2] = (uint8_t) mbuf.size;
+  buf_start[1] = (uint8_t) (mbuf.size >> 8);
+  buf_start[2] = (uint8_t) mbuf.size;
 
   struct iovec iov;
-  iov.iov_base = &tmpbuf[0];
+  iov.iov_base = buf_start;
   iov.iov_len = total_len;
 
   // write raw to not have two packets sent if NAGLE disabled
@@ -552,6 +574,11 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
     return APIError::OK;
   APIError aerr;
 
+  if (this->batching_ && this->state_ == State::DATA) {
+    // collect the frame, it's sent together with the rest of the batch
+    return this->add_to_batch_(iov, iovcnt);
+  }
+
   size_t total_write_len = 0;
   for (int i = 0; i < iovcnt; i++) {
 #ifdef HELPER_LOG_PACKETS
@@ -903,26 +930,34 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APIPlaintextFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+APIError APIPlaintextFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
 
-  std::vector<uint8_t> header;
-  header.push_back(0x00);
-  ProtoVarInt(payload_len).encode(header);
-  ProtoVarInt(type).encode(header);
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  // the message was encoded after the reserved header space
+  size_t payload_len = raw_buffer->size() - frame_header_padding_;
 
-  struct iovec iov[2];
-  iov[0].iov_base = &header[0];
-  iov[0].iov_len = header.size();
-  if (payload_len == 0) {
-    return write_raw_(iov, 1);
+  // the header has variable length, so it's written right-aligned against the message
+  uint8_t size_varint_len = ProtoSize::varint(static_cast<uint32_t>(payload_len));
+  uint8_t type_varint_len = ProtoSize::varint(static_cast<uint32_t>(type));
+  uint8_t total_header_len = 1 + size_varint_len + type_varint_len;
+  if (total_header_len > frame_header_padding_) {
+    HELPER_LOG("Packet too big to send");
+    return APIError::BAD_ARG;
   }
-  iov[1].iov_base = const_cast<uint8_t *>(payload);
-  iov[1].iov_len = payload_len;
 
-  return write_raw_(iov, 2);
+  uint8_t *buf_start = raw_buffer->data() + (frame_header_padding_ - total_header_len);
+  buf_start[0] = 0x00;  // indicator
+  ProtoVarInt(payload_len).encode_to_buffer_unchecked(buf_start + 1, size_varint_len);
+  ProtoVarInt(type).encode_to_buffer_unchecked(buf_start + 1 + size_varint_len, type_varint_len);
+
+  struct iovec iov;
+  iov.iov_base = buf_start;
+  iov.iov_len = total_header_len + payload_len;
+
+  return write_raw_(&iov, 1);
 }
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
@@ -952,6 +987,11 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
     return APIError::OK;
   APIError aerr;
 
+  if (this->batching_ && this->state_ == State::DATA) {
+    // collect the frame, it's sent together with the rest of the batch
+    return this->add_to_batch_(iov, iovcnt);
+  }
+
   size_t total_write_len = 0;
   for (int i = 0; i < iovcnt; i++) {
 #ifdef HELPER_LOG_PACKETS
@@ -12,6 +12,7 @@
 
 #include "api_noise_context.h"
 #include "esphome/components/socket/socket.h"
+#include "proto.h"
 
 namespace esphome {
 namespace api {
@@ -65,26 +66,66 @@ class APIFrameHelper {
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
-  virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  /** Write a message that was encoded in place after frame_header_padding() reserved bytes of the buffer.
+   *
+   * The frame header is written into the reserved space, so the message doesn't need to be copied.
+   */
+  virtual APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) = 0;
   virtual std::string getpeername() = 0;
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
   virtual APIError close() = 0;
   virtual APIError shutdown(int how) = 0;
   // Give this helper a name for logging
   virtual void set_log_info(std::string info) = 0;
+  /// Number of bytes to reserve in front of a message for the frame header.
+  uint8_t frame_header_padding() const { return this->frame_header_padding_; }
+  /// Number of bytes the frame may grow after the message, e.g. for a MAC.
+  uint8_t frame_footer_size() const { return this->frame_footer_size_; }
+  /** Collect written packets instead of sending each one separately.
+   *
+   * The collected frames are sent back to back with a single write once flush_batch() is called, or once about
+   * one TCP segment worth of data has been collected.
+   */
+  void begin_batch() { this->batching_ = true; }
+  /// Send all collected packets and stop batching.
+  APIError end_batch() {
+    this->batching_ = false;
+    return this->flush_batch();
+  }
+  /// Send all collected packets, but keep batching.
+  APIError flush_batch();
+  bool is_batching() const { return this->batching_; }
+  /// Number of bytes collected in the current batch.
+  size_t batch_size() const { return this->batch_buf_.size(); }
+
+ protected:
+  /// Write the data to the socket, or buffer it if a write would block.
+  virtual APIError write_raw_(const struct iovec *iov, int iovcnt) = 0;
+  /// Collect a frame into the batch, and send the batch once it has grown to about one TCP segment.
+  APIError add_to_batch_(const struct iovec *iov, int iovcnt);
+
+  uint8_t frame_header_padding_{0};
+  uint8_t frame_footer_size_{0};
+  bool batching_{false};
+  std::vector<uint8_t> batch_buf_;
 };
 
 #ifdef USE_API_NOISE
 class APINoiseFrameHelper : public APIFrameHelper {
  public:
   APINoiseFrameHelper(std::unique_ptr<socket::Socket> socket, std::shared_ptr<APINoiseContext> ctx)
-      : socket_(std::move(socket)), ctx_(std::move(std::move(ctx))) {}
+      : socket_(std::move(socket)), ctx_(std::move(std::move(ctx))) {
+    // 3 bytes frame header, 2 bytes message type, 2 bytes data length
+    this->frame_header_padding_ = 7;
+    // MAC of the ChaChaPoly cipher
+    this->frame_footer_size_ = 16;
+  }
   ~APINoiseFrameHelper() override;
   APIError init() override;
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -103,7 +144,7 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError try_read_frame_(ParsedFrame *frame);
   APIError try_send_tx_buf_();
   APIError write_frame_(const uint8_t *data, size_t len);
-  APIError write_raw_(const struct iovec *iov, int iovcnt);
+  APIError write_raw_(const struct iovec *iov, int iovcnt) override;
   APIError init_handshake_();
   APIError check_handshake_finished_();
   void send_explicit_handshake_reject_(const std::string &reason);
@@ -141,13 +182,16 @@ class APINoiseFrameHelper : public APIFrameHelper {
 #ifdef USE_API_PLAINTEXT
 class APIPlaintextFrameHelper : public APIFrameHelper {
  public:
-  APIPlaintextFrameHelper(std::unique_ptr<socket::Socket> socket) : socket_(std::move(socket)) {}
+  APIPlaintextFrameHelper(std::unique_ptr<socket::Socket> socket) : socket_(std::move(socket)) {
+    // 1 byte indicator, up to 3 bytes data length varint, up to 2 bytes message type varint
+    this->frame_header_padding_ = 6;
+  }
   ~APIPlaintextFrameHelper() override = default;
   APIError init() override;
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -164,7 +208,7 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
 
   APIError try_read_frame_(ParsedFrame *frame);
   APIError try_send_tx_buf_();
-  APIError write_raw_(const struct iovec *iov, int iovcnt);
+  APIError write_raw_(const struct iovec *iov, int iovcnt) override;
 
   std::unique_ptr<socket::Socket> socket_;
 
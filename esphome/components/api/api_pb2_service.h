@@ -257,6 +257,12 @@ class APIServerConnectionBase : public ProtoService {
 #endif
 #ifdef USE_TEXT
   virtual void on_text_command_request(const TextCommandRequest &value){};
+#endif
+#ifdef USE_PROFILER
+  virtual void on_profiler_stats_request(const ProfilerStatsRequest &value){};
+#endif
+#ifdef USE_PROFILER
+  bool send_profiler_stats_response(const ProfilerStatsResponse &msg);
 #endif
  protected:
   bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) override;
@@ -348,6 +354,9 @@ class APIServerConnection : public APIServerConnectionBase {
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
   virtual void alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) = 0;
+#endif
+#ifdef USE_PROFILER
+  virtual ProfilerStatsResponse profiler_stats(const ProfilerStatsRequest &msg) = 0;
 #endif
  protected:
   void on_hello_request(const HelloRequest &msg) override;
@@ -435,6 +444,9 @@ class APIServerConnection : public APIServerConnectionBase {
 #ifdef USE_ALARM_CONTROL_PANEL
   void on_alarm_control_panel_command_request(const AlarmControlPanelCommandRequest &msg) override;
 #endif
+#ifdef USE_PROFILER
+  void on_profiler_stats_request(const ProfilerStatsRequest &msg) override;
+#endif
 };
 
 }  // namespace api
@@ -19,6 +19,8 @@ namespace esphome {
 namespace api {
 
 static const char *const TAG = "api";
+/// How often the keepalive and the reboot timeout are checked while the loop is disabled.
+static const uint32_t IDLE_CHECK_INTERVAL = 1000;
 
 // APIServer
 void APIServer::setup() {
@@ -66,6 +68,9 @@ void APIServer::setup() {
     return;
   }
 
+  // only run the loop when a client connects or sends data, if the socket supports it
+  this->server_watched_ = this->socket_->set_ready_component(this);
+
 #ifdef USE_LOGGER
   if (logger::global_logger != nullptr) {
     logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
@@ -101,7 +106,9 @@ void APIServer::loop() {
       break;
     ESP_LOGD(TAG, "Accepted %s", sock->getpeername().c_str());
 
+    bool watched = sock->set_ready_component(this);
     auto *conn = new APIConnection(std::move(sock), this);
+    conn->ready_watched_ = watched;
     clients_.emplace_back(conn);
     conn->start();
   }
@@ -134,6 +141,13 @@ void APIServer::loop() {
       this->status_clear_warning();
     }
   }
+
+  // While all clients wait for data, only the keepalive and the reboot timeout need the loop, and not every loop
+  auto is_idle = [](const std::unique_ptr<APIConnection> &conn) { return conn->is_idle_(); };
+  if (this->server_watched_ && std::all_of(this->clients_.begin(), this->clients_.end(), is_idle)) {
+    this->set_timeout("idle", IDLE_CHECK_INTERVAL, [this]() { this->enable_loop(); });
+    this->disable_loop();
+  }
 }
 void APIServer::dump_config() {
   ESP_LOGCONFIG(TAG, "API Server:");
@@ -328,6 +342,8 @@ bool APIServer::is_connected() const { return !this->clients_.empty(); }
 void APIServer::on_shutdown() {
   for (auto &c : this->clients_) {
     c->send_disconnect_request(DisconnectRequest());
+    // there's no next loop to send the batch in
+    c->helper_->end_batch();
   }
   delay(10);
 }
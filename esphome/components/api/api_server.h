@@ -32,6 +32,13 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  /** Collect the messages sent to a client within \p batch_delay ms and send them with a single write.
+   *
+   * This saves packets and wakeups when many entities change at once, at the cost of up to \p batch_delay ms of extra
+   * latency per message. 0 (the default) sends every message right away.
+   */
+  void set_batch_delay(uint32_t batch_delay) { this->batch_delay_ = batch_delay; }
+  uint32_t get_batch_delay() const { return this->batch_delay_; }
 
 #ifdef USE_API_NOISE
   void set_noise_psk(psk_t psk) { noise_ctx_->set_psk(psk); }
@@ -110,7 +117,9 @@ class APIServer : public Component, public Controller {
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
+  uint32_t batch_delay_{0};
   uint32_t last_connected_{0};
+  bool server_watched_{false};
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::string password_;
   std::vector<HomeAssistantStateSubscription> state_subs_;
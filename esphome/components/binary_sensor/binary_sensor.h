@@ -42,7 +42,9 @@ class BinarySensor : public EntityBase, public EntityBase_DeviceClass {
    *
    * @param callback The void(bool) callback.
    */
-  void add_on_state_callback(std::function<void(bool)> &&callback);
+  template<typename F> void add_on_state_callback(F &&callback) {
+    this->state_callback_.add(std::forward<F>(callback));
+  }
 
   /** Publish a new state to the front-end.
    *
@@ -75,7 +77,7 @@ class BinarySensor : public EntityBase, public EntityBase_DeviceClass {
   virtual bool is_status_binary_sensor() const;
 
  protected:
-  CallbackManager<void(bool)> state_callback_{};
+  InlineCallbackManager<void(bool)> state_callback_{};
   Filter *filter_list_{nullptr};
   bool has_state_{false};
   bool publish_initial_state_{false};
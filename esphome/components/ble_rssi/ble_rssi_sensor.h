@@ -54,12 +54,10 @@ class BLERSSISensor : public sensor::Sensor, public esp32_ble_tracker::ESPBTDevi
         }
         break;
       case MATCH_BY_SERVICE_UUID:
-        for (auto uuid : device.get_service_uuids()) {
-          if (this->uuid_ == uuid) {
-            this->publish_state(device.get_rssi());
-            this->found_ = true;
-            return true;
-          }
+        if (device.get_advertisement().has_service_uuid(this->uuid_)) {
+          this->publish_state(device.get_rssi());
+          this->found_ = true;
+          return true;
         }
         break;
       case MATCH_BY_IBEACON_UUID:
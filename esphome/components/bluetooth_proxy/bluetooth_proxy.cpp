@@ -63,23 +63,32 @@ void BluetoothProxy::send_api_packet_(const esp32_ble_tracker::ESPBTDevice &devi
   api::BluetoothLEAdvertisementResponse resp;
   resp.address = device.address_uint64();
   resp.address_type = device.get_address_type();
-  if (!device.get_name().empty())
-    resp.name = device.get_name();
+  auto advertisement = device.get_advertisement();
+  StringRef name = advertisement.get_name();
+  if (!name.empty())
+    resp.name = name.str();
   resp.rssi = device.get_rssi();
-  for (auto uuid : device.get_service_uuids()) {
-    resp.service_uuids.push_back(uuid.to_string());
-  }
-  for (auto &data : device.get_service_datas()) {
-    api::BluetoothServiceData service_data;
-    service_data.uuid = data.uuid.to_string();
-    service_data.data.assign(data.data.begin(), data.data.end());
-    resp.service_data.push_back(std::move(service_data));
+  // straight from the advertisement, without going through the parsed copies of ESPBTDevice
+  for (auto record : advertisement) {
+    for (size_t i = 0, count = record.service_uuid_count(); i < count; i++) {
+      resp.service_uuids.push_back(record.service_uuid(i).to_string());
+    }
+    auto data = record.as_service_data();
+    if (data.has_value()) {
+      api::BluetoothServiceData service_data;
+      service_data.uuid = data->uuid.to_string();
+      service_data.data.assign(data->data, data->data + data->length);
+      resp.service_data.push_back(std::move(service_data));
+    }
   }
-  for (auto &data : device.get_manufacturer_datas()) {
-    api::BluetoothServiceData manufacturer_data;
-    manufacturer_data.uuid = data.uuid.to_string();
-    manufacturer_data.data.assign(data.data.begin(), data.data.end());
-    resp.manufacturer_data.push_back(std::move(manufacturer_data));
+  for (auto record : advertisement) {
+    auto data = record.as_manufacturer_data();
+    if (data.has_value()) {
+      api::BluetoothServiceData manufacturer_data;
+      manufacturer_data.uuid = data->uuid.to_string();
+      manufacturer_data.data.assign(data->data, data->data + data->length);
+      resp.manufacturer_data.push_back(std::move(manufacturer_data));
+    }
   }
   this->api_connection_->send_bluetooth_le_advertisement(resp);
 }
@@ -13,6 +13,7 @@ CODEOWNERS = ["@OttoWinter"]
 DEPENDENCIES = ["logger"]
 
 CONF_DEBUG_ID = "debug_id"
+CONF_PROFILER = "profiler"
 debug_ns = cg.esphome_ns.namespace("debug")
 DebugComponent = debug_ns.class_("DebugComponent", cg.PollingComponent)
 
@@ -21,6 +22,7 @@ CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(DebugComponent),
+            cv.Optional(CONF_PROFILER, default=False): cv.boolean,
             cv.Optional(CONF_DEVICE): cv.invalid(
                 "The 'device' option has been moved to the 'debug' text_sensor component"
             ),
@@ -44,3 +46,6 @@ CONFIG_SCHEMA = cv.All(
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
+
+    if config[CONF_PROFILER]:
+        cg.add_define("USE_PROFILER")
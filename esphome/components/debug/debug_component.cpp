@@ -1,6 +1,7 @@
 #include "debug_component.h"
 
 #include <algorithm>
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
@@ -440,8 +441,33 @@ void DebugComponent::update() {
   }
 #endif  // USE_ESP32
 #endif  // USE_SENSOR
+
+#ifdef USE_PROFILER
+  this->dump_profile_stats_();
+#endif
 }
 
+#ifdef USE_PROFILER
+void DebugComponent::dump_profile_stats_() {
+  ESP_LOGD(TAG, "Run time statistics of the last %.1fs (calls / total ms / max us):",
+           App.get_profile_period() / 1000.0f);
+  for (auto *component : App.get_components()) {
+    const ProfileStats &loop = component->get_loop_stats();
+    const ProfileStats &scheduler = component->get_scheduler_stats();
+    ESP_LOGD(TAG,
+             "  %-24s setup %7.3f, loop %8" PRIu32 " / %10.3f / %7" PRIu32 ", "
+             "scheduler %6" PRIu32 " / %10.3f / %7" PRIu32,
+             component->get_component_source(), component->get_setup_stats().total_us / 1000.0f, loop.count,
+             loop.total_us / 1000.0f, loop.max_us, scheduler.count, scheduler.total_us / 1000.0f, scheduler.max_us);
+  }
+  for (auto &profile : App.scheduler.get_profiles()) {
+    ESP_LOGD(TAG, "  %-24s '%s' %6" PRIu32 " / %10.3f / %7" PRIu32,
+             profile.component != nullptr ? profile.component->get_component_source() : "<null>",
+             profile.name.c_str(), profile.stats.count, profile.stats.total_us / 1000.0f, profile.stats.max_us);
+  }
+}
+#endif
+
 float DebugComponent::get_setup_priority() const { return setup_priority::LATE; }
 
 }  // namespace debug
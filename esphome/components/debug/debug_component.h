@@ -38,6 +38,10 @@ class DebugComponent : public PollingComponent {
 #endif  // USE_ESP32
 #endif  // USE_SENSOR
  protected:
+#ifdef USE_PROFILER
+  void dump_profile_stats_();
+#endif
+
   uint32_t free_heap_{};
 
 #ifdef USE_SENSOR
@@ -2,6 +2,7 @@
 
 #include <utility>
 
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -35,16 +36,8 @@ void HOT Display::line(int x1, int y1, int x2, int y2, Color color) {
     }
   }
 }
-void HOT Display::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = x; i < x + width; i++)
-    this->draw_pixel_at(i, y, color);
-}
-void HOT Display::vertical_line(int x, int y, int height, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = y; i < y + height; i++)
-    this->draw_pixel_at(x, i, color);
-}
+void HOT Display::horizontal_line(int x, int y, int width, Color color) { this->fill_span(x, y, width, color); }
+void HOT Display::vertical_line(int x, int y, int height, Color color) { this->fill_block(x, y, 1, height, color); }
 void Display::rectangle(int x1, int y1, int width, int height, Color color) {
   this->horizontal_line(x1, y1, width, color);
   this->horizontal_line(x1, y1 + height - 1, width, color);
@@ -52,10 +45,7 @@ void Display::rectangle(int x1, int y1, int width, int height, Color color) {
   this->vertical_line(x1 + width - 1, y1, height, color);
 }
 void Display::filled_rectangle(int x1, int y1, int width, int height, Color color) {
-  // Future: Use vertical_line and horizontal_line methods depending on rotation to reduce memory accesses.
-  for (int i = y1; i < y1 + height; i++) {
-    this->horizontal_line(x1, i, width, color);
-  }
+  this->fill_block(x1, y1, width, height, color);
 }
 void HOT Display::circle(int center_x, int center_xy, int radius, Color color) {
   int dx = -radius;
@@ -107,6 +97,55 @@ void Display::filled_circle(int center_x, int center_y, int radius, Color color)
   } while (dx <= 0);
 }
 
+void HOT Display::fill_span(int x, int y, int width, Color color) {
+  for (int i = x; i < x + width; i++)
+    this->draw_pixel_at(i, y, color);
+}
+void Display::fill_block(int x, int y, int width, int height, Color color) {
+  for (int i = y; i < y + height; i++)
+    this->fill_span(x, i, width, color);
+}
+
+/// Convert a pixel of draw_pixels_at() source data to an opaque color.
+static Color pixel_to_color(uint32_t value, ColorOrder order, ColorBitness bitness) {
+  Color color;
+  if (bitness == COLOR_BITNESS_565) {
+    // expand the channels by replicating their top bits, like images always did, so that full intensity stays 0xFF
+    uint8_t first = (value >> 11) & 0x1F, second = (value >> 5) & 0x3F, third = value & 0x1F;
+    color = ColorUtil::to_color(encode_uint24((first << 3) | (first >> 2), (second << 2) | (second >> 4),
+                                              (third << 3) | (third >> 2)),
+                                order, COLOR_BITNESS_888);
+  } else {
+    color = ColorUtil::to_color(value, order, bitness);
+  }
+  color.w = 0xFF;
+  return color;
+}
+
+void HOT Display::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                                 ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) {
+  size_t bytes_per_pixel = bitness == COLOR_BITNESS_888 ? 3 : bitness == COLOR_BITNESS_565 ? 2 : 1;
+  size_t line_stride = x_offset + w + x_pad;
+  for (int y = 0; y < h; y++) {
+    const uint8_t *src = ptr + ((y_offset + y) * line_stride + x_offset) * bytes_per_pixel;
+    for (int x = 0; x < w; x++, src += bytes_per_pixel) {
+      uint32_t color_value;
+      switch (bitness) {
+        case COLOR_BITNESS_888:
+          color_value = big_endian ? encode_uint24(src[0], src[1], src[2]) : encode_uint24(src[2], src[1], src[0]);
+          break;
+        case COLOR_BITNESS_565:
+          color_value = big_endian ? encode_uint16(src[0], src[1]) : encode_uint16(src[1], src[0]);
+          break;
+        default:
+          color_value = src[0];
+          break;
+      }
+      this->draw_pixel_at(x_start + x, y_start + y, pixel_to_color(color_value, order, bitness));
+    }
+  }
+}
+
 void Display::print(int x, int y, BaseFont *font, Color color, TextAlign align, const char *text) {
   int x_start, y_start;
   int width, height;
@@ -350,8 +389,9 @@ bool Display::clamp_x_(int x, int w, int &min_x, int &max_x) {
     if (!rect.is_set())
       return false;
 
+    // Rect::inside() lets draw_pixel_at() draw on the right and bottom edge as well, so blocks have to include them
     min_x = std::max(min_x, (int) rect.x);
-    max_x = std::min(max_x, (int) rect.x2());
+    max_x = std::min(max_x, (int) rect.x2() + 1);
   }
 
   return min_x < max_x;
@@ -366,7 +406,7 @@ bool Display::clamp_y_(int y, int h, int &min_y, int &max_y) {
       return false;
 
     min_y = std::max(min_y, (int) rect.y);
-    max_y = std::min(max_y, (int) rect.y2());
+    max_y = std::min(max_y, (int) rect.y2() + 1);
   }
 
   return min_y < max_y;
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "rect.h"
+#include "display_color_utils.h"
 
 #include "esphome/core/color.h"
 #include "esphome/core/automation.h"
@@ -207,6 +208,50 @@ class Display : public PollingComponent {
   /// Fill a circle centered around [center_x,center_y] with the radius radius with the given color.
   void filled_circle(int center_x, int center_y, int radius, Color color = COLOR_ON);
 
+  /** Fill the `width` pixels starting at [x,y] to the right with the given color.
+   *
+   * All lines and filled shapes are drawn with this and fill_block(). By default they draw pixel by pixel, displays
+   * with a frame buffer override them to write whole runs at once.
+   */
+  virtual void fill_span(int x, int y, int width, Color color);
+
+  /// Fill a block of pixels with the top left point at [x,y], by default one fill_span() per row.
+  virtual void fill_block(int x, int y, int width, int height, Color color);
+
+  /** Draw a rectangle of pixels from memory with the top left point at [x_start,y_start].
+   *
+   * Displays that use the same pixel format in their frame buffer can copy the data as is, otherwise it's converted
+   * and drawn pixel by pixel.
+   *
+   * @param x_start The x coordinate of the upper left corner.
+   * @param y_start The y coordinate of the upper left corner.
+   * @param w The width of the rectangle to draw.
+   * @param h The height of the rectangle to draw.
+   * @param ptr The pixel data, which has to be directly addressable (i.e. not in flash on the ESP8266).
+   * @param order The color order of the pixels.
+   * @param bitness The number of bits per pixel.
+   * @param big_endian Whether the bytes of a pixel are stored most significant first.
+   * @param x_offset The number of pixels to skip at the start of each row of the source.
+   * @param y_offset The number of rows to skip at the start of the source.
+   * @param x_pad The number of pixels to skip at the end of each row of the source.
+   */
+  virtual void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                              ColorBitness bitness, bool big_endian, int x_offset = 0, int y_offset = 0,
+                              int x_pad = 0);
+
+  /** Move `height` rows starting at `src_y` to `dst_y`, e.g. to scroll part of the screen without redrawing it.
+   *
+   * @return false if the display can't copy rows (in the current rotation or while clipping), in which case the
+   * caller has to draw the rows again.
+   */
+  virtual bool copy_rows(int src_y, int dst_y, int height) { return false; }
+
+  /** Move the `width` x `height` block at [src_x,src_y] to [dst_x,dst_y], e.g. to scroll a part of a row sideways.
+   *
+   * The blocks may overlap. Like copy_rows(), this returns false if the display can't copy the block.
+   */
+  virtual bool copy_block(int src_x, int src_y, int width, int height, int dst_x, int dst_y) { return false; }
+
   /** Print `text` with the anchor point at [x,y] with `font`.
    *
    * @param x The x coordinate of the text alignment anchor point.
@@ -440,6 +485,7 @@ class Display : public PollingComponent {
 
   // Internal method to set display auto clearing.
   void set_auto_clear(bool auto_clear_enabled) { this->auto_clear_enabled_ = auto_clear_enabled; }
+  bool is_auto_clear_enabled() const { return this->auto_clear_enabled_; }
 
   DisplayRotation get_rotation() const { return this->rotation_; }
 
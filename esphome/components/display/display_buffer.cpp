@@ -17,6 +17,8 @@ void DisplayBuffer::init_internal_(uint32_t buffer_length) {
     ESP_LOGE(TAG, "Could not allocate buffer for display!");
     return;
   }
+  this->dirty_bands_.assign((this->get_height_internal() + (1 << DIRTY_BAND_SHIFT) - 1) >> DIRTY_BAND_SHIFT,
+                            DirtyBand{});
   this->clear();
 }
 
@@ -68,5 +70,68 @@ void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
   App.feed_wdt();
 }
 
+void HOT DisplayBuffer::fill_block(int x, int y, int width, int height, Color color) {
+  int x1, x2, y1, y2;
+  if (!this->clamp_x_(x, width, x1, x2) || !this->clamp_y_(y, height, y1, y2))
+    return;
+  width = x2 - x1;
+  height = y2 - y1;
+
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      x = x1;
+      y = y1;
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      x = this->get_width_internal() - y2;
+      y = x1;
+      std::swap(width, height);
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      x = this->get_width_internal() - x2;
+      y = this->get_height_internal() - y2;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      x = y1;
+      y = this->get_height_internal() - x2;
+      std::swap(width, height);
+      break;
+  }
+  this->fill_absolute_block_internal(x, y, width, height, color);
+  App.feed_wdt();
+}
+
+void HOT DisplayBuffer::fill_absolute_block_internal(int x, int y, int width, int height, Color color) {
+  for (int j = y; j < y + height; j++) {
+    for (int i = x; i < x + width; i++)
+      this->draw_absolute_pixel_internal(i, j, color);
+  }
+}
+
+bool DisplayBuffer::take_dirty_region_(size_t &band, int &x1, int &y1, int &x2, int &y2) {
+  while (band < this->dirty_bands_.size() && !this->dirty_bands_[band].is_dirty())
+    band++;
+  if (band >= this->dirty_bands_.size())
+    return false;
+
+  DirtyBand &first = this->dirty_bands_[band++];
+  x1 = first.x_low;
+  y1 = first.y_low;
+  x2 = first.x_high;
+  y2 = first.y_high;
+  first.clear();
+  while (band < this->dirty_bands_.size()) {
+    DirtyBand &next = this->dirty_bands_[band];
+    if (!next.is_dirty() || next.y_low != y2 + 1)
+      break;
+    x1 = std::min<int>(x1, next.x_low);
+    x2 = std::max<int>(x2, next.x_high);
+    y2 = next.y_high;
+    next.clear();
+    band++;
+  }
+  return true;
+}
+
 }  // namespace display
 }  // namespace esphome
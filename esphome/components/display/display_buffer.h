@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdarg>
+#include <cstdint>
 #include <vector>
 
 #include "display.h"
@@ -22,15 +24,59 @@ class DisplayBuffer : public Display {
   /// Set a single pixel at the specified coordinates to the given color.
   void draw_pixel_at(int x, int y, Color color) override;
 
+  void fill_span(int x, int y, int width, Color color) override { this->fill_block(x, y, width, 1, color); }
+  /// Clip the block and rotate it to display coordinates, then fill it with fill_absolute_block_internal().
+  void fill_block(int x, int y, int width, int height, Color color) override;
+
   virtual int get_height_internal() = 0;
   virtual int get_width_internal() = 0;
 
  protected:
+  /// Number of rows in a band of the dirty region tracking, as a power of two.
+  static const uint8_t DIRTY_BAND_SHIFT = 4;
+
+  /// The changed part of a band of rows, in display coordinates.
+  struct DirtyBand {
+    int16_t x_low{INT16_MAX};
+    int16_t y_low{INT16_MAX};
+    int16_t x_high{-1};
+    int16_t y_high{-1};
+
+    bool is_dirty() const { return this->x_low <= this->x_high; }
+    void clear() { *this = DirtyBand{}; }
+  };
+
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
+  /// Fill a block in display coordinates that lies within the display. By default it draws pixel by pixel.
+  virtual void fill_absolute_block_internal(int x, int y, int width, int height, Color color);
 
   void init_internal_(uint32_t buffer_length);
 
+  /** Mark the pixels from [x1,y1] to [x2,y2] (inclusive, in display coordinates) as changed.
+   *
+   * Each band of rows keeps the bounding box of its changes, so that drivers can send only those parts to the
+   * display. Separate changes in different parts of the screen don't end up in one big bounding box that way.
+   */
+  void mark_dirty_(int x1, int y1, int x2, int y2) {
+    int last = std::min(y2 >> DIRTY_BAND_SHIFT, int(this->dirty_bands_.size()) - 1);
+    for (int band = y1 >> DIRTY_BAND_SHIFT; band <= last; band++) {
+      DirtyBand &dirty = this->dirty_bands_[band];
+      dirty.x_low = std::min<int>(dirty.x_low, x1);
+      dirty.x_high = std::max<int>(dirty.x_high, x2);
+      dirty.y_low = std::min<int>(dirty.y_low, std::max(y1, band << DIRTY_BAND_SHIFT));
+      dirty.y_high = std::max<int>(dirty.y_high, std::min(y2, ((band + 1) << DIRTY_BAND_SHIFT) - 1));
+    }
+  }
+  /** Get the next changed region from band `band` on, and mark it as unchanged.
+   *
+   * Changes in adjacent bands that touch are returned as one region, so a full redraw still is a single region.
+   *
+   * @return false if there are no more changed regions.
+   */
+  bool take_dirty_region_(size_t &band, int &x1, int &y1, int &x2, int &y2);
+
   uint8_t *buffer_{nullptr};
+  std::vector<DirtyBand> dirty_bands_;
 };
 
 }  // namespace display
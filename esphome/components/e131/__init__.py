@@ -23,11 +23,13 @@ CHANNELS = {
 
 CONF_UNIVERSE = "universe"
 CONF_E131_ID = "e131_id"
+CONF_SYNC_UNIVERSE = "sync_universe"
 
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(E131Component),
         cv.Optional(CONF_METHOD, default="MULTICAST"): cv.one_of(*METHODS, upper=True),
+        cv.Optional(CONF_SYNC_UNIVERSE): cv.int_range(min=1, max=63999),
     }
 )
 
@@ -36,6 +38,8 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     cg.add(var.set_method(METHODS[config[CONF_METHOD]]))
+    if CONF_SYNC_UNIVERSE in config:
+        cg.add(var.set_sync_universe(config[CONF_SYNC_UNIVERSE]))
 
 
 @register_addressable_effect(
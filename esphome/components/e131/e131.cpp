@@ -7,6 +7,8 @@ namespace e131 {
 
 static const char *const TAG = "e131";
 static const int PORT = 5568;
+/// Upper limit of the datagrams read in one loop, so that a flood of packets can't block the main loop.
+static const int MAX_PACKETS_PER_LOOP = 32;
 
 E131Component::E131Component() {}
 
@@ -48,30 +50,44 @@ void E131Component::setup() {
     return;
   }
 
+  if (this->sync_universe_ != 0)
+    join_(this->sync_universe_);
   join_igmp_groups_();
+
+  // only run the loop when packets arrive, if the socket supports it
+  this->ready_watched_ = this->socket_->set_ready_component(this);
 }
 
 void E131Component::loop() {
-  std::vector<uint8_t> payload;
   E131Packet packet;
   int universe = 0;
   uint8_t buf[1460];
 
-  ssize_t len = this->socket_->read(buf, sizeof(buf));
-  if (len == -1) {
-    return;
+  // Read all pending packets, so that older frames are skipped when they come in faster than they can be shown
+  bool drained = false;
+  for (int i = 0; i < MAX_PACKETS_PER_LOOP; i++) {
+    ssize_t len = this->socket_->read(buf, sizeof(buf));
+    if (len == -1) {
+      drained = true;
+      break;
+    }
+
+    if (this->sync_packet_(buf, len, universe)) {
+      this->process_sync_(universe);
+    } else if (!this->packet_(buf, len, universe, packet)) {
+      ESP_LOGV(TAG, "Invalid packet received of size %zd.", len);
+    } else if (!this->process_(universe, packet)) {
+      ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, packet.count);
+    }
   }
-  payload.resize(len);
-  memmove(&payload[0], buf, len);
 
-  if (!this->packet_(payload, universe, packet)) {
-    ESP_LOGV(TAG, "Invalid packet received of size %zu.", payload.size());
-    return;
+  bool delayed = false;
+  for (auto *light_effect : light_effects_) {
+    delayed |= light_effect->show_frame_();
   }
 
-  if (!this->process_(universe, packet)) {
-    ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, packet.count);
-  }
+  if (drained && !delayed && this->ready_watched_)
+    this->disable_loop();
 }
 
 void E131Component::add_effect(E131AddressableLightEffect *light_effect) {
@@ -116,5 +132,17 @@ bool E131Component::process_(int universe, const E131Packet &packet) {
   return handled;
 }
 
+bool E131Component::process_sync_(int universe) {
+  bool handled = false;
+
+  ESP_LOGV(TAG, "Received E1.31 synchronization packet for %d universe", universe);
+
+  for (auto *light_effect : light_effects_) {
+    handled = light_effect->process_sync_(universe) || handled;
+  }
+
+  return handled;
+}
+
 }  // namespace e131
 }  // namespace esphome
@@ -4,7 +4,6 @@
 #include "esphome/core/component.h"
 
 #include <cinttypes>
-#include <map>
 #include <memory>
 #include <set>
 #include <vector>
@@ -18,9 +17,17 @@ enum E131ListenMethod { E131_MULTICAST, E131_UNICAST };
 
 const int E131_MAX_PROPERTY_VALUES_COUNT = 513;
 
+/// DMX data of one universe, pointing into the received datagram.
 struct E131Packet {
   uint16_t count;
-  uint8_t values[E131_MAX_PROPERTY_VALUES_COUNT];
+  const uint8_t *values;
+  /// Universe of the synchronization packet to wait for before showing the data, 0 to show it right away.
+  uint16_t sync_universe;
+};
+
+struct E131Universe {
+  uint16_t universe;
+  uint16_t consumers;
 };
 
 class E131Component : public esphome::Component {
@@ -36,19 +43,26 @@ class E131Component : public esphome::Component {
   void remove_effect(E131AddressableLightEffect *light_effect);
 
   void set_method(E131ListenMethod listen_method) { this->listen_method_ = listen_method; }
+  /// Also listen to the multicast group of `universe`, to receive the synchronization packets sent to it.
+  void set_sync_universe(int universe) { this->sync_universe_ = universe; }
 
  protected:
-  bool packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet);
+  bool packet_(const uint8_t *data, size_t len, int &universe, E131Packet &packet);
+  bool sync_packet_(const uint8_t *data, size_t len, int &universe);
   bool process_(int universe, const E131Packet &packet);
+  bool process_sync_(int universe);
   bool join_igmp_groups_();
   void join_(int universe);
   void leave_(int universe);
 
   E131ListenMethod listen_method_{E131_MULTICAST};
+  int sync_universe_{0};
   std::unique_ptr<socket::Socket> socket_;
+  /// Whether the socket enables the loop when packets arrive, so it can be disabled while idle.
+  bool ready_watched_{false};
   std::set<E131AddressableLightEffect *> light_effects_;
-  std::map<int, int> universe_consumers_;
-  std::map<int, E131Packet> universe_packets_;
+  /// Joined universes, with the number of effects listening to each.
+  std::vector<E131Universe> universes_;
 };
 
 }  // namespace e131
@@ -6,7 +6,7 @@ namespace esphome {
 namespace e131 {
 
 static const char *const TAG = "e131_addressable_light_effect";
-static const int MAX_DATA_SIZE = (sizeof(E131Packet::values) - 1);
+static const int MAX_DATA_SIZE = (E131_MAX_PROPERTY_VALUES_COUNT - 1);
 
 E131AddressableLightEffect::E131AddressableLightEffect(const std::string &name) : AddressableLightEffect(name) {}
 
@@ -27,6 +27,11 @@ int E131AddressableLightEffect::get_universe_count() const {
 void E131AddressableLightEffect::start() {
   AddressableLightEffect::start();
 
+  this->received_count_ = 0;
+  this->last_index_ = -1;
+  this->pending_sync_ = 0;
+  this->frame_ready_ = false;
+  this->frame_delayed_ = false;
   if (this->e131_) {
     this->e131_->add_effect(this);
   }
@@ -51,6 +56,12 @@ bool E131AddressableLightEffect::process_(int universe, const E131Packet &packet
   if (universe < first_universe_ || universe > get_last_universe())
     return false;
 
+  int index = universe - first_universe_;
+  if (index <= this->last_index_ || this->pending_sync_ != 0) {
+    // a packet or the synchronization of the previous frame got lost, take it as it is
+    this->complete_frame_();
+  }
+
   int32_t output_offset = (universe - first_universe_) * get_lights_per_universe();
   // limit amount of lights per universe and received
   int output_end =
@@ -62,31 +73,59 @@ bool E131AddressableLightEffect::process_(int universe, const E131Packet &packet
 
   switch (channels_) {
     case E131_MONO:
-      for (; output_offset < output_end; output_offset++, input_data++) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[0], input_data[0], input_data[0]));
-      }
+      it->write_pixels(output_offset, input_data, output_end - output_offset, light::PIXEL_FORMAT_MONO);
       break;
 
     case E131_RGB:
-      for (; output_offset < output_end; output_offset++, input_data += 3) {
-        auto output = (*it)[output_offset];
-        output.set(
-            Color(input_data[0], input_data[1], input_data[2], (input_data[0] + input_data[1] + input_data[2]) / 3));
-      }
+      it->write_pixels(output_offset, input_data, output_end - output_offset, light::PIXEL_FORMAT_RGB_WHITE_AVG);
       break;
 
     case E131_RGBW:
-      for (; output_offset < output_end; output_offset++, input_data += 4) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[1], input_data[2], input_data[3]));
-      }
+      it->write_pixels(output_offset, input_data, output_end - output_offset, light::PIXEL_FORMAT_RGBW);
       break;
   }
 
-  it->schedule_show();
+  this->last_index_ = index;
+  if (++this->received_count_ == get_universe_count()) {
+    if (packet.sync_universe == 0) {
+      this->complete_frame_();
+    } else {
+      this->received_count_ = 0;
+      this->last_index_ = -1;
+      this->pending_sync_ = packet.sync_universe;
+    }
+  }
+  return true;
+}
+
+bool E131AddressableLightEffect::process_sync_(int universe) {
+  if (this->pending_sync_ == 0 || this->pending_sync_ != universe)
+    return false;
+
+  this->complete_frame_();
   return true;
 }
 
+void E131AddressableLightEffect::complete_frame_() {
+  this->received_count_ = 0;
+  this->last_index_ = -1;
+  this->pending_sync_ = 0;
+  this->frame_ready_ = true;
+}
+
+bool E131AddressableLightEffect::show_frame_() {
+  if (!this->frame_ready_)
+    return false;
+  if (this->received_count_ != 0 && !this->frame_delayed_) {
+    this->frame_delayed_ = true;
+    return true;
+  }
+
+  this->frame_ready_ = false;
+  this->frame_delayed_ = false;
+  get_addressable_()->schedule_show();
+  return false;
+}
+
 }  // namespace e131
 }  // namespace esphome
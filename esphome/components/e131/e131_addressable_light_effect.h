@@ -30,12 +30,31 @@ class E131AddressableLightEffect : public light::AddressableLightEffect {
   void set_e131(E131Component *e131) { this->e131_ = e131; }
 
  protected:
+  /// Write the data of a universe to the lights.
   bool process_(int universe, const E131Packet &packet);
+  /// Release the frame that waits for the synchronization packet of `universe`.
+  bool process_sync_(int universe);
+  /** Show the last complete frame, unless packets of the next frame have already overwritten a part of it.
+   *
+   * In that case it's shown one loop later all the same, as the sender might not send all universes of the light.
+   * Returns true if the frame was delayed.
+   */
+  bool show_frame_();
+  void complete_frame_();
 
   int first_universe_{0};
   int last_universe_{0};
   E131LightChannels channels_{E131_RGB};
   E131Component *e131_{nullptr};
+  /// Number of universes of the current frame that have been received, the frame is complete once all are in.
+  int received_count_{0};
+  /// Offset of the last universe received. Senders send the universes of a frame in order, so a universe that isn't
+  /// after it starts the next frame.
+  int last_index_{-1};
+  /// The universe of the synchronization packet the complete frame waits for, 0 if none.
+  int pending_sync_{0};
+  bool frame_ready_{false};
+  bool frame_delayed_{false};
 
   friend class E131Component;
 };
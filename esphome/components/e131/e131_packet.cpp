@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstring>
 #include "e131.h"
 #include "esphome/components/network/ip_address.h"
@@ -16,7 +17,9 @@ static const char *const TAG = "e131";
 
 static const uint8_t ACN_ID[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
 static const uint32_t VECTOR_ROOT = 4;
+static const uint32_t VECTOR_ROOT_EXTENDED = 8;
 static const uint32_t VECTOR_FRAME = 2;
+static const uint32_t VECTOR_FRAME_SYNCHRONIZATION = 1;
 static const uint8_t VECTOR_DMP = 2;
 
 // E1.31 Packet Structure
@@ -35,7 +38,7 @@ union E131RawPacket {
     uint32_t frame_vector;
     uint8_t source_name[64];
     uint8_t priority;
-    uint16_t reserved;
+    uint16_t sync_address;
     uint8_t sequence_number;
     uint8_t options;
     uint16_t universe;
@@ -53,6 +56,24 @@ union E131RawPacket {
   uint8_t raw[638];
 };
 
+// E1.31 Synchronization Packet Structure
+struct E131RawSyncPacket {
+  // Root Layer
+  uint16_t preamble_size;
+  uint16_t postamble_size;
+  uint8_t acn_id[12];
+  uint16_t root_flength;
+  uint32_t root_vector;
+  uint8_t cid[16];
+
+  // Frame Layer
+  uint16_t frame_flength;
+  uint32_t frame_vector;
+  uint8_t sequence_number;
+  uint16_t sync_address;
+  uint16_t reserved;
+} __attribute__((packed));
+
 // We need to have at least one `1` value
 // Get the offset of `property_values[1]`
 const size_t E131_MIN_PACKET_SIZE = reinterpret_cast<size_t>(&((E131RawPacket *) nullptr)->property_values[1]);
@@ -63,17 +84,17 @@ bool E131Component::join_igmp_groups_() {
   if (this->socket_ == nullptr)
     return false;
 
-  for (auto universe : universe_consumers_) {
-    if (!universe.second)
+  for (auto universe : universes_) {
+    if (!universe.consumers)
       continue;
 
     ip4_addr_t multicast_addr =
-        network::IPAddress(239, 255, ((universe.first >> 8) & 0xff), ((universe.first >> 0) & 0xff));
+        network::IPAddress(239, 255, ((universe.universe >> 8) & 0xff), ((universe.universe >> 0) & 0xff));
 
     auto err = igmp_joingroup(IP4_ADDR_ANY4, &multicast_addr);
 
     if (err) {
-      ESP_LOGW(TAG, "IGMP join for %d universe of E1.31 failed. Multicast might not work.", universe.first);
+      ESP_LOGW(TAG, "IGMP join for %d universe of E1.31 failed. Multicast might not work.", universe.universe);
     }
   }
 
@@ -81,8 +102,11 @@ bool E131Component::join_igmp_groups_() {
 }
 
 void E131Component::join_(int universe) {
-  // store only latest received packet for the given universe
-  auto consumers = ++universe_consumers_[universe];
+  auto it = std::find_if(universes_.begin(), universes_.end(),
+                         [universe](const E131Universe &entry) { return entry.universe == universe; });
+  if (it == universes_.end())
+    it = universes_.insert(universes_.end(), E131Universe{static_cast<uint16_t>(universe), 0});
+  auto consumers = ++it->consumers;
 
   if (consumers > 1) {
     return;  // we already joined before
@@ -94,11 +118,12 @@ void E131Component::join_(int universe) {
 }
 
 void E131Component::leave_(int universe) {
-  auto consumers = --universe_consumers_[universe];
-
-  if (consumers > 0) {
+  auto it = std::find_if(universes_.begin(), universes_.end(),
+                         [universe](const E131Universe &entry) { return entry.universe == universe; });
+  if (it == universes_.end() || --it->consumers > 0) {
     return;  // we have other consumers of the given universe
   }
+  universes_.erase(it);
 
   if (listen_method_ == E131_MULTICAST) {
     ip4_addr_t multicast_addr = network::IPAddress(239, 255, ((universe >> 8) & 0xff), ((universe >> 0) & 0xff));
@@ -109,11 +134,11 @@ void E131Component::leave_(int universe) {
   ESP_LOGD(TAG, "Left %d universe for E1.31.", universe);
 }
 
-bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet) {
-  if (data.size() < E131_MIN_PACKET_SIZE)
+bool E131Component::packet_(const uint8_t *data, size_t len, int &universe, E131Packet &packet) {
+  if (len < E131_MIN_PACKET_SIZE)
     return false;
 
-  auto *sbuff = reinterpret_cast<const E131RawPacket *>(&data[0]);
+  auto *sbuff = reinterpret_cast<const E131RawPacket *>(data);
 
   if (memcmp(sbuff->acn_id, ACN_ID, sizeof(sbuff->acn_id)) != 0)
     return false;
@@ -128,10 +153,28 @@ bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E13
 
   universe = htons(sbuff->universe);
   packet.count = htons(sbuff->property_value_count);
-  if (packet.count > E131_MAX_PROPERTY_VALUES_COUNT)
+  if (packet.count > E131_MAX_PROPERTY_VALUES_COUNT || E131_MIN_PACKET_SIZE - 1 + packet.count > len)
+    return false;
+
+  packet.values = sbuff->property_values;
+  packet.sync_universe = htons(sbuff->sync_address);
+  return true;
+}
+
+bool E131Component::sync_packet_(const uint8_t *data, size_t len, int &universe) {
+  if (len < sizeof(E131RawSyncPacket))
+    return false;
+
+  auto *sbuff = reinterpret_cast<const E131RawSyncPacket *>(data);
+
+  if (memcmp(sbuff->acn_id, ACN_ID, sizeof(sbuff->acn_id)) != 0)
+    return false;
+  if (htonl(sbuff->root_vector) != VECTOR_ROOT_EXTENDED)
+    return false;
+  if (htonl(sbuff->frame_vector) != VECTOR_FRAME_SYNCHRONIZATION)
     return false;
 
-  memcpy(packet.values, sbuff->property_values, packet.count);
+  universe = htons(sbuff->sync_address);
   return true;
 }
 
@@ -6,6 +6,7 @@
 #include <nvs_flash.h>
 #include <cstring>
 #include <cinttypes>
+#include <map>
 #include <vector>
 #include <string>
 
@@ -14,45 +15,72 @@ namespace esp32 {
 
 static const char *const TAG = "esp32.preferences";
 
+/// Calculate a FNV-1a hash of \p len bytes of \p data.
+static uint32_t hash_data(const uint8_t *data, size_t len) {
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= data[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
 struct NVSData {
   std::string key;
+  /// Data waiting to be written by the next sync(), if pending is set.
   std::vector<uint8_t> data;
+  bool pending{false};
+  /// Whether the data in NVS is known, then its length and hash are in stored_len and stored_hash.
+  bool stored_known{false};
+  size_t stored_len{0};
+  uint32_t stored_hash{0};
+
+  bool is_stored(const uint8_t *data, size_t len) const {
+    return this->stored_known && this->stored_len == len && this->stored_hash == hash_data(data, len);
+  }
+  void set_stored(const uint8_t *data, size_t len) {
+    this->stored_known = true;
+    this->stored_len = len;
+    this->stored_hash = hash_data(data, len);
+  }
 };
 
-static std::vector<NVSData> s_pending_save;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+/// All preferences by key, so that preferences made with the same key share their state.
+static std::map<uint32_t, NVSData> s_data;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static std::vector<NVSData *> s_pending_save;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint32_t s_writes_avoided = 0;          // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint32_t s_bytes_written = 0;           // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 class ESP32PreferenceBackend : public ESPPreferenceBackend {
  public:
-  std::string key;
+  NVSData *entry;
   uint32_t nvs_handle;
   bool save(const uint8_t *data, size_t len) override {
-    // try find in pending saves and update that
-    for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
-        obj.data.assign(data, data + len);
-        return true;
-      }
+    if (!entry->pending && entry->is_stored(data, len)) {
+      // already in flash, which is the common case for restored states that are saved on every change
+      s_writes_avoided++;
+      return true;
     }
-    NVSData save{};
-    save.key = key;
-    save.data.assign(data, data + len);
-    s_pending_save.emplace_back(save);
-    ESP_LOGVV(TAG, "s_pending_save: key: %s, len: %d", key.c_str(), len);
+    entry->data.assign(data, data + len);
+    if (!entry->pending) {
+      entry->pending = true;
+      s_pending_save.push_back(entry);
+    }
+    ESP_LOGVV(TAG, "s_pending_save: key: %s, len: %d", entry->key.c_str(), len);
     return true;
   }
   bool load(uint8_t *data, size_t len) override {
-    // try find in pending saves and load from that
-    for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
-        if (obj.data.size() != len) {
-          // size mismatch
-          return false;
-        }
-        memcpy(data, obj.data.data(), len);
-        return true;
+    // load from the pending save if there is one
+    if (entry->pending) {
+      if (entry->data.size() != len) {
+        // size mismatch
+        return false;
       }
+      memcpy(data, entry->data.data(), len);
+      return true;
     }
 
+    const std::string &key = entry->key;
     size_t actual_len;
     esp_err_t err = nvs_get_blob(nvs_handle, key.c_str(), nullptr, &actual_len);
     if (err != 0) {
@@ -70,6 +98,7 @@ class ESP32PreferenceBackend : public ESPPreferenceBackend {
     } else {
       ESP_LOGVV(TAG, "nvs_get_blob: key: %s, len: %d", key.c_str(), len);
     }
+    entry->set_stored(data, len);
     return true;
   }
 };
@@ -101,8 +130,12 @@ class ESP32Preferences : public ESPPreferences {
     auto *pref = new ESP32PreferenceBackend();  // NOLINT(cppcoreguidelines-owning-memory)
     pref->nvs_handle = nvs_handle;
 
-    uint32_t keyval = type;
-    pref->key = str_sprintf("%" PRIu32, keyval);
+    NVSData &entry = s_data[type];
+    if (entry.key.empty()) {
+      uint32_t keyval = type;
+      entry.key = str_sprintf("%" PRIu32, keyval);
+    }
+    pref->entry = &entry;
 
     return ESPPreferenceObject(pref);
   }
@@ -119,7 +152,7 @@ class ESP32Preferences : public ESPPreferences {
 
     // go through vector from back to front (makes erase easier/more efficient)
     for (ssize_t i = s_pending_save.size() - 1; i >= 0; i--) {
-      const auto &save = s_pending_save[i];
+      NVSData &save = *s_pending_save[i];
       ESP_LOGVV(TAG, "Checking if NVS data %s has changed", save.key.c_str());
       if (is_changed(nvs_handle, save)) {
         esp_err_t err = nvs_set_blob(nvs_handle, save.key.c_str(), save.data.data(), save.data.size());
@@ -127,20 +160,28 @@ class ESP32Preferences : public ESPPreferences {
         if (err != 0) {
           ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", save.key.c_str(), save.data.size(),
                    esp_err_to_name(err));
+          // what's in flash now is unknown
+          save.stored_known = false;
           failed++;
           last_err = err;
           last_key = save.key;
           continue;
         }
+        save.set_stored(save.data.data(), save.data.size());
+        s_bytes_written += save.data.size();
         written++;
       } else {
         ESP_LOGV(TAG, "NVS data not changed skipping %s  len=%u", save.key.c_str(), save.data.size());
+        s_writes_avoided++;
         cached++;
       }
+      save.pending = false;
       s_pending_save.erase(s_pending_save.begin() + i);
     }
     ESP_LOGD(TAG, "Saving %d preferences to flash: %d cached, %d written, %d failed", cached + written + failed, cached,
              written, failed);
+    ESP_LOGD(TAG, "Since boot: %" PRIu32 " writes avoided, %" PRIu32 " bytes written", s_writes_avoided,
+             s_bytes_written);
     if (failed > 0) {
       ESP_LOGE(TAG, "Error saving %d preferences to flash. Last error=%s for key=%s", failed, esp_err_to_name(last_err),
                last_key.c_str());
@@ -155,26 +196,35 @@ class ESP32Preferences : public ESPPreferences {
 
     return failed == 0;
   }
-  bool is_changed(const uint32_t nvs_handle, const NVSData &to_save) {
-    NVSData stored_data{};
+  bool is_changed(const uint32_t nvs_handle, NVSData &to_save) {
+    // the hash of what was last read or written saves reading the data back from flash
+    if (to_save.stored_known)
+      return !to_save.is_stored(to_save.data.data(), to_save.data.size());
+
+    std::vector<uint8_t> stored_data;
     size_t actual_len;
     esp_err_t err = nvs_get_blob(nvs_handle, to_save.key.c_str(), nullptr, &actual_len);
     if (err != 0) {
       ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", to_save.key.c_str(), esp_err_to_name(err));
       return true;
     }
-    stored_data.data.resize(actual_len);
-    err = nvs_get_blob(nvs_handle, to_save.key.c_str(), stored_data.data.data(), &actual_len);
+    stored_data.resize(actual_len);
+    err = nvs_get_blob(nvs_handle, to_save.key.c_str(), stored_data.data(), &actual_len);
     if (err != 0) {
       ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", to_save.key.c_str(), esp_err_to_name(err));
       return true;
     }
-    return to_save.data != stored_data.data;
+    to_save.set_stored(stored_data.data(), stored_data.size());
+    return to_save.data != stored_data;
   }
 
   bool reset() override {
     ESP_LOGD(TAG, "Cleaning up preferences in flash...");
     s_pending_save.clear();
+    for (auto &it : s_data) {
+      it.second.pending = false;
+      it.second.stored_known = false;
+    }
 
     nvs_flash_deinit();
     nvs_flash_erase();
@@ -184,6 +234,9 @@ class ESP32Preferences : public ESPPreferences {
   }
 };
 
+uint32_t get_preference_writes_avoided() { return s_writes_avoided; }
+uint32_t get_preference_bytes_written() { return s_bytes_written; }
+
 void setup_preferences() {
   auto *prefs = new ESP32Preferences();  // NOLINT(cppcoreguidelines-owning-memory)
   prefs->open();
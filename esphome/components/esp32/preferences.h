@@ -1,11 +1,18 @@
 #pragma once
 #ifdef USE_ESP32
 
+#include <cstdint>
+
 namespace esphome {
 namespace esp32 {
 
 void setup_preferences();
 
+/// Number of preference saves since boot that didn't write to flash, as the data was unchanged.
+uint32_t get_preference_writes_avoided();
+/// Number of bytes of preference data written to flash since boot.
+uint32_t get_preference_bytes_written();
+
 }  // namespace esp32
 }  // namespace esphome
 
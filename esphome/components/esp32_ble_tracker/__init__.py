@@ -27,6 +27,7 @@ CONF_SCAN_PARAMETERS = "scan_parameters"
 CONF_WINDOW = "window"
 CONF_CONTINUOUS = "continuous"
 CONF_ON_SCAN_END = "on_scan_end"
+CONF_DISCOVERED_CACHE_SIZE = "discovered_cache_size"
 esp32_ble_tracker_ns = cg.esphome_ns.namespace("esp32_ble_tracker")
 ESP32BLETracker = esp32_ble_tracker_ns.class_(
     "ESP32BLETracker",
@@ -164,6 +165,9 @@ CONFIG_SCHEMA = cv.Schema(
             ),
             validate_scan_parameters,
         ),
+        cv.Optional(CONF_DISCOVERED_CACHE_SIZE, default=128): cv.int_range(
+            min=8, max=4096
+        ),
         cv.Optional(CONF_ON_BLE_ADVERTISE): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(ESPBTAdvertiseTrigger),
@@ -221,6 +225,7 @@ async def to_code(config):
     cg.add(var.set_scan_window(int(params[CONF_WINDOW].total_milliseconds / 0.625)))
     cg.add(var.set_scan_active(params[CONF_ACTIVE]))
     cg.add(var.set_scan_continuous(params[CONF_CONTINUOUS]))
+    cg.add(var.set_discovered_cache_size(config[CONF_DISCOVERED_CACHE_SIZE]))
     for conf in config.get(CONF_ON_BLE_ADVERTISE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
         if CONF_MAC_ADDRESS in conf:
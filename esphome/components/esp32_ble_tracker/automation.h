@@ -40,13 +40,11 @@ class BLEServiceDataAdvertiseTrigger : public Trigger<const adv_data_t &>, publi
     if (this->address_ && device.address_uint64() != this->address_) {
       return false;
     }
-    for (auto &service_data : device.get_service_datas()) {
-      if (service_data.uuid == this->uuid_) {
-        this->trigger(service_data.data);
-        return true;
-      }
-    }
-    return false;
+    auto service_data = device.get_advertisement().get_service_data(this->uuid_);
+    if (!service_data.has_value())
+      return false;
+    this->trigger(service_data->to_vector());
+    return true;
   }
 
  protected:
@@ -66,13 +64,11 @@ class BLEManufacturerDataAdvertiseTrigger : public Trigger<const adv_data_t &>,
     if (this->address_ && device.address_uint64() != this->address_) {
       return false;
     }
-    for (auto &manufacturer_data : device.get_manufacturer_datas()) {
-      if (manufacturer_data.uuid == this->uuid_) {
-        this->trigger(manufacturer_data.data);
-        return true;
-      }
-    }
-    return false;
+    auto manufacturer_data = device.get_advertisement().get_manufacturer_data(this->uuid_);
+    if (!manufacturer_data.has_value())
+      return false;
+    this->trigger(manufacturer_data->to_vector());
+    return true;
   }
 
  protected:
@@ -43,6 +43,7 @@ void ESP32BLETracker::setup() {
     ESP_LOGE(TAG, "BLE Tracker was marked failed by ESP32BLE");
     return;
   }
+  this->already_discovered_.init(this->discovered_cache_size_);
   ExternalRAMAllocator<esp_ble_gap_cb_param_t::ble_scan_result_evt_param> allocator(
       ExternalRAMAllocator<esp_ble_gap_cb_param_t::ble_scan_result_evt_param>::ALLOW_FAILURE);
   this->scan_result_buffer_ = allocator.allocate(ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE);
@@ -301,6 +302,9 @@ void ESP32BLETracker::end_of_scan_() {
   }
 
   ESP_LOGD(TAG, "End of scan.");
+  ESP_LOGV(TAG, "Discovered devices: %" PRIu32 " hits, %" PRIu32 " misses, %" PRIu32 " evictions",
+           this->already_discovered_.get_hits(), this->already_discovered_.get_misses(),
+           this->already_discovered_.get_evictions());
   this->scanner_idle_ = true;
   this->already_discovered_.clear();
   xSemaphoreGive(this->scan_end_lock_);
@@ -410,6 +414,184 @@ optional<ESPBLEiBeacon> ESPBLEiBeacon::from_manufacturer_data(const ServiceData
     return {};
   return ESPBLEiBeacon(data.data.data());
 }
+optional<ESPBLEiBeacon> ESPBLEiBeacon::from_manufacturer_data(const ServiceDataRef &data) {
+  if (!data.uuid.contains(0x4C, 0x00))
+    return {};
+
+  if (data.length != 23)
+    return {};
+  return ESPBLEiBeacon(data.data);
+}
+
+// See also Generic Access Profile Assigned Numbers:
+// https://www.bluetooth.com/specifications/assigned-numbers/generic-access-profile/ See also ADVERTISING AND SCAN
+// RESPONSE DATA FORMAT: https://www.bluetooth.com/specifications/bluetooth-core-specification/ (vol 3, part C, 11)
+// See also Core Specification Supplement: https://www.bluetooth.com/specifications/bluetooth-core-specification/
+// (called CSS here)
+
+size_t ESPBTAdvRecord::service_uuid_count() const {
+  // CSS 1.1 SERVICE UUID
+  // The Service UUID data type is used to include a list of Service or Service Class UUIDs.
+  // There are six data types defined for the three sizes of Service UUIDs that may be returned:
+  // CSS 1: Optional in this context (may appear more than once in a block).
+  switch (this->type) {
+    case ESP_BLE_AD_TYPE_16SRV_CMPL:
+    case ESP_BLE_AD_TYPE_16SRV_PART:
+      // • 16-bit Bluetooth Service UUIDs
+      return this->length / 2;
+    case ESP_BLE_AD_TYPE_32SRV_CMPL:
+    case ESP_BLE_AD_TYPE_32SRV_PART:
+      // • 32-bit Bluetooth Service UUIDs
+      return this->length / 4;
+    case ESP_BLE_AD_TYPE_128SRV_CMPL:
+    case ESP_BLE_AD_TYPE_128SRV_PART:
+      // • Global 128-bit Service UUIDs
+      return this->length >= 16 ? 1 : 0;
+    default:
+      return 0;
+  }
+}
+ESPBTUUID ESPBTAdvRecord::service_uuid(size_t index) const {
+  switch (this->type) {
+    case ESP_BLE_AD_TYPE_16SRV_CMPL:
+    case ESP_BLE_AD_TYPE_16SRV_PART:
+      return ESPBTUUID::from_uint16(encode_uint16(this->data[2 * index + 1], this->data[2 * index]));
+    case ESP_BLE_AD_TYPE_32SRV_CMPL:
+    case ESP_BLE_AD_TYPE_32SRV_PART:
+      return ESPBTUUID::from_uint32(encode_uint32(this->data[4 * index + 3], this->data[4 * index + 2],
+                                                  this->data[4 * index + 1], this->data[4 * index]));
+    default:
+      return ESPBTUUID::from_raw(this->data);
+  }
+}
+optional<ServiceDataRef> ESPBTAdvRecord::as_service_data() const {
+  // CSS 1.11 SERVICE DATA
+  // "The Service Data data type consists of a service UUID with the data associated with that service."
+  // CSS 1: Optional in this context (may appear more than once in a block).
+  switch (this->type) {
+    case ESP_BLE_AD_TYPE_SERVICE_DATA:
+      // «Service Data - 16 bit UUID»
+      // Size: 2 or more octets
+      // The first 2 octets contain the 16 bit Service UUID fol- lowed by additional service data
+      if (this->length < 2) {
+        ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_SERVICE_DATA");
+        return {};
+      }
+      return ServiceDataRef{ESPBTUUID::from_uint16(encode_uint16(this->data[1], this->data[0])), this->data + 2,
+                            static_cast<uint8_t>(this->length - 2)};
+    case ESP_BLE_AD_TYPE_32SERVICE_DATA:
+      // «Service Data - 32 bit UUID»
+      // Size: 4 or more octets
+      // The first 4 octets contain the 32 bit Service UUID fol- lowed by additional service data
+      if (this->length < 4) {
+        ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_32SERVICE_DATA");
+        return {};
+      }
+      return ServiceDataRef{
+          ESPBTUUID::from_uint32(encode_uint32(this->data[3], this->data[2], this->data[1], this->data[0])),
+          this->data + 4, static_cast<uint8_t>(this->length - 4)};
+    case ESP_BLE_AD_TYPE_128SERVICE_DATA:
+      // «Service Data - 128 bit UUID»
+      // Size: 16 or more octets
+      // The first 16 octets contain the 128 bit Service UUID followed by additional service data
+      if (this->length < 16) {
+        ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_128SERVICE_DATA");
+        return {};
+      }
+      return ServiceDataRef{ESPBTUUID::from_raw(this->data), this->data + 16, static_cast<uint8_t>(this->length - 16)};
+    default:
+      return {};
+  }
+}
+optional<ServiceDataRef> ESPBTAdvRecord::as_manufacturer_data() const {
+  // CSS 1.4 MANUFACTURER SPECIFIC DATA
+  // "The Manufacturer Specific data type is used for manufacturer specific data. The first two data octets shall
+  // contain a company identifier from Assigned Numbers. The interpretation of any other octets within the data
+  // shall be defined by the manufacturer specified by the company identifier."
+  // CSS 1: Optional in this context (may appear more than once in a block).
+  if (this->type != ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE)
+    return {};
+  if (this->length < 2) {
+    ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE");
+    return {};
+  }
+  return ServiceDataRef{ESPBTUUID::from_uint16(encode_uint16(this->data[1], this->data[0])), this->data + 2,
+                        static_cast<uint8_t>(this->length - 2)};
+}
+
+StringRef ESPBTAdvertisement::get_name() const {
+  StringRef name;
+  for (auto record : *this) {
+    // CSS 1.2 LOCAL NAME
+    // "The Local Name data type shall be the same as, or a shortened version of, the local name assigned to the
+    // device." CSS 1: Optional in this context; shall not appear more than once in a block.
+    // SHORTENED LOCAL NAME
+    // "The Shortened Local Name data type defines a shortened version of the Local Name data type. The Shortened
+    // Local Name data type shall not be used to advertise a name that is longer than the Local Name data type."
+    if ((record.type == ESP_BLE_AD_TYPE_NAME_SHORT || record.type == ESP_BLE_AD_TYPE_NAME_CMPL) &&
+        record.length > name.size())
+      name = StringRef(record.data, record.length);
+  }
+  return name;
+}
+size_t ESPBTAdvertisement::count_service_uuids() const {
+  size_t count = 0;
+  for (auto record : *this)
+    count += record.service_uuid_count();
+  return count;
+}
+bool ESPBTAdvertisement::has_service_uuid(const ESPBTUUID &uuid) const {
+  for (auto record : *this) {
+    for (size_t i = 0, count = record.service_uuid_count(); i < count; i++) {
+      if (record.service_uuid(i) == uuid)
+        return true;
+    }
+  }
+  return false;
+}
+size_t ESPBTAdvertisement::count_service_datas() const {
+  size_t count = 0;
+  for (auto record : *this) {
+    if (record.as_service_data().has_value())
+      count++;
+  }
+  return count;
+}
+optional<ServiceDataRef> ESPBTAdvertisement::get_service_data(const ESPBTUUID &uuid) const {
+  for (auto record : *this) {
+    auto data = record.as_service_data();
+    if (data.has_value() && data->uuid == uuid)
+      return data;
+  }
+  return {};
+}
+size_t ESPBTAdvertisement::count_manufacturer_datas() const {
+  size_t count = 0;
+  for (auto record : *this) {
+    if (record.as_manufacturer_data().has_value())
+      count++;
+  }
+  return count;
+}
+optional<ServiceDataRef> ESPBTAdvertisement::get_manufacturer_data(const ESPBTUUID &uuid) const {
+  for (auto record : *this) {
+    auto data = record.as_manufacturer_data();
+    if (data.has_value() && data->uuid == uuid)
+      return data;
+  }
+  return {};
+}
+optional<ESPBLEiBeacon> ESPBTAdvertisement::get_ibeacon() const {
+  for (auto record : *this) {
+    auto data = record.as_manufacturer_data();
+    if (!data.has_value())
+      continue;
+    auto res = ESPBLEiBeacon::from_manufacturer_data(*data);
+    if (res.has_value())
+      return res;
+  }
+  return {};
+}
 
 void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
   this->scan_result_ = param;
@@ -417,9 +599,9 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
     this->address_[i] = param.bda[i];
   this->address_type_ = param.ble_addr_type;
   this->rssi_ = param.rssi;
-  this->parse_adv_(param);
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
+  this->parse_adv_();
   ESP_LOGVV(TAG, "Parse Result:");
   const char *address_type = "";
   switch (this->address_type_) {
@@ -473,40 +655,18 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
   ESP_LOGVV(TAG, "Adv data: %s", format_hex_pretty(param.ble_adv, param.adv_data_len + param.scan_rsp_len).c_str());
 #endif
 }
-void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
-  size_t offset = 0;
-  const uint8_t *payload = param.ble_adv;
-  uint8_t len = param.adv_data_len + param.scan_rsp_len;
-
-  while (offset + 2 < len) {
-    const uint8_t field_length = payload[offset++];  // First byte is length of adv record
-    if (field_length == 0) {
-      continue;  // Possible zero padded advertisement data
-    }
-
-    // first byte of adv record is adv record type
-    const uint8_t record_type = payload[offset++];
-    const uint8_t *record = &payload[offset];
-    const uint8_t record_length = field_length - 1;
-    offset += record_length;
-
-    // See also Generic Access Profile Assigned Numbers:
-    // https://www.bluetooth.com/specifications/assigned-numbers/generic-access-profile/ See also ADVERTISING AND SCAN
-    // RESPONSE DATA FORMAT: https://www.bluetooth.com/specifications/bluetooth-core-specification/ (vol 3, part C, 11)
-    // See also Core Specification Supplement: https://www.bluetooth.com/specifications/bluetooth-core-specification/
-    // (called CSS here)
+void ESPBTDevice::parse_adv_() const {
+  if (this->parsed_)
+    return;
+  this->parsed_ = true;
 
-    switch (record_type) {
+  for (auto record : this->get_advertisement()) {
+    switch (record.type) {
       case ESP_BLE_AD_TYPE_NAME_SHORT:
       case ESP_BLE_AD_TYPE_NAME_CMPL: {
-        // CSS 1.2 LOCAL NAME
-        // "The Local Name data type shall be the same as, or a shortened version of, the local name assigned to the
-        // device." CSS 1: Optional in this context; shall not appear more than once in a block.
-        // SHORTENED LOCAL NAME
-        // "The Shortened Local Name data type defines a shortened version of the Local Name data type. The Shortened
-        // Local Name data type shall not be used to advertise a name that is longer than the Local Name data type."
-        if (record_length > this->name_.length()) {
-          this->name_ = std::string(reinterpret_cast<const char *>(record), record_length);
+        // see ESPBTAdvertisement::get_name()
+        if (record.length > this->name_.length()) {
+          this->name_ = std::string(reinterpret_cast<const char *>(record.data), record.length);
         }
         break;
       }
@@ -514,7 +674,8 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
         // CSS 1.5 TX POWER LEVEL
         // "The TX Power Level data type indicates the transmitted power level of the packet containing the data type."
         // CSS 1: Optional in this context (may appear more than once in a block).
-        this->tx_powers_.push_back(*payload);
+        if (record.length >= 1)
+          this->tx_powers_.push_back(static_cast<int8_t>(record.data[0]));
         break;
       }
       case ESP_BLE_AD_TYPE_APPEARANCE: {
@@ -523,7 +684,8 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
         // See also https://www.bluetooth.com/specifications/gatt/characteristics/
         // CSS 1: Optional in this context; shall not appear more than once in a block and shall not appear in both
         // the AD and SRD of the same extended advertising interval.
-        this->appearance_ = *reinterpret_cast<const uint16_t *>(record);
+        if (record.length >= 2)
+          this->appearance_ = encode_uint16(record.data[1], record.data[0]);
         break;
       }
       case ESP_BLE_AD_TYPE_FLAG: {
@@ -532,107 +694,90 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
         // Flag bits are non-zero and the advertising packet is connectable, otherwise the Flags data type may be
         // omitted."
         // CSS 1: Optional in this context; shall not appear more than once in a block.
-        this->ad_flag_ = *record;
+        if (record.length >= 1)
+          this->ad_flag_ = record.data[0];
         break;
       }
-      // CSS 1.1 SERVICE UUID
-      // The Service UUID data type is used to include a list of Service or Service Class UUIDs.
-      // There are six data types defined for the three sizes of Service UUIDs that may be returned:
-      // CSS 1: Optional in this context (may appear more than once in a block).
       case ESP_BLE_AD_TYPE_16SRV_CMPL:
-      case ESP_BLE_AD_TYPE_16SRV_PART: {
-        // • 16-bit Bluetooth Service UUIDs
-        for (uint8_t i = 0; i < record_length / 2; i++) {
-          this->service_uuids_.push_back(ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record + 2 * i)));
-        }
-        break;
-      }
+      case ESP_BLE_AD_TYPE_16SRV_PART:
       case ESP_BLE_AD_TYPE_32SRV_CMPL:
-      case ESP_BLE_AD_TYPE_32SRV_PART: {
-        // • 32-bit Bluetooth Service UUIDs
-        for (uint8_t i = 0; i < record_length / 4; i++) {
-          this->service_uuids_.push_back(ESPBTUUID::from_uint32(*reinterpret_cast<const uint32_t *>(record + 4 * i)));
-        }
-        break;
-      }
+      case ESP_BLE_AD_TYPE_32SRV_PART:
       case ESP_BLE_AD_TYPE_128SRV_CMPL:
       case ESP_BLE_AD_TYPE_128SRV_PART: {
-        // • Global 128-bit Service UUIDs
-        this->service_uuids_.push_back(ESPBTUUID::from_raw(record));
-        break;
-      }
-      case ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE: {
-        // CSS 1.4 MANUFACTURER SPECIFIC DATA
-        // "The Manufacturer Specific data type is used for manufacturer specific data. The first two data octets shall
-        // contain a company identifier from Assigned Numbers. The interpretation of any other octets within the data
-        // shall be defined by the manufacturer specified by the company identifier."
-        // CSS 1: Optional in this context (may appear more than once in a block).
-        if (record_length < 2) {
-          ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE");
-          break;
-        }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record));
-        data.data.assign(record + 2UL, record + record_length);
-        this->manufacturer_datas_.push_back(data);
-        break;
-      }
-
-      // CSS 1.11 SERVICE DATA
-      // "The Service Data data type consists of a service UUID with the data associated with that service."
-      // CSS 1: Optional in this context (may appear more than once in a block).
-      case ESP_BLE_AD_TYPE_SERVICE_DATA: {
-        // «Service Data - 16 bit UUID»
-        // Size: 2 or more octets
-        // The first 2 octets contain the 16 bit Service UUID fol- lowed by additional service data
-        if (record_length < 2) {
-          ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_SERVICE_DATA");
-          break;
+        for (size_t i = 0, count = record.service_uuid_count(); i < count; i++) {
+          this->service_uuids_.push_back(record.service_uuid(i));
         }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record));
-        data.data.assign(record + 2UL, record + record_length);
-        this->service_datas_.push_back(data);
         break;
       }
-      case ESP_BLE_AD_TYPE_32SERVICE_DATA: {
-        // «Service Data - 32 bit UUID»
-        // Size: 4 or more octets
-        // The first 4 octets contain the 32 bit Service UUID fol- lowed by additional service data
-        if (record_length < 4) {
-          ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_32SERVICE_DATA");
-          break;
-        }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_uint32(*reinterpret_cast<const uint32_t *>(record));
-        data.data.assign(record + 4UL, record + record_length);
-        this->service_datas_.push_back(data);
+      case ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE: {
+        auto data = record.as_manufacturer_data();
+        if (data.has_value())
+          this->manufacturer_datas_.push_back(ServiceData{data->uuid, data->to_vector()});
         break;
       }
+      case ESP_BLE_AD_TYPE_SERVICE_DATA:
+      case ESP_BLE_AD_TYPE_32SERVICE_DATA:
       case ESP_BLE_AD_TYPE_128SERVICE_DATA: {
-        // «Service Data - 128 bit UUID»
-        // Size: 16 or more octets
-        // The first 16 octets contain the 128 bit Service UUID followed by additional service data
-        if (record_length < 16) {
-          ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_128SERVICE_DATA");
-          break;
-        }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_raw(record);
-        data.data.assign(record + 16UL, record + record_length);
-        this->service_datas_.push_back(data);
+        auto data = record.as_service_data();
+        if (data.has_value())
+          this->service_datas_.push_back(ServiceData{data->uuid, data->to_vector()});
         break;
       }
       case ESP_BLE_AD_TYPE_INT_RANGE:
         // Avoid logging this as it's very verbose
         break;
       default: {
-        ESP_LOGV(TAG, "Unhandled type: advType: 0x%02x", record_type);
+        ESP_LOGV(TAG, "Unhandled type: advType: 0x%02x", record.type);
         break;
       }
     }
   }
 }
+void DiscoveredDeviceFilter::init(size_t capacity) {
+  size_t size = MAX_PROBES;
+  this->shift_ = 64 - 3;
+  while (size < capacity) {
+    size <<= 1;
+    this->shift_--;
+  }
+  this->entries_.reset(new Entry[size]());  // NOLINT(cppcoreguidelines-owning-memory)
+  this->mask_ = size - 1;
+  this->clear();
+}
+bool DiscoveredDeviceFilter::check_and_insert(uint64_t address) {
+  if (!this->entries_)
+    return false;
+  // stamp 0 marks an empty slot
+  if (++this->clock_ == 0)
+    this->clear();
+
+  // Fibonacci hashing, as the low bits of a random address don't make a good hash on their own
+  size_t start = (address * 0x9E3779B97F4A7C15ULL) >> this->shift_;
+  Entry *victim = nullptr;
+  for (size_t i = 0; i < MAX_PROBES; i++) {
+    Entry &entry = this->entries_[(start + i) & this->mask_];
+    if (entry.last_seen != 0 && entry.address == address) {
+      entry.last_seen = this->clock_;
+      this->hits_++;
+      return true;
+    }
+    if (victim == nullptr || entry.last_seen < victim->last_seen)
+      victim = &entry;
+  }
+
+  this->misses_++;
+  if (victim->last_seen != 0)
+    this->evictions_++;
+  victim->address = address;
+  victim->last_seen = this->clock_;
+  return false;
+}
+void DiscoveredDeviceFilter::clear() {
+  for (size_t i = 0; i <= this->mask_ && this->entries_; i++)
+    this->entries_[i].last_seen = 0;
+  this->clock_ = 1;
+}
+
 std::string ESPBTDevice::address_str() const {
   char mac[24];
   snprintf(mac, sizeof(mac), "%02X:%02X:%02X:%02X:%02X:%02X", this->address_[0], this->address_[1], this->address_[2],
@@ -648,15 +793,12 @@ void ESP32BLETracker::dump_config() {
   ESP_LOGCONFIG(TAG, "  Scan Window: %.1f ms", this->scan_window_ * 0.625f);
   ESP_LOGCONFIG(TAG, "  Scan Type: %s", this->scan_active_ ? "ACTIVE" : "PASSIVE");
   ESP_LOGCONFIG(TAG, "  Continuous Scanning: %s", this->scan_continuous_ ? "True" : "False");
+  ESP_LOGCONFIG(TAG, "  Discovered Devices Cache: %zu", this->already_discovered_.get_capacity());
 }
 
 void ESP32BLETracker::print_bt_device_info(const ESPBTDevice &device) {
-  const uint64_t address = device.address_uint64();
-  for (auto &disc : this->already_discovered_) {
-    if (disc == address)
-      return;
-  }
-  this->already_discovered_.push_back(address);
+  if (this->already_discovered_.check_and_insert(device.address_uint64()))
+    return;
 
   ESP_LOGD(TAG, "Found device %s RSSI=%d", device.address_str().c_str(), device.get_rssi());
 
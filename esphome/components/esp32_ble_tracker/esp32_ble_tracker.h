@@ -3,8 +3,10 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/string_ref.h"
 
 #include <array>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -37,11 +39,38 @@ struct ServiceData {
   adv_data_t data;
 };
 
+/// Manufacturer or service data of an advertisement, pointing into the raw advertisement data.
+struct ServiceDataRef {
+  ESPBTUUID uuid;
+  const uint8_t *data;
+  uint8_t length;
+
+  /// Copy the data, for when it has to outlive the advertisement.
+  adv_data_t to_vector() const { return adv_data_t(this->data, this->data + this->length); }
+};
+
+/// An AD structure of an advertisement, pointing into the raw advertisement data.
+struct ESPBTAdvRecord {
+  uint8_t type;
+  const uint8_t *data;
+  uint8_t length;
+
+  /// The number of service UUIDs in this record, zero if it isn't a list of service UUIDs.
+  size_t service_uuid_count() const;
+  /// The service UUID at \p index, which must be below service_uuid_count().
+  ESPBTUUID service_uuid(size_t index) const;
+  /// The UUID and data of this record, if it's service data.
+  optional<ServiceDataRef> as_service_data() const;
+  /// The company identifier and data of this record, if it's manufacturer specific data.
+  optional<ServiceDataRef> as_manufacturer_data() const;
+};
+
 class ESPBLEiBeacon {
  public:
   ESPBLEiBeacon() { memset(&this->beacon_data_, 0, sizeof(this->beacon_data_)); }
   ESPBLEiBeacon(const uint8_t *data);
   static optional<ESPBLEiBeacon> from_manufacturer_data(const ServiceData &data);
+  static optional<ESPBLEiBeacon> from_manufacturer_data(const ServiceDataRef &data);
 
   uint16_t get_major() { return ((this->beacon_data_.major & 0xFF) << 8) | (this->beacon_data_.major >> 8); }
   uint16_t get_minor() { return ((this->beacon_data_.minor & 0xFF) << 8) | (this->beacon_data_.minor >> 8); }
@@ -59,6 +88,66 @@ class ESPBLEiBeacon {
   } PACKED beacon_data_;
 };
 
+/** A view of the raw advertisement and scan response data of a device, which is parsed in place while iterating.
+ *
+ * Nothing is copied or allocated, so this is what listeners should use to decide whether an advertisement is of
+ * interest to them, as every listener sees every advertisement.
+ */
+class ESPBTAdvertisement {
+ public:
+  class Iterator {
+   public:
+    Iterator(const uint8_t *pos, const uint8_t *end) : pos_(pos), end_(end) { this->skip_padding_(); }
+    ESPBTAdvRecord operator*() const {
+      return ESPBTAdvRecord{this->pos_[1], this->pos_ + 2, static_cast<uint8_t>(this->pos_[0] - 1)};
+    }
+    Iterator &operator++() {
+      this->pos_ += this->pos_[0] + 1;
+      this->skip_padding_();
+      return *this;
+    }
+    bool operator!=(const Iterator &other) const { return this->pos_ != other.pos_; }
+
+   protected:
+    /// Skip zero length padding, and stop at a record that's cut off.
+    void skip_padding_() {
+      while (this->pos_ < this->end_ && this->pos_[0] == 0)
+        this->pos_++;
+      if (this->end_ - this->pos_ < 2 || this->end_ - this->pos_ < this->pos_[0] + 1)
+        this->pos_ = this->end_;
+    }
+
+    const uint8_t *pos_;
+    const uint8_t *end_;
+  };
+
+  ESPBTAdvertisement(const uint8_t *data, size_t length) : data_(data), length_(length) {}
+
+  Iterator begin() const { return Iterator(this->data_, this->data_ + this->length_); }
+  Iterator end() const { return Iterator(this->data_ + this->length_, this->data_ + this->length_); }
+
+  /// The local name, the longer one of the complete and the shortened name.
+  StringRef get_name() const;
+  size_t count_service_uuids() const;
+  bool has_service_uuid(const ESPBTUUID &uuid) const;
+  size_t count_service_datas() const;
+  /// The first service data with \p uuid.
+  optional<ServiceDataRef> get_service_data(const ESPBTUUID &uuid) const;
+  size_t count_manufacturer_datas() const;
+  /// The first manufacturer data with \p uuid.
+  optional<ServiceDataRef> get_manufacturer_data(const ESPBTUUID &uuid) const;
+  optional<ESPBLEiBeacon> get_ibeacon() const;
+
+ protected:
+  const uint8_t *data_;
+  size_t length_;
+};
+
+/** A scanned device and its advertisement.
+ *
+ * The advertisement is only parsed into the name, UUIDs and data lists when one of their getters is first called, as
+ * these allocate. Listeners that look at every advertisement should use get_advertisement() instead.
+ */
 class ESPBTDevice {
  public:
   void parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
@@ -71,47 +160,110 @@ class ESPBTDevice {
 
   esp_ble_addr_type_t get_address_type() const { return this->address_type_; }
   int get_rssi() const { return rssi_; }
-  const std::string &get_name() const { return this->name_; }
+  const std::string &get_name() const {
+    this->parse_adv_();
+    return this->name_;
+  }
 
-  const std::vector<int8_t> &get_tx_powers() const { return tx_powers_; }
+  const std::vector<int8_t> &get_tx_powers() const {
+    this->parse_adv_();
+    return tx_powers_;
+  }
 
-  const optional<uint16_t> &get_appearance() const { return appearance_; }
-  const optional<uint8_t> &get_ad_flag() const { return ad_flag_; }
-  const std::vector<ESPBTUUID> &get_service_uuids() const { return service_uuids_; }
+  const optional<uint16_t> &get_appearance() const {
+    this->parse_adv_();
+    return appearance_;
+  }
+  const optional<uint8_t> &get_ad_flag() const {
+    this->parse_adv_();
+    return ad_flag_;
+  }
+  const std::vector<ESPBTUUID> &get_service_uuids() const {
+    this->parse_adv_();
+    return service_uuids_;
+  }
 
-  const std::vector<ServiceData> &get_manufacturer_datas() const { return manufacturer_datas_; }
+  const std::vector<ServiceData> &get_manufacturer_datas() const {
+    this->parse_adv_();
+    return manufacturer_datas_;
+  }
 
-  const std::vector<ServiceData> &get_service_datas() const { return service_datas_; }
+  const std::vector<ServiceData> &get_service_datas() const {
+    this->parse_adv_();
+    return service_datas_;
+  }
 
   const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &get_scan_result() const { return scan_result_; }
 
-  optional<ESPBLEiBeacon> get_ibeacon() const {
-    for (auto &it : this->manufacturer_datas_) {
-      auto res = ESPBLEiBeacon::from_manufacturer_data(it);
-      if (res.has_value())
-        return *res;
-    }
-    return {};
+  /// The raw advertisement and scan response data, without parsing or copying it.
+  ESPBTAdvertisement get_advertisement() const {
+    return ESPBTAdvertisement(this->scan_result_.ble_adv,
+                              this->scan_result_.adv_data_len + this->scan_result_.scan_rsp_len);
   }
 
+  optional<ESPBLEiBeacon> get_ibeacon() const { return this->get_advertisement().get_ibeacon(); }
+
  protected:
-  void parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
+  void parse_adv_() const;
 
   esp_bd_addr_t address_{
       0,
   };
   esp_ble_addr_type_t address_type_{BLE_ADDR_TYPE_PUBLIC};
   int rssi_{0};
-  std::string name_{};
-  std::vector<int8_t> tx_powers_{};
-  optional<uint16_t> appearance_{};
-  optional<uint8_t> ad_flag_{};
-  std::vector<ESPBTUUID> service_uuids_{};
-  std::vector<ServiceData> manufacturer_datas_{};
-  std::vector<ServiceData> service_datas_{};
+  mutable bool parsed_{false};
+  mutable std::string name_{};
+  mutable std::vector<int8_t> tx_powers_{};
+  mutable optional<uint16_t> appearance_{};
+  mutable optional<uint8_t> ad_flag_{};
+  mutable std::vector<ESPBTUUID> service_uuids_{};
+  mutable std::vector<ServiceData> manufacturer_datas_{};
+  mutable std::vector<ServiceData> service_datas_{};
   esp_ble_gap_cb_param_t::ble_scan_result_evt_param scan_result_{};
 };
 
+/** Fixed size set of recently seen device addresses.
+ *
+ * The addresses are kept in a hash table with a bounded number of slots an address can go into. If those are all taken,
+ * the address that was seen longest ago is evicted. Memory use is thus fixed no matter how many devices are around,
+ * at the cost of an evicted device being reported as new when it's seen again.
+ */
+class DiscoveredDeviceFilter {
+ public:
+  /// Allocate room for \p capacity addresses, rounded up to a power of two.
+  void init(size_t capacity);
+  /// Record that \p address was seen, and return whether it was already in the set.
+  bool check_and_insert(uint64_t address);
+  /// Forget all addresses, the statistics are kept.
+  void clear();
+
+  size_t get_capacity() const { return this->mask_ + 1; }
+  /// Number of lookups of an address that was in the set.
+  uint32_t get_hits() const { return this->hits_; }
+  /// Number of lookups of an address that wasn't in the set, and was inserted.
+  uint32_t get_misses() const { return this->misses_; }
+  /// Number of addresses that were evicted to make room for another one.
+  uint32_t get_evictions() const { return this->evictions_; }
+
+ protected:
+  /// Number of consecutive slots an address can go into.
+  static const size_t MAX_PROBES = 8;
+
+  struct Entry {
+    uint64_t address;
+    /// Value of clock_ when the address was last seen, 0 for an empty slot.
+    uint32_t last_seen;
+  };
+
+  std::unique_ptr<Entry[]> entries_;
+  size_t mask_{0};
+  uint8_t shift_{64};
+  uint32_t clock_{0};
+  uint32_t hits_{0};
+  uint32_t misses_{0};
+  uint32_t evictions_{0};
+};
+
 class ESP32BLETracker;
 
 class ESPBTDeviceListener {
@@ -188,6 +340,10 @@ class ESP32BLETracker : public Component,
   void set_scan_window(uint32_t scan_window) { scan_window_ = scan_window; }
   void set_scan_active(bool scan_active) { scan_active_ = scan_active; }
   void set_scan_continuous(bool scan_continuous) { scan_continuous_ = scan_continuous; }
+  void set_discovered_cache_size(size_t discovered_cache_size) { discovered_cache_size_ = discovered_cache_size; }
+
+  /// The addresses of the devices that have been printed in print_bt_device_info() during this scan.
+  const DiscoveredDeviceFilter &get_already_discovered() const { return already_discovered_; }
 
   /// Setup the FreeRTOS task and the Bluetooth stack.
   void setup() override;
@@ -227,8 +383,9 @@ class ESP32BLETracker : public Component,
 
   int app_id_;
 
-  /// Vector of addresses that have already been printed in print_bt_device_info
-  std::vector<uint64_t> already_discovered_;
+  /// Addresses that have already been printed in print_bt_device_info
+  DiscoveredDeviceFilter already_discovered_;
+  size_t discovered_cache_size_{128};
   std::vector<ESPBTDeviceListener *> listeners_;
   /// Client parameters.
   std::vector<ESPBTClient *> clients_;
@@ -14,6 +14,8 @@ namespace esp32_rmt_led_strip {
 static const char *const TAG = "esp32_rmt_led_strip";
 
 static const uint8_t RMT_CLK_DIV = 2;
+/// Time after which a frame that's still being sent is considered stuck.
+static const uint32_t TX_TIMEOUT_US = 1000000;
 
 void ESP32RMTLEDStripLightOutput::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ESP32 LED Strip...");
@@ -35,8 +37,12 @@ void ESP32RMTLEDStripLightOutput::setup() {
     return;
   }
 
-  ExternalRAMAllocator<rmt_item32_t> rmt_allocator(ExternalRAMAllocator<rmt_item32_t>::ALLOW_FAILURE);
-  this->rmt_buf_ = rmt_allocator.allocate(buffer_size * 8);  // 8 bits per byte, 1 rmt_item32_t per bit
+  this->tx_buf_ = allocator.allocate(buffer_size);
+  if (this->tx_buf_ == nullptr) {
+    ESP_LOGE(TAG, "Cannot allocate transmit buffer!");
+    this->mark_failed();
+    return;
+  }
 
   rmt_config_t config;
   memset(&config, 0, sizeof(config));
@@ -61,6 +67,44 @@ void ESP32RMTLEDStripLightOutput::setup() {
     this->mark_failed();
     return;
   }
+  // the frame is translated to RMT items while it's sent, instead of keeping 32 bytes of items per byte in memory
+  if (rmt_translator_init(config.channel, ESP32RMTLEDStripLightOutput::rmt_translate_) != ESP_OK ||
+      rmt_translator_set_context(config.channel, this) != ESP_OK) {
+    ESP_LOGE(TAG, "Cannot initialize RMT translator!");
+    this->mark_failed();
+    return;
+  }
+}
+
+void IRAM_ATTR ESP32RMTLEDStripLightOutput::rmt_translate_(const void *src, rmt_item32_t *dest, size_t src_size,
+                                                           size_t wanted_num, size_t *translated_size,
+                                                           size_t *item_num) {
+  void *context;
+  if (rmt_translator_get_context(item_num, &context) != ESP_OK) {
+    *translated_size = 0;
+    *item_num = 0;
+    return;
+  }
+  auto *strip = reinterpret_cast<ESP32RMTLEDStripLightOutput *>(context);
+  const uint32_t bit0 = strip->bit0_.val;
+  const uint32_t bit1 = strip->bit1_.val;
+
+  const uint8_t *psrc = reinterpret_cast<const uint8_t *>(src);
+  size_t size = 0;
+  size_t num = 0;
+  // 8 bits per byte, 1 rmt_item32_t per bit
+  while (size < src_size && num + 8 <= wanted_num) {
+    uint8_t b = *psrc;
+    for (int i = 0; i < 8; i++) {
+      dest->val = b & (1 << (7 - i)) ? bit1 : bit0;
+      dest++;
+    }
+    num += 8;
+    size++;
+    psrc++;
+  }
+  *translated_size = size;
+  *item_num = num;
 }
 
 void ESP32RMTLEDStripLightOutput::set_led_params(uint32_t bit0_high, uint32_t bit0_low, uint32_t bit1_high,
@@ -87,36 +131,26 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
     this->schedule_show();
     return;
   }
-  this->last_refresh_ = now;
-  this->mark_shown_();
 
   ESP_LOGVV(TAG, "Writing RGB values to bus...");
 
-  if (rmt_wait_tx_done(this->channel_, pdMS_TO_TICKS(1000)) != ESP_OK) {
-    ESP_LOGE(TAG, "RMT TX timeout");
-    this->status_set_warning();
+  // don't block the loop while the previous frame is still being sent, show this one when it's done
+  if (rmt_wait_tx_done(this->channel_, 0) != ESP_OK) {
+    if (now - this->last_refresh_ > TX_TIMEOUT_US) {
+      ESP_LOGE(TAG, "RMT TX timeout");
+      this->status_set_warning();
+    }
+    this->schedule_show();
     return;
   }
+  this->last_refresh_ = now;
+  this->mark_shown_();
   delayMicroseconds(50);
 
+  // the frame must not change while it's translated, but effects can already prepare the next one in buf_
   size_t buffer_size = this->get_buffer_size_();
-
-  size_t size = 0;
-  size_t len = 0;
-  uint8_t *psrc = this->buf_;
-  rmt_item32_t *pdest = this->rmt_buf_;
-  while (size < buffer_size) {
-    uint8_t b = *psrc;
-    for (int i = 0; i < 8; i++) {
-      pdest->val = b & (1 << (7 - i)) ? this->bit1_.val : this->bit0_.val;
-      pdest++;
-      len++;
-    }
-    size++;
-    psrc++;
-  }
-
-  if (rmt_write_items(this->channel_, this->rmt_buf_, len, false) != ESP_OK) {
+  memcpy(this->tx_buf_, this->buf_, buffer_size);
+  if (rmt_write_sample(this->channel_, this->tx_buf_, buffer_size, false) != ESP_OK) {
     ESP_LOGE(TAG, "RMT TX error");
     this->status_set_warning();
     return;
@@ -125,7 +159,19 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
 }
 
 light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index) const {
-  int32_t r = 0, g = 0, b = 0;
+  light::ESPPixelBuffer buffer;
+  this->get_pixel_buffer_internal(&buffer);
+  uint8_t *pixel = buffer.data + index * buffer.stride;
+  return {pixel + buffer.offsets[0],
+          pixel + buffer.offsets[1],
+          pixel + buffer.offsets[2],
+          this->is_rgbw_ ? pixel + buffer.offsets[3] : nullptr,
+          &this->effect_data_[index],
+          &this->correction_};
+}
+
+bool ESP32RMTLEDStripLightOutput::get_pixel_buffer_internal(light::ESPPixelBuffer *buffer) const {
+  uint8_t r = 0, g = 0, b = 0;
   switch (this->rgb_order_) {
     case ORDER_RGB:
       r = 0;
@@ -158,13 +204,14 @@ light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index
       b = 0;
       break;
   }
-  uint8_t multiplier = this->is_rgbw_ ? 4 : 3;
-  return {this->buf_ + (index * multiplier) + r,
-          this->buf_ + (index * multiplier) + g,
-          this->buf_ + (index * multiplier) + b,
-          this->is_rgbw_ ? this->buf_ + (index * multiplier) + 3 : nullptr,
-          &this->effect_data_[index],
-          &this->correction_};
+  buffer->data = this->buf_;
+  buffer->stride = this->is_rgbw_ ? 4 : 3;
+  buffer->offsets[0] = r;
+  buffer->offsets[1] = g;
+  buffer->offsets[2] = b;
+  buffer->offsets[3] = 3;
+  buffer->channels = buffer->stride;
+  return true;
 }
 
 void ESP32RMTLEDStripLightOutput::dump_config() {
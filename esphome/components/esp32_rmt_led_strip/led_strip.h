@@ -62,12 +62,19 @@ class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
 
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override;
+  bool get_pixel_buffer_internal(light::ESPPixelBuffer *buffer) const override;
 
   size_t get_buffer_size_() const { return this->num_leds_ * (3 + this->is_rgbw_); }
 
+  /// Translate the bytes of the frame to RMT items as the RMT driver needs them, called from its interrupt.
+  static void rmt_translate_(const void *src, rmt_item32_t *dest, size_t src_size, size_t wanted_num,
+                             size_t *translated_size, size_t *item_num);
+
+  /// The pixels, as written by effects and the light state.
   uint8_t *buf_{nullptr};
+  /// The frame that's being transmitted, so the next frame can be prepared in buf_ in the meantime.
+  uint8_t *tx_buf_{nullptr};
   uint8_t *effect_data_{nullptr};
-  rmt_item32_t *rmt_buf_{nullptr};
 
   uint8_t pin_;
   uint16_t num_leds_;
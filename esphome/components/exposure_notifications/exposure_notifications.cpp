@@ -13,26 +13,24 @@ static const char *const TAG = "exposure_notifications";
 
 bool ExposureNotificationTrigger::parse_device(const ESPBTDevice &device) {
   // See also https://blog.google/documents/70/Exposure_Notification_-_Bluetooth_Specification_v1.2.2.pdf
-  if (device.get_service_uuids().size() != 1)
-    return false;
+  auto advertisement = device.get_advertisement();
 
   // Exposure notifications have Service UUID FD 6F
-  ESPBTUUID uuid = device.get_service_uuids()[0];
   // constant service identifier
   const ESPBTUUID expected_uuid = ESPBTUUID::from_uint16(0xFD6F);
-  if (uuid != expected_uuid)
+  if (advertisement.count_service_uuids() != 1 || !advertisement.has_service_uuid(expected_uuid))
     return false;
-  if (device.get_service_datas().size() != 1)
+  if (advertisement.count_service_datas() != 1)
     return false;
 
   // The service data should be 20 bytes
   // First 16 bytes are the rolling proximity identifier (RPI)
   // Then 4 bytes of encrypted metadata follow which can be used to get the transmit power level.
-  ServiceData service_data = device.get_service_datas()[0];
-  if (service_data.uuid != expected_uuid)
+  auto service_data = advertisement.get_service_data(expected_uuid);
+  if (!service_data.has_value())
     return false;
-  auto data = service_data.data;
-  if (data.size() != 20)
+  const uint8_t *data = service_data->data;
+  if (service_data->length != 20)
     return false;
   ExposureNotification notification{};
   memcpy(&notification.address[0], device.address(), 6);
@@ -228,6 +228,16 @@ class FastLEDLightOutput : public light::AddressableLight {
     return {&this->leds_[index].r,      &this->leds_[index].g, &this->leds_[index].b, nullptr,
             &this->effect_data_[index], &this->correction_};
   }
+  bool get_pixel_buffer_internal(light::ESPPixelBuffer *buffer) const override {
+    // CRGB is laid out as r, g, b
+    buffer->data = this->leds_[0].raw;
+    buffer->stride = sizeof(CRGB);
+    buffer->offsets[0] = 0;
+    buffer->offsets[1] = 1;
+    buffer->offsets[2] = 2;
+    buffer->channels = 3;
+    return true;
+  }
 
   CLEDController *controller_{nullptr};
   CRGB *leds_{nullptr};
@@ -238,6 +238,8 @@ DEFAULT_GLYPHS = (
     ' !"%()+=,-.:/0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz°'
 )
 CONF_RAW_GLYPH_ID = "raw_glyph_id"
+CONF_RAW_GLYPH_INDEX_ID = "raw_glyph_index_id"
+CONF_TEXT_CACHE_SIZE = "text_cache_size"
 
 FONT_SCHEMA = cv.Schema(
     {
@@ -247,6 +249,8 @@ FONT_SCHEMA = cv.Schema(
         cv.Optional(CONF_SIZE, default=20): cv.int_range(min=1),
         cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
         cv.GenerateID(CONF_RAW_GLYPH_ID): cv.declare_id(GlyphData),
+        cv.GenerateID(CONF_RAW_GLYPH_INDEX_ID): cv.declare_id(cg.uint16),
+        cv.Optional(CONF_TEXT_CACHE_SIZE): cv.int_range(min=1, max=64),
     }
 )
 
@@ -401,6 +405,26 @@ async def to_code(config):
 
     glyphs = cg.static_const_array(config[CONF_RAW_GLYPH_ID], glyph_initializer)
 
-    cg.new_Pvariable(
-        config[CONF_ID], glyphs, len(glyph_initializer), ascent, ascent + descent
+    # For each first byte, the first glyph starting with it (or a higher byte).
+    # The glyphs are sorted by their UTF-8 encoding, so a lookup only has to
+    # search between the entries of its first byte and the next one.
+    encoded = [glyph.encode("utf-8") for glyph in config[CONF_GLYPHS]]
+    glyph_index = []
+    pos = 0
+    for first in range(256):
+        while pos < len(encoded) and encoded[pos][:1] < bytes([first]):
+            pos += 1
+        glyph_index.append(pos)
+    glyph_index.append(len(encoded))
+    index = cg.progmem_array(config[CONF_RAW_GLYPH_INDEX_ID], glyph_index)
+
+    var = cg.new_Pvariable(
+        config[CONF_ID],
+        glyphs,
+        len(glyph_initializer),
+        ascent,
+        ascent + descent,
+        index,
     )
+    if CONF_TEXT_CACHE_SIZE in config:
+        cg.add(var.set_text_cache_size(config[CONF_TEXT_CACHE_SIZE]))
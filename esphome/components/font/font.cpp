@@ -1,5 +1,7 @@
 #include "font.h"
 
+#include <algorithm>
+
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "esphome/core/color.h"
@@ -10,39 +12,64 @@ namespace font {
 
 static const char *const TAG = "font";
 
-void Glyph::draw(int x_at, int y_start, display::Display *display, Color color) const {
-  int scan_x1, scan_y1, scan_width, scan_height;
-  this->scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
-
-  const unsigned char *data = this->glyph_data_->data;
-  const int max_x = x_at + scan_x1 + scan_width;
-  const int max_y = y_start + scan_y1 + scan_height;
+/// Call `callback(x, y, length)` for every horizontal run of set pixels of the glyph drawn at [x_at,y_start].
+template<typename F> static void scan_glyph(const GlyphData *glyph_data, int x_at, int y_start, F &&callback) {
+  const unsigned char *data = glyph_data->data;
+  const int min_x = x_at + glyph_data->offset_x;
+  const int max_x = min_x + glyph_data->width;
+  const int max_y = y_start + glyph_data->offset_y + glyph_data->height;
 
-  for (int glyph_y = y_start + scan_y1; glyph_y < max_y; glyph_y++) {
-    for (int glyph_x = x_at + scan_x1; glyph_x < max_x; data++, glyph_x += 8) {
+  for (int glyph_y = y_start + glyph_data->offset_y; glyph_y < max_y; glyph_y++) {
+    bool in_run = false;
+    int run_x = 0;
+    for (int glyph_x = min_x; glyph_x < max_x; data++, glyph_x += 8) {
       uint8_t pixel_data = progmem_read_byte(data);
       const int pixel_max_x = std::min(max_x, glyph_x + 8);
 
-      for (int pixel_x = glyph_x; pixel_x < pixel_max_x && pixel_data; pixel_x++, pixel_data <<= 1) {
+      for (int pixel_x = glyph_x; pixel_x < pixel_max_x && (pixel_data || in_run); pixel_x++, pixel_data <<= 1) {
         if (pixel_data & 0x80) {
-          display->draw_pixel_at(pixel_x, glyph_y, color);
+          if (!in_run) {
+            run_x = pixel_x;
+            in_run = true;
+          }
+        } else if (in_run) {
+          callback(run_x, glyph_y, pixel_x - run_x);
+          in_run = false;
         }
       }
     }
+    if (in_run)
+      callback(run_x, glyph_y, max_x - run_x);
+  }
+}
+
+/// FNV-1a hash of a string, to find texts in the cache.
+static uint32_t text_hash(const char *text) {
+  uint32_t hash = 2166136261UL;
+  for (; *text != '\0'; text++) {
+    hash ^= (uint8_t) *text;
+    hash *= 16777619UL;
   }
+  return hash;
+}
+
+void Glyph::draw(int x_at, int y_start, display::Display *display, Color color) const {
+  scan_glyph(this->glyph_data_, x_at, y_start,
+             [=](int x, int y, int length) { display->fill_span(x, y, length, color); });
 }
 const char *Glyph::get_char() const { return this->glyph_data_->a_char; }
 bool Glyph::compare_to(const char *str) const {
   // 1 -> this->char_
   // 2 -> str
+  // compared as unsigned bytes, like the glyphs are sorted by codegen
   for (uint32_t i = 0;; i++) {
     if (this->glyph_data_->a_char[i] == '\0')
       return true;
     if (str[i] == '\0')
       return false;
-    if (this->glyph_data_->a_char[i] > str[i])
+    if ((uint8_t) this->glyph_data_->a_char[i] > (uint8_t) str[i])
       return false;
-    if (this->glyph_data_->a_char[i] < str[i])
+    if ((uint8_t) this->glyph_data_->a_char[i] < (uint8_t) str[i])
       return true;
   }
   // this should not happen
@@ -65,7 +92,8 @@ void Glyph::scan_area(int *x1, int *y1, int *width, int *height) const {
   *height = this->glyph_data_->height;
 }
 
-Font::Font(const GlyphData *data, int data_nr, int baseline, int height) : baseline_(baseline), height_(height) {
+Font::Font(const GlyphData *data, int data_nr, int baseline, int height, const uint16_t *glyph_index)
+    : baseline_(baseline), height_(height), glyph_index_(glyph_index) {
   glyphs_.reserve(data_nr);
   for (int i = 0; i < data_nr; ++i)
     glyphs_.emplace_back(&data[i]);
@@ -73,6 +101,16 @@ Font::Font(const GlyphData *data, int data_nr, int baseline, int height) : basel
 int Font::match_next_glyph(const char *str, int *match_length) {
   int lo = 0;
   int hi = this->glyphs_.size() - 1;
+  if (this->glyph_index_ != nullptr) {
+    // only the glyphs that start with the same byte can match
+    uint8_t first = *str;
+    lo = progmem_read_uint16(this->glyph_index_ + first);
+    hi = progmem_read_uint16(this->glyph_index_ + first + 1) - 1;
+    if (lo > hi) {
+      *match_length = 0;
+      return -1;
+    }
+  }
   while (lo != hi) {
     int mid = (lo + hi + 1) / 2;
     if (this->glyphs_[mid].compare_to(str)) {
@@ -89,6 +127,14 @@ int Font::match_next_glyph(const char *str, int *match_length) {
 void Font::measure(const char *str, int *width, int *x_offset, int *baseline, int *height) {
   *baseline = this->baseline_;
   *height = this->height_;
+  if (this->text_cache_size_ != 0) {
+    const TextRun *run = this->find_text_run_(str, text_hash(str));
+    if (run != nullptr) {
+      *width = run->width;
+      *x_offset = run->x_offset;
+      return;
+    }
+  }
   int i = 0;
   int min_x = 0;
   bool has_char = false;
@@ -119,8 +165,23 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
   *width = x - min_x;
 }
 void Font::print(int x_start, int y_start, display::Display *display, Color color, const char *text) {
+  if (this->text_cache_size_ == 0) {
+    this->rasterize_(text, [=](int x, int y, int length) {
+      display->fill_span(x_start + x, y_start + y, length, color);
+    });
+    return;
+  }
+
+  uint32_t hash = text_hash(text);
+  const TextRun *run = this->find_text_run_(text, hash);
+  if (run == nullptr)
+    run = this->add_text_run_(text, hash);
+  for (const auto &span : run->spans)
+    display->fill_span(x_start + span.x, y_start + span.y, span.length, color);
+}
+template<typename F> void Font::rasterize_(const char *text, F &&callback) {
   int i = 0;
-  int x_at = x_start;
+  int x_at = 0;
   while (text[i] != '\0') {
     int match_length;
     int glyph_n = this->match_next_glyph(text + i, &match_length);
@@ -129,7 +190,8 @@ void Font::print(int x_start, int y_start, display::Display *display, Color colo
       ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", text[i]);
       if (!this->get_glyphs().empty()) {
         uint8_t glyph_width = this->get_glyphs()[0].glyph_data_->width;
-        display->filled_rectangle(x_at, y_start, glyph_width, this->height_, color);
+        for (int y = 0; y < this->height_; y++)
+          callback(x_at, y, glyph_width);
         x_at += glyph_width;
       }
 
@@ -138,12 +200,45 @@ void Font::print(int x_start, int y_start, display::Display *display, Color colo
     }
 
     const Glyph &glyph = this->get_glyphs()[glyph_n];
-    glyph.draw(x_at, y_start, display, color);
+    scan_glyph(glyph.glyph_data_, x_at, 0, callback);
     x_at += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
 
     i += match_length;
   }
 }
+Font::TextRun *Font::find_text_run_(const char *text, uint32_t hash) {
+  for (auto &run : this->text_cache_) {
+    if (run.hash == hash && run.text == text) {
+      run.last_used = ++this->text_cache_clock_;
+      return &run;
+    }
+  }
+  return nullptr;
+}
+Font::TextRun *Font::add_text_run_(const char *text, uint32_t hash) {
+  int width, x_offset, baseline, height;
+  this->measure(text, &width, &x_offset, &baseline, &height);
+
+  TextRun *run;
+  if (this->text_cache_.size() < this->text_cache_size_) {
+    this->text_cache_.emplace_back();
+    run = &this->text_cache_.back();
+  } else {
+    // replace the least recently used text, and reuse its memory
+    run = &*std::min_element(this->text_cache_.begin(), this->text_cache_.end(),
+                             [](const TextRun &a, const TextRun &b) { return a.last_used < b.last_used; });
+    run->spans.clear();
+  }
+  run->hash = hash;
+  run->text = text;
+  run->width = width;
+  run->x_offset = x_offset;
+  run->last_used = ++this->text_cache_clock_;
+  this->rasterize_(text, [run](int x, int y, int length) {
+    run->spans.push_back(TextSpan{(int16_t) x, (int16_t) y, (int16_t) length});
+  });
+  return run;
+}
 
 }  // namespace font
 }  // namespace esphome
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "esphome/core/datatypes.h"
 #include "esphome/core/color.h"
 #include "esphome/components/display/display_buffer.h"
@@ -45,8 +48,10 @@ class Font : public display::BaseFont {
    * @param glyphs A vector of glyphs, must be sorted lexicographically.
    * @param baseline The y-offset from the top of the text to the baseline.
    * @param bottom The y-offset from the top of the text to the bottom (i.e. height).
+   * @param glyph_index For each possible first byte (and one past the last), the index of the first glyph that starts
+   * with that byte or a higher one, in PROGMEM. Optional, without it every lookup searches all glyphs.
    */
-  Font(const GlyphData *data, int data_nr, int baseline, int height);
+  Font(const GlyphData *data, int data_nr, int baseline, int height, const uint16_t *glyph_index = nullptr);
 
   int match_next_glyph(const char *str, int *match_length);
 
@@ -57,10 +62,41 @@ class Font : public display::BaseFont {
 
   const std::vector<Glyph, ExternalRAMAllocator<Glyph>> &get_glyphs() const { return glyphs_; }
 
+  /** Keep the rasterized form of the `size` most recently printed texts.
+   *
+   * Printing or measuring one of them again takes a few horizontal spans from the cache, instead of looking up and
+   * decoding every glyph. Useful when the same labels are redrawn on every update.
+   */
+  void set_text_cache_size(size_t size) { this->text_cache_size_ = size; }
+
  protected:
+  /// A horizontal run of set pixels, relative to the top left corner of the text.
+  struct TextSpan {
+    int16_t x;
+    int16_t y;
+    int16_t length;
+  };
+  struct TextRun {
+    uint32_t hash;
+    std::string text;
+    int width;
+    int x_offset;
+    std::vector<TextSpan> spans;
+    uint32_t last_used;
+  };
+
+  /// Call `callback(x, y, length)` for every horizontal run of set pixels of `text`, relative to its top left corner.
+  template<typename F> void rasterize_(const char *text, F &&callback);
+  TextRun *find_text_run_(const char *text, uint32_t hash);
+  TextRun *add_text_run_(const char *text, uint32_t hash);
+
   std::vector<Glyph, ExternalRAMAllocator<Glyph>> glyphs_;
   int baseline_;
   int height_;
+  const uint16_t *glyph_index_;
+  size_t text_cache_size_{0};
+  uint32_t text_cache_clock_{0};
+  std::vector<TextRun> text_cache_;
 };
 
 }  // namespace font
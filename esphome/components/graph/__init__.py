@@ -31,6 +31,9 @@ from esphome.const import (
 
 CODEOWNERS = ["@synco"]
 
+CONF_INCREMENTAL = "incremental"
+CONF_BACKGROUND_COLOR = "background_color"
+
 DEPENDENCIES = ["display", "sensor"]
 MULTI_CONF = True
 
@@ -98,6 +101,8 @@ GRAPH_SCHEMA = cv.Schema(
         cv.Optional(CONF_X_GRID): cv.positive_time_period_seconds,
         cv.Optional(CONF_Y_GRID): cv.float_range(min=0, min_included=False),
         cv.Optional(CONF_BORDER): cv.boolean,
+        cv.Optional(CONF_INCREMENTAL): cv.boolean,
+        cv.Optional(CONF_BACKGROUND_COLOR): cv.use_id(color.ColorStruct),
         # Single trace options in base
         cv.Optional(CONF_SENSOR): cv.use_id(sensor.Sensor),
         cv.Optional(CONF_LINE_THICKNESS): cv.positive_int,
@@ -161,6 +166,11 @@ async def to_code(config):
         cg.add(var.set_grid_y(config[CONF_Y_GRID]))
     if CONF_BORDER in config:
         cg.add(var.set_border(config[CONF_BORDER]))
+    if CONF_INCREMENTAL in config:
+        cg.add(var.set_incremental(config[CONF_INCREMENTAL]))
+    if CONF_BACKGROUND_COLOR in config:
+        c = await cg.get_variable(config[CONF_BACKGROUND_COLOR])
+        cg.add(var.set_background_color(c))
     # Axis related options
     if CONF_MIN_VALUE in config:
         cg.add(var.set_min_value(config[CONF_MIN_VALUE]))
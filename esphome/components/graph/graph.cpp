@@ -15,9 +15,14 @@ using namespace display;
 static const char *const TAG = "graph";
 static const char *const TAGL = "graphlegend";
 
+static float nan_min(float a, float b) { return std::isnan(a) || b < a ? b : a; }
+static float nan_max(float a, float b) { return std::isnan(a) || b > a ? b : a; }
+
 void HistoryData::init(int length) {
   this->length_ = length;
   this->samples_.resize(length, NAN);
+  this->column_min_.resize(length, NAN);
+  this->column_max_.resize(length, NAN);
   this->last_sample_ = millis();
 }
 
@@ -26,29 +31,54 @@ void HistoryData::take_sample(float data) {
   uint32_t dt = tm - last_sample_;
   last_sample_ = tm;
 
+  if (!std::isnan(data)) {
+    this->last_value_ = data;
+    this->pending_min_ = nan_min(this->pending_min_, data);
+    this->pending_max_ = nan_max(this->pending_max_, data);
+  }
   // Step data based on time
   this->period_ += dt;
   while (this->period_ >= this->update_time_) {
-    this->samples_[this->count_] = data;
+    this->add_column_(data, this->pending_min_, this->pending_max_);
+    // the sensor stays at this value until the next sample, so it's part of the range of the next column
+    this->pending_min_ = data;
+    this->pending_max_ = data;
     this->period_ -= this->update_time_;
-    this->count_ = (this->count_ + 1) % this->length_;
     ESP_LOGV(TAG, "Updating trace with value: %f", data);
   }
-  if (!std::isnan(data)) {
-    // Recalc recent max/min
-    this->recent_min_ = data;
-    this->recent_max_ = data;
-    for (int i = 0; i < this->length_; i++) {
-      if (!std::isnan(this->samples_[i])) {
-        if (this->recent_max_ < this->samples_[i])
-          this->recent_max_ = this->samples_[i];
-        if (this->recent_min_ > this->samples_[i])
-          this->recent_min_ = this->samples_[i];
-      }
+}
+
+void HistoryData::add_column_(float value, float min, float max) {
+  float old = this->samples_[this->count_];
+  this->samples_[this->count_] = value;
+  this->column_min_[this->count_] = min;
+  this->column_max_[this->count_] = max;
+  this->count_ = (this->count_ + 1) % this->length_;
+  this->sample_count_++;
+
+  if (old == this->history_min_ || old == this->history_max_) {
+    // the sample with the lowest or highest value dropped out
+    this->update_history_limits_();
+  } else if (!std::isnan(value)) {
+    this->history_min_ = nan_min(this->history_min_, value);
+    this->history_max_ = nan_max(this->history_max_, value);
+  }
+}
+
+void HistoryData::update_history_limits_() {
+  this->history_min_ = NAN;
+  this->history_max_ = NAN;
+  for (int i = 0; i < this->length_; i++) {
+    if (!std::isnan(this->samples_[i])) {
+      this->history_min_ = nan_min(this->history_min_, this->samples_[i]);
+      this->history_max_ = nan_max(this->history_max_, this->samples_[i]);
     }
   }
 }
 
+float HistoryData::get_recent_min() const { return nan_min(this->history_min_, this->last_value_); }
+float HistoryData::get_recent_max() const { return nan_max(this->history_max_, this->last_value_); }
+
 void GraphTrace::init(Graph *g) {
   ESP_LOGI(TAG, "Init trace for sensor %s", this->get_name().c_str());
   this->data_.init(g->get_width());
@@ -56,14 +86,7 @@ void GraphTrace::init(Graph *g) {
   this->data_.set_update_time_ms(g->get_duration() * 1000 / g->get_width());
 }
 
-void Graph::draw(Display *buff, uint16_t x_offset, uint16_t y_offset, Color color) {
-  /// Plot border
-  if (this->border_) {
-    buff->horizontal_line(x_offset, y_offset, this->width_, color);
-    buff->horizontal_line(x_offset, y_offset + this->height_ - 1, this->width_, color);
-    buff->vertical_line(x_offset, y_offset, this->height_, color);
-    buff->vertical_line(x_offset + this->width_ - 1, y_offset, this->height_, color);
-  }
+Graph::Scale Graph::calculate_scale_() {
   /// Determine best y-axis scale and range
   float ymin = NAN;
   float ymax = NAN;
@@ -134,6 +157,27 @@ void Graph::draw(Display *buff, uint16_t x_offset, uint16_t y_offset, Color colo
     ymax = ym * y_per_div;
     yrange = ymax - ymin;
   }
+  return Scale{ymin, yrange, yn, ym};
+}
+
+void Graph::draw(Display *buff, uint16_t x_offset, uint16_t y_offset, Color color) {
+  Scale scale = this->calculate_scale_();
+  if (this->incremental_) {
+    this->draw_incremental_(buff, x_offset, y_offset, color, scale);
+    return;
+  }
+  float ymin = scale.ymin;
+  float yrange = scale.yrange;
+  int yn = scale.yn;
+  int ym = scale.ym;
+
+  /// Plot border
+  if (this->border_) {
+    buff->horizontal_line(x_offset, y_offset, this->width_, color);
+    buff->horizontal_line(x_offset, y_offset + this->height_ - 1, this->width_, color);
+    buff->vertical_line(x_offset, y_offset, this->height_, color);
+    buff->vertical_line(x_offset + this->width_ - 1, y_offset, this->height_, color);
+  }
 
   /// Draw grid
   if (!std::isnan(this->gridspacing_y_)) {
@@ -161,7 +205,7 @@ void Graph::draw(Display *buff, uint16_t x_offset, uint16_t y_offset, Color colo
   }
 
   /// Draw traces
-  ESP_LOGV(TAG, "Updating graph. ymin %f, ymax %f", ymin, ymax);
+  ESP_LOGV(TAG, "Updating graph. ymin %f, ymax %f", ymin, ymin + yrange);
   for (auto *trace : traces_) {
     Color c = trace->get_line_color();
     uint16_t thick = trace->get_line_thickness();
@@ -181,6 +225,100 @@ void Graph::draw(Display *buff, uint16_t x_offset, uint16_t y_offset, Color colo
   }
 }
 
+int Graph::get_grid_x_period_() {
+  if (std::isnan(this->gridspacing_x_) || this->gridspacing_x_ <= 0)
+    return 0;
+  int n = this->duration_ / this->gridspacing_x_;
+  while (n > 20)
+    n /= 2;
+  return n > 0 ? std::max<int>((this->width_ - 1) / n, 1) : 0;
+}
+
+void Graph::draw_incremental_(Display *buff, uint16_t x_offset, uint16_t y_offset, Color color, const Scale &scale) {
+  uint32_t shift = 0;
+  if (!this->traces_.empty())
+    shift = this->traces_[0]->get_tracedata()->get_sample_count() - this->traces_[0]->drawn_samples_;
+  bool redraw = this->drawn_display_ != buff || this->drawn_x_ != x_offset || this->drawn_y_ != y_offset ||
+                this->drawn_color_ != color || !(this->drawn_scale_ == scale) || buff->is_auto_clear_enabled() ||
+                shift >= this->width_;
+  for (auto *trace : this->traces_) {
+    // the traces have to move on together to scroll them
+    if (trace->get_tracedata()->get_sample_count() - trace->drawn_samples_ != shift)
+      redraw = true;
+    trace->drawn_samples_ = trace->get_tracedata()->get_sample_count();
+  }
+  this->position_ += shift;
+
+  if (!redraw) {
+    if (shift == 0)
+      return;
+    // move the plot left and draw the new columns, as well as the columns that held the border before
+    if (buff->copy_block(x_offset + shift, y_offset, this->width_ - shift, this->height_, x_offset, y_offset)) {
+      this->draw_column_(buff, x_offset, y_offset, color, scale, 0);
+      for (uint32_t x = this->width_ - 1 - shift; x < this->width_; x++)
+        this->draw_column_(buff, x_offset, y_offset, color, scale, x);
+      return;
+    }
+  }
+
+  ESP_LOGV(TAG, "Redrawing graph. ymin %f, ymax %f", scale.ymin, scale.ymin + scale.yrange);
+  this->drawn_display_ = buff;
+  this->drawn_x_ = x_offset;
+  this->drawn_y_ = y_offset;
+  this->drawn_color_ = color;
+  this->drawn_scale_ = scale;
+  for (uint32_t x = 0; x < this->width_; x++)
+    this->draw_column_(buff, x_offset, y_offset, color, scale, x);
+}
+
+void Graph::draw_column_(Display *buff, uint16_t x_offset, uint16_t y_offset, Color color, const Scale &scale,
+                         uint32_t x) {
+  uint32_t i = this->width_ - 1 - x;
+  uint32_t position = this->position_ - i;
+  int px = x_offset + x;
+  buff->vertical_line(px, y_offset, this->height_, this->background_color_);
+
+  /// Plot border
+  if (this->border_) {
+    if (x == 0 || x == this->width_ - 1) {
+      buff->vertical_line(px, y_offset, this->height_, color);
+    } else {
+      buff->draw_pixel_at(px, y_offset, color);
+      buff->draw_pixel_at(px, y_offset + this->height_ - 1, color);
+    }
+  }
+
+  /// Draw grid
+  if (!std::isnan(this->gridspacing_y_) && position % 2 == 0) {
+    for (int y = scale.yn; y <= scale.ym; y++) {
+      int16_t py = (int16_t) roundf((this->height_ - 1) * (1.0 - (float) (y - scale.yn) / (scale.ym - scale.yn)));
+      buff->draw_pixel_at(px, y_offset + py, color);
+    }
+  }
+  int period = this->get_grid_x_period_();
+  if (period > 0 && position % period == 0) {
+    for (uint32_t y = 0; y < this->height_; y += 2)
+      buff->draw_pixel_at(px, y_offset + y, color);
+  }
+
+  /// Draw traces
+  for (auto *trace : this->traces_) {
+    uint16_t thick = trace->get_line_thickness();
+    float v = (trace->get_tracedata()->get_value(i) - scale.ymin) / scale.yrange;
+    if (!std::isnan(v) && (thick > 0)) {
+      uint8_t b = (position % (thick * LineType::PATTERN_LENGTH)) / thick;
+      if (((uint8_t) trace->get_line_type() & (1 << b)) == (1 << b)) {
+        // only the plot is scrolled, so stay inside of it
+        int y = (int) roundf((this->height_ - 1) * (1.0 - v)) - thick / 2;
+        int y1 = std::max(y, 0);
+        int y2 = std::min(y + thick, (int) this->height_);
+        if (y1 < y2)
+          buff->vertical_line(px, y_offset + y1, y2 - y1, trace->get_line_color());
+      }
+    }
+  }
+}
+
 /// Determine the best coordinates of drawing text + lines
 void GraphLegend::init(Graph *g) {
   parent_ = g;
@@ -354,6 +492,8 @@ void Graph::draw_legend(display::Display *buff, uint16_t x_offset, uint16_t y_of
 }
 
 void Graph::setup() {
+  // start with the columns at positive positions, so the patterns don't wrap around in the empty part of the graph
+  this->position_ = this->width_;
   for (auto *trace : traces_) {
     trace->init(this);
   }
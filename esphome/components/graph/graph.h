@@ -83,6 +83,13 @@ class GraphLegend {
   friend Graph;
 };
 
+/** Ring buffer with one sample per column of the graph.
+ *
+ * Besides the value at the end of its period, which is what's plotted, each column keeps the lowest and highest value
+ * of the sensor during that period. The autoscale range only covers the plotted values, so that the graph isn't scaled
+ * for spikes it doesn't show. It's kept up to date as columns are added, so the values only have to be searched again
+ * when the one holding the minimum or maximum drops out of the history.
+ */
 class HistoryData {
  public:
   void init(int length);
@@ -90,19 +97,38 @@ class HistoryData {
   void set_update_time_ms(uint32_t update_time_ms) { update_time_ = update_time_ms; }
   void take_sample(float data);
   int get_length() const { return length_; }
-  float get_value(int idx) const { return samples_[(count_ + length_ - 1 - idx) % length_]; }
-  float get_recent_max() const { return recent_max_; }
-  float get_recent_min() const { return recent_min_; }
+  float get_value(int idx) const { return samples_[this->index_(idx)]; }
+  /// Lowest value of the sensor during the period of column `idx`, counted from the newest like get_value().
+  float get_min(int idx) const { return column_min_[this->index_(idx)]; }
+  /// Highest value of the sensor during the period of column `idx`.
+  float get_max(int idx) const { return column_max_[this->index_(idx)]; }
+  float get_recent_max() const;
+  float get_recent_min() const;
+  /// Number of columns added since boot, to tell how far the history has moved on.
+  uint32_t get_sample_count() const { return sample_count_; }
 
  protected:
+  int index_(int idx) const { return (count_ + length_ - 1 - idx) % length_; }
+  void add_column_(float value, float min, float max);
+  void update_history_limits_();
+
   uint32_t last_sample_;
   uint32_t period_{0};       /// in ms
   uint32_t update_time_{0};  /// in ms
   int length_;
   int count_{0};
-  float recent_min_{NAN};
-  float recent_max_{NAN};
+  uint32_t sample_count_{0};
+  /// Last valid value of the sensor, which isn't necessarily in the history yet.
+  float last_value_{NAN};
+  /// Range of the sensor in the column that's being recorded.
+  float pending_min_{NAN};
+  float pending_max_{NAN};
+  /// Range of the plotted values in the history.
+  float history_min_{NAN};
+  float history_max_{NAN};
   std::vector<float> samples_;
+  std::vector<float> column_min_;
+  std::vector<float> column_max_;
 };
 
 class GraphTrace {
@@ -126,6 +152,7 @@ class GraphTrace {
   enum LineType line_type_ { LINE_TYPE_SOLID };
   Color line_color_{COLOR_ON};
   HistoryData data_;
+  uint32_t drawn_samples_{0};
 
   friend Graph;
   friend GraphLegend;
@@ -150,6 +177,13 @@ class Graph : public Component {
   void set_grid_x(float val) { this->gridspacing_x_ = val; }
   void set_grid_y(float val) { this->gridspacing_y_ = val; }
   void set_border(bool val) { this->border_ = val; }
+  /** Only draw the columns added since the last update, and scroll the rest of the plot on the display.
+   *
+   * This needs a display that keeps its content between updates (no auto clear) and can copy blocks, otherwise the
+   * graph is drawn in full. The grid and line patterns scroll along with the data.
+   */
+  void set_incremental(bool val) { this->incremental_ = val; }
+  void set_background_color(Color val) { this->background_color_ = val; }
   void add_trace(GraphTrace *trace) { traces_.push_back(trace); }
   void add_legend(GraphLegend *legend) {
     this->legend_ = legend;
@@ -160,6 +194,23 @@ class Graph : public Component {
   uint32_t get_height() { return height_; }
 
  protected:
+  struct Scale {
+    float ymin;
+    float yrange;
+    int yn;
+    int ym;
+    bool operator==(const Scale &rhs) const {
+      return this->ymin == rhs.ymin && this->yrange == rhs.yrange && this->yn == rhs.yn && this->ym == rhs.ym;
+    }
+  };
+  Scale calculate_scale_();
+  /// Number of columns between the vertical grid lines, 0 without them.
+  int get_grid_x_period_();
+  void draw_incremental_(display::Display *buff, uint16_t x_offset, uint16_t y_offset, Color color,
+                         const Scale &scale);
+  void draw_column_(display::Display *buff, uint16_t x_offset, uint16_t y_offset, Color color, const Scale &scale,
+                    uint32_t x);
+
   uint32_t duration_;  /// in seconds
   uint32_t width_;     /// in pixels
   uint32_t height_;    /// in pixels
@@ -170,8 +221,18 @@ class Graph : public Component {
   float gridspacing_x_{NAN};
   float gridspacing_y_{NAN};
   bool border_{true};
+  bool incremental_{false};
+  Color background_color_{0, 0, 0, 0};
   std::vector<GraphTrace *> traces_;
   GraphLegend *legend_{nullptr};
+  // State of the last incremental draw
+  display::Display *drawn_display_{nullptr};
+  uint16_t drawn_x_{0};
+  uint16_t drawn_y_{0};
+  Color drawn_color_;
+  Scale drawn_scale_{};
+  /// Sample position of the rightmost column, the grid and line patterns are aligned to it.
+  uint32_t position_{0};
 
   friend GraphLegend;
 };
@@ -1,7 +1,17 @@
 #ifdef USE_HOST
 
 #include "preferences.h"
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "esphome/core/application.h"
 #include "esphome/core/preferences.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
@@ -12,16 +22,272 @@ namespace host {
 
 static const char *const TAG = "host.preferences";
 
+/* The preferences are stored as an append-only log of records:
+ *
+ *   uint32_t key | uint16_t length | uint8_t data[length] | uint16_t crc16(key, length, data)
+ *
+ * The last valid record of a key wins. A record with a bad CRC can only be the result of an interrupted write at the
+ * end of the log, so loading stops there. Once the log has grown to several times the size of the live data, it's
+ * compacted by writing the live records to a new file and renaming that over the log.
+ */
+static const size_t RECORD_HEADER_SIZE = 6;
+static const size_t RECORD_FOOTER_SIZE = 2;
+/// The length field of a record limits the size of a preference.
+static const size_t MAX_RECORD_DATA_SIZE = 0xFFFF;
+/// Don't bother compacting small logs.
+static const size_t COMPACT_MIN_SIZE = 4096;
+/// Compact once the log is this many times the size of the live data.
+static const size_t COMPACT_FACTOR = 4;
+
+class HostPreferences;
+
+class HostPreferenceBackend : public ESPPreferenceBackend {
+ public:
+  HostPreferenceBackend(HostPreferences *prefs, uint32_t key) : prefs_(prefs), key_(key) {}
+  bool save(const uint8_t *data, size_t len) override;
+  bool load(uint8_t *data, size_t len) override;
+
+ protected:
+  HostPreferences *prefs_;
+  uint32_t key_;
+};
+
 class HostPreferences : public ESPPreferences {
  public:
-  ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override { return {}; }
+  ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override {
+    return make_preference(length, type);
+  }
+
+  ESPPreferenceObject make_preference(size_t length, uint32_t type) override {
+    auto *pref = new HostPreferenceBackend(this, type);  // NOLINT(cppcoreguidelines-owning-memory)
+    return ESPPreferenceObject(pref);
+  }
+
+  bool save(uint32_t key, const uint8_t *data, size_t len) {
+    if (len > MAX_RECORD_DATA_SIZE) {
+      ESP_LOGE(TAG, "Preference %" PRIu32 " is too large to be saved (%zu bytes)", key, len);
+      return false;
+    }
+    // writes are only collected here, so that many saves in one loop cost a single write and fsync in sync()
+    this->pending_save_[key].assign(data, data + len);
+    ESP_LOGVV(TAG, "pending_save: key: %" PRIu32 ", len: %zu", key, len);
+    return true;
+  }
+
+  bool load(uint32_t key, uint8_t *data, size_t len) {
+    this->open_();
+    auto it = this->pending_save_.find(key);
+    if (it == this->pending_save_.end()) {
+      it = this->data_.find(key);
+      if (it == this->data_.end()) {
+        ESP_LOGV(TAG, "load(%" PRIu32 "): the key might not be set yet", key);
+        return false;
+      }
+    }
+    if (it->second.size() != len) {
+      ESP_LOGVV(TAG, "Length does not match (%zu!=%zu)", it->second.size(), len);
+      return false;
+    }
+    memcpy(data, it->second.data(), len);
+    return true;
+  }
+
+  bool sync() override {
+    if (this->pending_save_.empty())
+      return true;
+    this->open_();
+
+    ESP_LOGD(TAG, "Saving %zu preferences to %s...", this->pending_save_.size(), this->path_.c_str());
+    int cached = 0, written = 0;
+    std::vector<uint8_t> records;
+    for (auto it = this->pending_save_.begin(); it != this->pending_save_.end();) {
+      auto stored = this->data_.find(it->first);
+      if (stored != this->data_.end() && stored->second == it->second) {
+        ESP_LOGV(TAG, "Data not changed skipping %" PRIu32 "  len=%zu", it->first, it->second.size());
+        cached++;
+        it = this->pending_save_.erase(it);
+        continue;
+      }
+      append_record_(records, it->first, it->second);
+      written++;
+      it++;
+    }
+
+    if (!records.empty()) {
+      if (this->invalid_) {
+        ESP_LOGE(TAG, "Preferences have been reset, not saving until restart");
+        return false;
+      }
+      if (!this->append_(records)) {
+        ESP_LOGE(TAG, "Error saving %d preferences to %s: %s", written, this->path_.c_str(), strerror(errno));
+        return false;
+      }
+      for (auto &save : this->pending_save_) {
+        this->live_size_ += save.second.size() + RECORD_HEADER_SIZE + RECORD_FOOTER_SIZE;
+        auto stored = this->data_.find(save.first);
+        if (stored != this->data_.end())
+          this->live_size_ -= stored->second.size() + RECORD_HEADER_SIZE + RECORD_FOOTER_SIZE;
+        this->data_[save.first] = std::move(save.second);
+      }
+      this->pending_save_.clear();
+      this->bytes_written_ += records.size();
+    }
+    ESP_LOGD(TAG, "Saving %d preferences: %d cached, %d written, %" PRIu64 " bytes written since boot",
+             cached + written, cached, written, this->bytes_written_);
+
+    if (this->log_size_ > COMPACT_MIN_SIZE && this->log_size_ > this->live_size_ * COMPACT_FACTOR)
+      return this->compact_();
+    return true;
+  }
 
-  ESPPreferenceObject make_preference(size_t length, uint32_t type) override { return {}; }
+  bool reset() override {
+    this->open_();
+    ESP_LOGD(TAG, "Cleaning up preferences in %s...", this->path_.c_str());
+    this->pending_save_.clear();
+    this->data_.clear();
+    this->live_size_ = 0;
+    this->log_size_ = 0;
+    if (this->file_ != nullptr) {
+      fclose(this->file_);
+      this->file_ = nullptr;
+    }
+    unlink(this->path_.c_str());
+    // Prevent any saves until restart, like erasing the flash does on the devices
+    this->invalid_ = true;
+    return true;
+  }
 
-  bool sync() override { return true; }
-  bool reset() override { return true; }
+ protected:
+  /// Open the log and load all records, on first use as the app name isn't known before setup.
+  void open_() {
+    if (this->opened_)
+      return;
+    this->opened_ = true;
+
+    const char *home = getenv("HOME");
+    std::string dir = std::string(home != nullptr ? home : ".") + "/.esphome";
+    mkdir(dir.c_str(), 0755);
+    dir += "/prefs";
+    mkdir(dir.c_str(), 0755);
+    this->path_ = dir + "/" + App.get_name() + ".prefs";
+
+    this->load_log_();
+    this->file_ = fopen(this->path_.c_str(), "ab");
+    if (this->file_ == nullptr)
+      ESP_LOGE(TAG, "Could not open %s: %s", this->path_.c_str(), strerror(errno));
+  }
+
+  void load_log_() {
+    FILE *file = fopen(this->path_.c_str(), "rb");
+    if (file == nullptr)
+      return;
+    std::vector<uint8_t> log;
+    uint8_t chunk[512];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+      log.insert(log.end(), chunk, chunk + read);
+    fclose(file);
+
+    size_t pos = 0;
+    while (pos + RECORD_HEADER_SIZE + RECORD_FOOTER_SIZE <= log.size()) {
+      const uint8_t *record = &log[pos];
+      uint32_t key = encode_uint32(record[3], record[2], record[1], record[0]);
+      uint16_t len = encode_uint16(record[5], record[4]);
+      size_t record_size = RECORD_HEADER_SIZE + len + RECORD_FOOTER_SIZE;
+      if (pos + record_size > log.size())
+        break;
+      uint16_t crc = encode_uint16(record[record_size - 1], record[record_size - 2]);
+      if (crc16(record, RECORD_HEADER_SIZE + len) != crc)
+        break;
+      this->data_[key].assign(record + RECORD_HEADER_SIZE, record + RECORD_HEADER_SIZE + len);
+      pos += record_size;
+    }
+    this->log_size_ = pos;
+    this->live_size_ = 0;
+    for (auto &it : this->data_)
+      this->live_size_ += it.second.size() + RECORD_HEADER_SIZE + RECORD_FOOTER_SIZE;
+    ESP_LOGV(TAG, "Loaded %zu preferences from %s", this->data_.size(), this->path_.c_str());
+
+    if (pos != log.size()) {
+      // drop the torn record, otherwise new records would be appended after it and never be read back
+      ESP_LOGW(TAG, "Discarding %zu bytes of corrupt data at the end of %s", log.size() - pos, this->path_.c_str());
+      this->compact_();
+    }
+  }
+
+  static void append_record_(std::vector<uint8_t> &out, uint32_t key, const std::vector<uint8_t> &data) {
+    size_t start = out.size();
+    out.push_back(key);
+    out.push_back(key >> 8);
+    out.push_back(key >> 16);
+    out.push_back(key >> 24);
+    out.push_back(data.size());
+    out.push_back(data.size() >> 8);
+    out.insert(out.end(), data.begin(), data.end());
+    uint16_t crc = crc16(&out[start], out.size() - start);
+    out.push_back(crc);
+    out.push_back(crc >> 8);
+  }
+
+  bool append_(const std::vector<uint8_t> &records) {
+    if (this->file_ == nullptr)
+      return false;
+    if (fwrite(records.data(), 1, records.size(), this->file_) != records.size())
+      return false;
+    if (fflush(this->file_) != 0 || fsync(fileno(this->file_)) != 0)
+      return false;
+    this->log_size_ += records.size();
+    return true;
+  }
+
+  /// Rewrite the log with only the live records and atomically replace the old one.
+  bool compact_() {
+    std::vector<uint8_t> records;
+    for (auto &it : this->data_)
+      append_record_(records, it.first, it.second);
+
+    std::string tmp_path = this->path_ + ".tmp";
+    FILE *file = fopen(tmp_path.c_str(), "wb");
+    if (file == nullptr) {
+      ESP_LOGW(TAG, "Could not compact %s: %s", this->path_.c_str(), strerror(errno));
+      return false;
+    }
+    bool ok = fwrite(records.data(), 1, records.size(), file) == records.size();
+    ok = ok && fflush(file) == 0 && fsync(fileno(file)) == 0;
+    fclose(file);
+    if (!ok || rename(tmp_path.c_str(), this->path_.c_str()) != 0) {
+      ESP_LOGW(TAG, "Could not compact %s: %s", this->path_.c_str(), strerror(errno));
+      unlink(tmp_path.c_str());
+      return false;
+    }
+    ESP_LOGV(TAG, "Compacted %s from %zu to %zu bytes", this->path_.c_str(), this->log_size_, records.size());
+    this->bytes_written_ += records.size();
+    this->log_size_ = records.size();
+    this->live_size_ = records.size();
+
+    // the appending handle still points to the replaced file
+    if (this->file_ != nullptr) {
+      fclose(this->file_);
+      this->file_ = fopen(this->path_.c_str(), "ab");
+    }
+    return true;
+  }
+
+  std::string path_;
+  FILE *file_{nullptr};
+  bool opened_{false};
+  bool invalid_{false};
+  /// Stored data by key, as in the log.
+  std::map<uint32_t, std::vector<uint8_t>> data_;
+  std::map<uint32_t, std::vector<uint8_t>> pending_save_;
+  size_t log_size_{0};
+  size_t live_size_{0};
+  uint64_t bytes_written_{0};
 };
 
+bool HostPreferenceBackend::save(const uint8_t *data, size_t len) { return this->prefs_->save(this->key_, data, len); }
+bool HostPreferenceBackend::load(uint8_t *data, size_t len) { return this->prefs_->load(this->key_, data, len); }
+
 void setup_preferences() {
   auto *pref = new HostPreferences();  // NOLINT(cppcoreguidelines-owning-memory)
   global_preferences = pref;
@@ -34,11 +34,6 @@ void ILI9XXXDisplay::setup() {
     mad |= MADCTL_MY;
   this->send_command(ILI9XXX_MADCTL, &mad, 1);
 
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
-
   if (this->buffer_color_mode_ == BITS_16) {
     this->init_internal_(this->get_buffer_length_() * 2);
     if (this->buffer_ != nullptr) {
@@ -103,10 +98,7 @@ float ILI9XXXDisplay::get_setup_priority() const { return setup_priority::HARDWA
 
 void ILI9XXXDisplay::fill(Color color) {
   uint16_t new_color = 0;
-  this->x_low_ = 0;
-  this->y_low_ = 0;
-  this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
+  this->mark_dirty_(0, 0, this->get_width_internal() - 1, this->get_height_internal() - 1);
   switch (this->buffer_color_mode_) {
     case BITS_8_INDEXED:
       new_color = display::ColorUtil::color_to_index8_palette888(color, this->palette_);
@@ -165,17 +157,116 @@ void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color)
     this->buffer_[pos] = new_color;
     updated = true;
   }
-  if (updated) {
-    // low and high watermark may speed up drawing from buffer
-    if (x < this->x_low_)
-      this->x_low_ = x;
-    if (y < this->y_low_)
-      this->y_low_ = y;
-    if (x > this->x_high_)
-      this->x_high_ = x;
-    if (y > this->y_high_)
-      this->y_high_ = y;
+  if (updated)
+    this->mark_dirty_(x, y, x, y);
+}
+
+void HOT ILI9XXXDisplay::fill_absolute_block_internal(int x, int y, int width, int height, Color color) {
+  bool updated = false;
+  if (this->buffer_color_mode_ == BITS_16) {
+    uint16_t new_color = display::ColorUtil::color_to_565(color, display::ColorOrder::COLOR_ORDER_RGB);
+    uint8_t high = new_color >> 8, low = new_color;
+    for (int row = y; row < y + height; row++) {
+      uint8_t *pos = this->buffer_ + (row * this->width_ + x) * 2;
+      for (int i = 0; i < width; i++, pos += 2) {
+        if (pos[0] != high || pos[1] != low) {
+          pos[0] = high;
+          pos[1] = low;
+          updated = true;
+        }
+      }
+    }
+  } else {
+    uint8_t new_color = this->buffer_color_mode_ == BITS_8_INDEXED
+                            ? display::ColorUtil::color_to_index8_palette888(color, this->palette_)
+                            : display::ColorUtil::color_to_332(color, display::ColorOrder::COLOR_ORDER_RGB);
+    for (int row = y; row < y + height; row++) {
+      uint8_t *pos = this->buffer_ + row * this->width_ + x;
+      for (int i = 0; i < width; i++, pos++) {
+        if (*pos != new_color) {
+          *pos = new_color;
+          updated = true;
+        }
+      }
+    }
+  }
+  if (updated)
+    this->mark_dirty_(x, y, x + width - 1, y + height - 1);
+}
+
+void ILI9XXXDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr,
+                                    display::ColorOrder order, display::ColorBitness bitness, bool big_endian,
+                                    int x_offset, int y_offset, int x_pad) {
+  // only big endian RGB565 is stored in the buffer as is, and without rotation its rows are the rows of the source
+  if (this->buffer_ == nullptr || this->rotation_ != display::DISPLAY_ROTATION_0_DEGREES ||
+      this->buffer_color_mode_ != BITS_16 || bitness != display::COLOR_BITNESS_565 ||
+      order != display::COLOR_ORDER_RGB || !big_endian) {
+    display::Display::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset,
+                                     x_pad);
+    return;
+  }
+  int x1, x2, y1, y2;
+  if (!this->clamp_x_(x_start, w, x1, x2) || !this->clamp_y_(y_start, h, y1, y2))
+    return;
+  size_t line_stride = x_offset + w + x_pad;
+  for (int y = y1; y < y2; y++) {
+    const uint8_t *src = ptr + ((y_offset + y - y_start) * line_stride + x_offset + x1 - x_start) * 2;
+    memcpy(this->buffer_ + (y * this->width_ + x1) * 2, src, (x2 - x1) * 2);
+  }
+  this->mark_dirty_(x1, y1, x2 - 1, y2 - 1);
+}
+
+bool ILI9XXXDisplay::copy_rows(int src_y, int dst_y, int height) {
+  int rows = this->get_height_internal();
+  if (this->buffer_ == nullptr || this->is_clipping() || height <= 0 || src_y < 0 || dst_y < 0 ||
+      src_y + height > rows || dst_y + height > rows)
+    return false;
+  switch (this->rotation_) {
+    case display::DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case display::DISPLAY_ROTATION_180_DEGREES:
+      src_y = rows - src_y - height;
+      dst_y = rows - dst_y - height;
+      break;
+    default:
+      // the rows are columns of the buffer
+      return false;
+  }
+  size_t row_length = this->width_ * this->get_bytes_per_pixel_();
+  memmove(this->buffer_ + dst_y * row_length, this->buffer_ + src_y * row_length, height * row_length);
+  this->mark_dirty_(0, dst_y, this->width_ - 1, dst_y + height - 1);
+  return true;
+}
+
+bool ILI9XXXDisplay::copy_block(int src_x, int src_y, int width, int height, int dst_x, int dst_y) {
+  int columns = this->get_width_internal(), rows = this->get_height_internal();
+  if (this->buffer_ == nullptr || this->is_clipping() || width <= 0 || height <= 0 || src_x < 0 || src_y < 0 ||
+      dst_x < 0 || dst_y < 0 || src_x + width > columns || dst_x + width > columns || src_y + height > rows ||
+      dst_y + height > rows)
+    return false;
+  switch (this->rotation_) {
+    case display::DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case display::DISPLAY_ROTATION_180_DEGREES:
+      src_x = columns - src_x - width;
+      dst_x = columns - dst_x - width;
+      src_y = rows - src_y - height;
+      dst_y = rows - dst_y - height;
+      break;
+    default:
+      return false;
+  }
+  size_t bytes_per_pixel = this->get_bytes_per_pixel_();
+  size_t row_length = this->width_ * bytes_per_pixel;
+  // copy the rows in an order that doesn't overwrite rows still to be copied
+  bool down = dst_y > src_y;
+  for (int i = 0; i < height; i++) {
+    int row = down ? height - 1 - i : i;
+    memmove(this->buffer_ + (dst_y + row) * row_length + dst_x * bytes_per_pixel,
+            this->buffer_ + (src_y + row) * row_length + src_x * bytes_per_pixel, width * bytes_per_pixel);
   }
+  this->mark_dirty_(dst_x, dst_y, dst_x + width - 1, dst_y + height - 1);
+  return true;
 }
 
 void ILI9XXXDisplay::update() {
@@ -193,16 +284,28 @@ void ILI9XXXDisplay::update() {
 }
 
 void ILI9XXXDisplay::display_() {
-  uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE];
+  size_t band = 0;
+  int x1, y1, x2, y2;
   // check if something was displayed
-  if ((this->x_high_ < this->x_low_) || (this->y_high_ < this->y_low_)) {
+  if (!this->take_dirty_region_(band, x1, y1, x2, y2)) {
     ESP_LOGV(TAG, "Nothing to display");
     return;
   }
 
-  // we will only update the changed rows to the display
-  size_t const w = this->x_high_ - this->x_low_ + 1;
-  size_t const h = this->y_high_ - this->y_low_ + 1;
+  auto now = millis();
+  this->enable();
+  // we will only update the changed regions of the display
+  do {
+    this->write_region_(x1, y1, x2, y2);
+  } while (this->take_dirty_region_(band, x1, y1, x2, y2));
+  this->disable();
+  ESP_LOGV(TAG, "Data write took %dms", (unsigned) (millis() - now));
+}
+
+void ILI9XXXDisplay::write_region_(int x1, int y1, int x2, int y2) {
+  uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE];
+  size_t const w = x2 - x1 + 1;
+  size_t const h = y2 - y1 + 1;
 
   size_t mhz = this->data_rate_ / 1000000;
   // estimate time for a single write
@@ -212,22 +315,19 @@ void ILI9XXXDisplay::display_() {
   ESP_LOGV(TAG,
            "Start display(xlow:%d, ylow:%d, xhigh:%d, yhigh:%d, width:%d, "
            "height:%d, mode=%d, 18bit=%d, sw_time=%dus, mw_time=%dus)",
-           this->x_low_, this->y_low_, this->x_high_, this->y_high_, w, h, this->buffer_color_mode_,
-           this->is_18bitdisplay_, sw_time, mw_time);
-  auto now = millis();
-  this->enable();
+           x1, y1, x2, y2, w, h, this->buffer_color_mode_, this->is_18bitdisplay_, sw_time, mw_time);
   if (this->buffer_color_mode_ == BITS_16 && !this->is_18bitdisplay_ && sw_time < mw_time) {
     // 16 bit mode maps directly to display format
     ESP_LOGV(TAG, "Doing single write of %d bytes", this->width_ * h * 2);
-    set_addr_window_(0, this->y_low_, this->width_ - 1, this->y_high_);
-    this->write_array(this->buffer_ + this->y_low_ * this->width_ * 2, h * this->width_ * 2);
+    set_addr_window_(0, y1, this->width_ - 1, y2);
+    this->write_array(this->buffer_ + y1 * this->width_ * 2, h * this->width_ * 2);
   } else {
     ESP_LOGV(TAG, "Doing multiple write");
     size_t rem = h * w;  // remaining number of pixels to write
-    set_addr_window_(this->x_low_, this->y_low_, this->x_high_, this->y_high_);
+    set_addr_window_(x1, y1, x2, y2);
     size_t idx = 0;    // index into transfer_buffer
     size_t pixel = 0;  // pixel number offset
-    size_t pos = this->y_low_ * this->width_ + this->x_low_;
+    size_t pos = y1 * this->width_ + x1;
     while (rem-- != 0) {
       uint16_t color_val;
       switch (this->buffer_color_mode_) {
@@ -267,13 +367,6 @@ void ILI9XXXDisplay::display_() {
       this->write_array(transfer_buffer, idx);
     }
   }
-  this->disable();
-  ESP_LOGV(TAG, "Data write took %dms", (unsigned) (millis() - now));
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
 }
 
 // should return the total size: return this->get_width_internal() * this->get_height_internal() * 2 // 16bit color
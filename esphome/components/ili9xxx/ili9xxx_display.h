@@ -79,6 +79,10 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   void update() override;
 
   void fill(Color color) override;
+  void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
+                      display::ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) override;
+  bool copy_rows(int src_y, int dst_y, int height) override;
+  bool copy_block(int src_x, int src_y, int width, int height, int dst_x, int dst_y) override;
 
   void dump_config() override;
   void setup() override;
@@ -87,9 +91,11 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_block_internal(int x, int y, int width, int height, Color color) override;
   void setup_pins_();
 
   void display_();
+  void write_region_(int x1, int y1, int x2, int y2);
   void init_lcd_();
   void set_addr_window_(uint16_t x, uint16_t y, uint16_t x2, uint16_t y2);
   void reset_();
@@ -99,15 +105,12 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   int16_t height_{0};  ///< Display height as modified by current rotation
   int16_t offset_x_{0};
   int16_t offset_y_{0};
-  uint16_t x_low_{0};
-  uint16_t y_low_{0};
-  uint16_t x_high_{0};
-  uint16_t y_high_{0};
   const uint8_t *palette_;
 
   ILI9XXXColorMode buffer_color_mode_{BITS_16};
 
   uint32_t get_buffer_length_();
+  size_t get_bytes_per_pixel_() const { return this->buffer_color_mode_ == BITS_16 ? 2 : 1; }
   int get_width_internal() override;
   int get_height_internal() override;
 
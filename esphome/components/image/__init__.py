@@ -50,7 +50,17 @@ IMAGE_TYPE = {
     "RGBA": ImageType.IMAGE_TYPE_RGBA,
 }
 
+ImageCompression = image_ns.enum("ImageCompression")
+IMAGE_COMPRESSION = {
+    "NONE": ImageCompression.IMAGE_COMPRESSION_NONE,
+    "RLE": ImageCompression.IMAGE_COMPRESSION_RLE,
+}
+
 CONF_USE_TRANSPARENCY = "use_transparency"
+CONF_COMPRESSION = "compression"
+
+# Keep in sync with IMAGE_RLE_MAX_FRAMES in image.h
+RLE_MAX_FRAMES = 8
 
 # If the MDI file cannot be downloaded within this time, abort.
 IMAGE_DOWNLOAD_TIMEOUT = 30  # seconds
@@ -257,6 +267,9 @@ IMAGE_SCHEMA = cv.Schema(
             cv.Optional(CONF_DITHER, default="NONE"): cv.one_of(
                 "NONE", "FLOYDSTEINBERG", upper=True
             ),
+            cv.Optional(CONF_COMPRESSION, default="NONE"): cv.enum(
+                IMAGE_COMPRESSION, upper=True
+            ),
             cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
         },
         validate_cross_dependencies,
@@ -266,6 +279,70 @@ IMAGE_SCHEMA = cv.Schema(
 CONFIG_SCHEMA = cv.All(font.validate_pillow_installed, IMAGE_SCHEMA)
 
 
+def split_pixels(data, width, height, image_type):
+    """Split the raw data of an image into one tuple of bytes per pixel.
+
+    Binary pixels become 0 or 1, without the padding of the rows.
+    """
+    if image_type in ["BINARY", "TRANSPARENT_BINARY"]:
+        width8 = ((width + 7) // 8) * 8
+        pixels = []
+        for y in range(height):
+            for x in range(width):
+                pos = x + y * width8
+                pixels.append(((data[pos // 8] >> (7 - pos % 8)) & 1,))
+        return pixels
+    size = len(data) // (width * height)
+    return [tuple(data[pos : pos + size]) for pos in range(0, len(data), size)]
+
+
+def rle_encode(pixels, width, height, previous=None):
+    """Compress the pixels of an image row by row, see IMAGE_COMPRESSION_RLE.
+
+    If the pixels of the previous frame are given, pixels that didn't
+    change are skipped.
+    """
+    data = []
+    literal = []
+
+    def flush_literal():
+        if literal:
+            data.append(len(literal) - 1)
+            for pixel in literal:
+                data.extend(pixel)
+            literal.clear()
+
+    for y in range(height):
+        row = pixels[y * width : (y + 1) * width]
+        prev_row = previous[y * width : (y + 1) * width] if previous else None
+        x = 0
+        while x < width:
+            count = 1
+            if prev_row is not None and row[x] == prev_row[x]:
+                while (
+                    x + count < width
+                    and count < 64
+                    and row[x + count] == prev_row[x + count]
+                ):
+                    count += 1
+                flush_literal()
+                data.append(0x80 | (count - 1))
+            else:
+                while x + count < width and count < 64 and row[x + count] == row[x]:
+                    count += 1
+                if count > 1:
+                    flush_literal()
+                    data.append(0x40 | (count - 1))
+                    data.extend(row[x])
+                else:
+                    literal.append(row[x])
+                    if len(literal) == 64:
+                        flush_literal()
+            x += count
+        flush_literal()
+    return data
+
+
 def load_svg_image(file: bytes, resize: tuple[int, int]):
     # This import is only needed in case of SVG images; adding it
     # to the top would force configurations not using SVG to also have it
@@ -426,9 +503,21 @@ async def to_code(config):
             f"Image f{config[CONF_ID]} has an unsupported type: {config[CONF_TYPE]}."
         )
 
+    compression = config[CONF_COMPRESSION]
+    if compression == "RLE":
+        raw_size = len(data)
+        data = rle_encode(
+            split_pixels(data, width, height, config[CONF_TYPE]), width, height
+        )
+        _LOGGER.debug(
+            "%s compressed from %d to %d bytes", config[CONF_ID], raw_size, len(data)
+        )
+
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
     var = cg.new_Pvariable(
         config[CONF_ID], prog_arr, width, height, IMAGE_TYPE[config[CONF_TYPE]]
     )
     cg.add(var.set_transparency(transparent))
+    if compression != "NONE":
+        cg.add(var.set_compression(IMAGE_COMPRESSION[compression]))
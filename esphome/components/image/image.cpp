@@ -1,11 +1,46 @@
 #include "image.h"
 
+#include <cstring>
+
 #include "esphome/core/hal.h"
 
 namespace esphome {
 namespace image {
 
+/// Apply the packets of one row of RLE data to `row`, and return where the next row starts.
+static const uint8_t *decode_rle_row(const uint8_t *data, uint8_t *row, int width, size_t bytes_per_pixel) {
+  for (int x = 0; x < width;) {
+    uint8_t header = progmem_read_byte(data++);
+    int count = (header & 0x3F) + 1;
+    if (count > width - x)
+      count = width - x;  // corrupt data, but don't write past the row
+    uint8_t *dst = row + x * bytes_per_pixel;
+    switch (header >> 6) {
+      case 0:  // literal
+        for (size_t i = 0; i < count * bytes_per_pixel; i++)
+          dst[i] = progmem_read_byte(data++);
+        break;
+      case 1: {  // run
+        uint8_t pixel[4];
+        for (size_t i = 0; i < bytes_per_pixel; i++)
+          pixel[i] = progmem_read_byte(data++);
+        for (int i = 0; i < count; i++, dst += bytes_per_pixel)
+          memcpy(dst, pixel, bytes_per_pixel);
+        break;
+      }
+      default:  // skip, the pixels of the previous frame stay
+        break;
+    }
+    x += count;
+  }
+  return data;
+}
+
 void Image::draw(int x, int y, display::Display *display, Color color_on, Color color_off) {
+  if (this->compression_ == IMAGE_COMPRESSION_RLE) {
+    this->draw_rle_(x, y, display, color_on, color_off);
+    return;
+  }
   switch (type_) {
     case IMAGE_TYPE_BINARY: {
       for (int img_x = 0; img_x < width_; img_x++) {
@@ -30,6 +65,14 @@ void Image::draw(int x, int y, display::Display *display, Color color_on, Color
       }
       break;
     case IMAGE_TYPE_RGB565:
+#ifndef USE_ESP8266
+      if (!this->transparent_) {
+        // every pixel is drawn, so the display can take them as a block (in its own format, if it matches)
+        display->draw_pixels_at(x, y, this->width_, this->height_, this->data_start_, display::COLOR_ORDER_RGB,
+                                display::COLOR_BITNESS_565, true);
+        break;
+      }
+#endif
       for (int img_x = 0; img_x < width_; img_x++) {
         for (int img_y = 0; img_y < height_; img_y++) {
           auto color = this->get_rgb565_pixel_(img_x, img_y);
@@ -64,6 +107,11 @@ void Image::draw(int x, int y, display::Display *display, Color color_on, Color
 Color Image::get_pixel(int x, int y, Color color_on, Color color_off) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return color_off;
+  if (this->compression_ == IMAGE_COMPRESSION_RLE) {
+    // there is no random access into the compressed data, all rows up to this one have to be decoded
+    const uint8_t *row = this->decode_rle_rows_(y + 1);
+    return this->rle_pixel_color_(row + x * this->rle_bytes_per_pixel_(), color_on, color_off);
+  }
   switch (this->type_) {
     case IMAGE_TYPE_BINARY:
       return this->get_binary_pixel_(x, y) ? color_on : color_off;
@@ -91,8 +139,12 @@ Color Image::get_rgba_pixel_(int x, int y) const {
 }
 Color Image::get_rgb24_pixel_(int x, int y) const {
   const uint32_t pos = (x + y * this->width_) * 3;
-  Color color = Color(progmem_read_byte(this->data_start_ + pos + 0), progmem_read_byte(this->data_start_ + pos + 1),
-                      progmem_read_byte(this->data_start_ + pos + 2));
+  return this->rgb24_color_(progmem_read_byte(this->data_start_ + pos + 0),
+                            progmem_read_byte(this->data_start_ + pos + 1),
+                            progmem_read_byte(this->data_start_ + pos + 2));
+}
+Color Image::rgb24_color_(uint8_t r, uint8_t g, uint8_t b) const {
+  Color color = Color(r, g, b);
   if (color.b == 1 && color.r == 0 && color.g == 0 && transparent_) {
     // (0, 0, 1) has been defined as transparent color for non-alpha images.
     // putting blue == 1 as a first condition for performance reasons (least likely value to short-cut the if)
@@ -104,8 +156,10 @@ Color Image::get_rgb24_pixel_(int x, int y) const {
 }
 Color Image::get_rgb565_pixel_(int x, int y) const {
   const uint32_t pos = (x + y * this->width_) * 2;
-  uint16_t rgb565 =
-      progmem_read_byte(this->data_start_ + pos + 0) << 8 | progmem_read_byte(this->data_start_ + pos + 1);
+  return this->rgb565_color_(progmem_read_byte(this->data_start_ + pos + 0) << 8 |
+                             progmem_read_byte(this->data_start_ + pos + 1));
+}
+Color Image::rgb565_color_(uint16_t rgb565) const {
   auto r = (rgb565 & 0xF800) >> 11;
   auto g = (rgb565 & 0x07E0) >> 5;
   auto b = rgb565 & 0x001F;
@@ -120,10 +174,71 @@ Color Image::get_rgb565_pixel_(int x, int y) const {
 }
 Color Image::get_grayscale_pixel_(int x, int y) const {
   const uint32_t pos = (x + y * this->width_);
-  const uint8_t gray = progmem_read_byte(this->data_start_ + pos);
+  return this->grayscale_color_(progmem_read_byte(this->data_start_ + pos));
+}
+Color Image::grayscale_color_(uint8_t gray) const {
   uint8_t alpha = (gray == 1 && transparent_) ? 0 : 0xFF;
   return Color(gray, gray, gray, alpha);
 }
+Color Image::rle_pixel_color_(const uint8_t *pixel, Color color_on, Color color_off) const {
+  switch (this->type_) {
+    case IMAGE_TYPE_BINARY:
+      return pixel[0] ? color_on : color_off;
+    case IMAGE_TYPE_GRAYSCALE:
+      return this->grayscale_color_(pixel[0]);
+    case IMAGE_TYPE_RGB565:
+      return this->rgb565_color_(encode_uint16(pixel[0], pixel[1]));
+    case IMAGE_TYPE_RGB24:
+      return this->rgb24_color_(pixel[0], pixel[1], pixel[2]);
+    case IMAGE_TYPE_RGBA:
+      return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+    default:
+      return color_off;
+  }
+}
+const uint8_t *Image::decode_rle_rows_(int rows) const {
+  const uint8_t *frames[IMAGE_RLE_MAX_FRAMES];
+  size_t frame_count = this->get_rle_frames_(frames);
+  const size_t bytes_per_pixel = this->rle_bytes_per_pixel_();
+  this->rle_row_.resize(this->width_ * bytes_per_pixel);
+  for (int img_y = 0; img_y < rows; img_y++) {
+    for (size_t i = 0; i < frame_count; i++)
+      frames[i] = decode_rle_row(frames[i], this->rle_row_.data(), this->width_, bytes_per_pixel);
+  }
+  return this->rle_row_.data();
+}
+void Image::draw_rle_(int x, int y, display::Display *display, Color color_on, Color color_off) {
+  const uint8_t *frames[IMAGE_RLE_MAX_FRAMES];
+  size_t frame_count = this->get_rle_frames_(frames);
+  const size_t bytes_per_pixel = this->rle_bytes_per_pixel_();
+  this->rle_row_.resize(this->width_ * bytes_per_pixel);
+  uint8_t *row = this->rle_row_.data();
+
+  for (int img_y = 0; img_y < this->height_; img_y++) {
+    // the key frame first, then each delta on top of it
+    for (size_t i = 0; i < frame_count; i++)
+      frames[i] = decode_rle_row(frames[i], row, this->width_, bytes_per_pixel);
+
+    if (this->type_ == IMAGE_TYPE_RGB565 && !this->transparent_) {
+      // the row is in the format most color displays use for their buffer
+      display->draw_pixels_at(x, y + img_y, this->width_, 1, row, display::COLOR_ORDER_RGB,
+                              display::COLOR_BITNESS_565, true);
+      continue;
+    }
+    // draw every run of equal pixels as one span
+    for (int img_x = 0; img_x < this->width_;) {
+      const uint8_t *pixel = row + img_x * bytes_per_pixel;
+      int end = img_x + 1;
+      while (end < this->width_ && memcmp(pixel, row + end * bytes_per_pixel, bytes_per_pixel) == 0)
+        end++;
+      Color color = this->rle_pixel_color_(pixel, color_on, color_off);
+      bool visible = this->type_ == IMAGE_TYPE_BINARY ? (pixel[0] != 0 || !this->transparent_) : color.w >= 0x80;
+      if (visible)
+        display->fill_span(x + img_x, y + img_y, end - img_x, color);
+      img_x = end;
+    }
+  }
+}
 int Image::get_width() const { return this->width_; }
 int Image::get_height() const { return this->height_; }
 ImageType Image::get_type() const { return this->type_; }
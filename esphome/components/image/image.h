@@ -1,4 +1,5 @@
 #pragma once
+#include <vector>
 #include "esphome/core/color.h"
 #include "esphome/components/display/display_buffer.h"
 
@@ -31,6 +32,18 @@ inline int image_type_to_bpp(ImageType type) {
 
 inline int image_type_to_width_stride(int width, ImageType type) { return (width * image_type_to_bpp(type) + 7u) / 8u; }
 
+enum ImageCompression {
+  IMAGE_COMPRESSION_NONE = 0,
+  /** Each row is a sequence of packets, whose header byte holds the kind in the top two bits and the number of pixels
+   * minus one in the others. A literal (0b00) is followed by that many pixels, a run (0b01) by one pixel that repeats
+   * and a skip (0b10) keeps the pixels of the previous frame. Pixels are stored in whole bytes, binary ones as 0 or 1.
+   */
+  IMAGE_COMPRESSION_RLE = 1,
+};
+
+/// Maximum number of frames (a key frame and the deltas on top of it) that have to be decoded for one frame.
+static const size_t IMAGE_RLE_MAX_FRAMES = 8;
+
 class Image : public display::BaseImage {
  public:
   Image(const uint8_t *data_start, int width, int height, ImageType type);
@@ -44,6 +57,9 @@ class Image : public display::BaseImage {
   void set_transparency(bool transparent) { transparent_ = transparent; }
   bool has_transparency() const { return transparent_; }
 
+  void set_compression(ImageCompression compression) { this->compression_ = compression; }
+  ImageCompression get_compression() const { return this->compression_; }
+
  protected:
   bool get_binary_pixel_(int x, int y) const;
   Color get_rgb24_pixel_(int x, int y) const;
@@ -51,11 +67,31 @@ class Image : public display::BaseImage {
   Color get_rgb565_pixel_(int x, int y) const;
   Color get_grayscale_pixel_(int x, int y) const;
 
+  Color rgb24_color_(uint8_t r, uint8_t g, uint8_t b) const;
+  Color rgb565_color_(uint16_t rgb565) const;
+  Color grayscale_color_(uint8_t gray) const;
+
+  /// Fill `frames` with the RLE data of the frames to decode, a key frame first, and return their number.
+  virtual size_t get_rle_frames_(const uint8_t **frames) const {
+    frames[0] = this->data_start_;
+    return 1;
+  }
+  /// Decode the RLE frames row by row up to row `rows`, and return the buffer holding the last decoded row.
+  const uint8_t *decode_rle_rows_(int rows) const;
+  void draw_rle_(int x, int y, display::Display *display, Color color_on, Color color_off);
+  Color rle_pixel_color_(const uint8_t *pixel, Color color_on, Color color_off) const;
+  size_t rle_bytes_per_pixel_() const {
+    return this->type_ == IMAGE_TYPE_BINARY ? 1 : image_type_to_bpp(this->type_) / 8;
+  }
+
   int width_;
   int height_;
   ImageType type_;
   const uint8_t *data_start_;
   bool transparent_;
+  ImageCompression compression_{IMAGE_COMPRESSION_NONE};
+  /// One decoded row of a compressed image.
+  mutable std::vector<uint8_t> rle_row_;
 };
 
 }  // namespace image
@@ -1,4 +1,6 @@
 #include "json_util.h"
+#include <cmath>
+#include <cstdio>
 #include "esphome/core/log.h"
 
 #ifdef USE_ESP8266
@@ -108,5 +110,88 @@ void parse_json(const std::string &data, const json_parse_t &f) {
   } while (!pass);
 }
 
+void JsonWriter::separator_() {
+  if (this->after_key_) {
+    this->after_key_ = false;
+  } else if (!this->first_) {
+    this->out_ += ',';
+  }
+  this->first_ = false;
+}
+void JsonWriter::begin_(char c) {
+  this->separator_();
+  this->out_ += c;
+  this->first_ = true;
+}
+void JsonWriter::end_(char c) {
+  this->out_ += c;
+  this->first_ = false;
+}
+void JsonWriter::key(const char *key) {
+  this->value(key);
+  this->out_ += ':';
+  this->after_key_ = true;
+}
+void JsonWriter::value(const char *value) {
+  this->separator_();
+  this->out_ += '"';
+  for (const char *c = value; *c != '\0'; c++) {
+    switch (*c) {
+      case '"':
+        this->out_ += "\\\"";
+        break;
+      case '\\':
+        this->out_ += "\\\\";
+        break;
+      case '\n':
+        this->out_ += "\\n";
+        break;
+      case '\r':
+        this->out_ += "\\r";
+        break;
+      case '\t':
+        this->out_ += "\\t";
+        break;
+      default:
+        if (static_cast<uint8_t>(*c) < 0x20) {
+          char buf[7];
+          snprintf(buf, sizeof(buf), "\\u%04x", *c);
+          this->out_ += buf;
+        } else {
+          this->out_ += *c;
+        }
+        break;
+    }
+  }
+  this->out_ += '"';
+}
+void JsonWriter::value(bool value) {
+  this->separator_();
+  this->out_ += value ? "true" : "false";
+}
+void JsonWriter::value(double value) {
+  this->separator_();
+  if (std::isnan(value) || std::isinf(value)) {
+    // like ArduinoJson, as JSON has no representation for these
+    this->out_ += "null";
+    return;
+  }
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%.7g", value);
+  this->out_ += buf;
+}
+void JsonWriter::write_integer_(uint64_t magnitude, bool negative) {
+  this->separator_();
+  char buf[21];
+  char *p = buf + sizeof(buf);
+  do {
+    *--p = '0' + magnitude % 10;
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (negative)
+    *--p = '-';
+  this->out_.append(p, buf + sizeof(buf) - p);
+}
+
 }  // namespace json
 }  // namespace esphome
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <vector>
 
 #include "esphome/core/helpers.h"
@@ -25,5 +27,75 @@ std::string build_json(const json_build_t &f);
 /// Parse a JSON string and run the provided json parse function if it's valid.
 void parse_json(const std::string &data, const json_parse_t &f);
 
+/** Writes JSON straight into a string, without building a document first.
+ *
+ * The output string is cleared but keeps its capacity, so a buffer that is reused for every message stops allocating
+ * once it has grown to the size of the largest message. Keys and values are written in the order they're added, and
+ * the writer takes care of the separators in between.
+ *
+ * @code
+ * json::JsonWriter writer(buffer);
+ * writer.begin_object();
+ * writer.add("id", "sensor-temperature");
+ * writer.add("value", 21.5f);
+ * writer.end_object();
+ * @endcode
+ */
+class JsonWriter {
+ public:
+  explicit JsonWriter(std::string &out) : out_(out) { out.clear(); }
+
+  void begin_object() { this->begin_('{'); }
+  void begin_object(const char *key) {
+    this->key(key);
+    this->begin_object();
+  }
+  void end_object() { this->end_('}'); }
+  void begin_array() { this->begin_('['); }
+  void begin_array(const char *key) {
+    this->key(key);
+    this->begin_array();
+  }
+  void end_array() { this->end_(']'); }
+
+  /// Write the key of the next value in an object.
+  void key(const char *key);
+
+  /// Write a value, either as the next element of an array or after key().
+  void value(const char *value);
+  void value(const std::string &value) { this->value(value.c_str()); }
+  void value(bool value);
+  void value(float value) { this->value(static_cast<double>(value)); }
+  void value(double value);
+  template<typename T, enable_if_t<(std::is_integral<T>::value && std::is_signed<T>::value) || std::is_enum<T>::value,
+                                   int> = 0>
+  void value(T value) {
+    auto signed_value = static_cast<int64_t>(value);
+    this->write_integer_(signed_value < 0 ? -static_cast<uint64_t>(signed_value) : signed_value, signed_value < 0);
+  }
+  template<typename T, enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value, int> = 0>
+  void value(T value) {
+    this->write_integer_(value, false);
+  }
+
+  /// Write a key and its value.
+  template<typename T> void add(const char *key, const T &value) {
+    this->key(key);
+    this->value(value);
+  }
+
+ protected:
+  void begin_(char c);
+  void end_(char c);
+  void separator_();
+  void write_integer_(uint64_t magnitude, bool negative);
+
+  std::string &out_;
+  /// Whether the next key or value is the first in its object or array.
+  bool first_{true};
+  /// Whether a key was just written, so the value doesn't need a separator.
+  bool after_key_{false};
+};
+
 }  // namespace json
 }  // namespace esphome
@@ -1,11 +1,18 @@
 #include "addressable_light.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace light {
 
 static const char *const TAG = "light.addressable";
 
+/// Bulk operations on fewer pixels than this correct every value directly, instead of filling a lookup table first.
+static const int32_t MIN_TABLE_PIXELS = 64;
+
+static_assert(sizeof(Color) == 4, "write_pixels() reads colors as RGBW data");
+
 void AddressableLight::call_setup() {
   this->setup();
 
@@ -23,6 +30,199 @@ void AddressableLight::call_setup() {
 #endif
 }
 
+bool AddressableLight::clamp_range_(int32_t &from, int32_t &to) const {
+  from = std::max<int32_t>(from, 0);
+  to = std::min(to, this->size());
+  return from < to;
+}
+
+void AddressableLight::fill(int32_t from, int32_t to, const Color &color) {
+  if (!this->clamp_range_(from, to))
+    return;
+  ESPPixelBuffer buffer;
+  if (!this->get_pixel_buffer_internal(&buffer)) {
+    for (int32_t i = from; i < to; i++)
+      this->get_view_internal(i).set(color);
+    return;
+  }
+  Color corrected = this->correction_.color_correct(color);
+  uint8_t *pixel = buffer.data + from * buffer.stride;
+  for (int32_t i = from; i < to; i++, pixel += buffer.stride) {
+    for (uint8_t channel = 0; channel < buffer.channels; channel++)
+      pixel[buffer.offsets[channel]] = corrected.raw[channel];
+  }
+}
+
+template<typename F> void AddressableLight::map_channels_(int32_t from, int32_t to, F f) {
+  if (!this->clamp_range_(from, to))
+    return;
+  ESPPixelBuffer buffer;
+  if (!this->get_pixel_buffer_internal(&buffer)) {
+    for (int32_t i = from; i < to; i++) {
+      auto view = this->get_view_internal(i);
+      Color color = view.get();
+      view.set(Color(f(0, color.r), f(1, color.g), f(2, color.b), f(3, color.w)));
+    }
+    return;
+  }
+  for (uint8_t channel = 0; channel < buffer.channels; channel++) {
+    uint8_t *value = buffer.data + from * buffer.stride + buffer.offsets[channel];
+    if (to - from < MIN_TABLE_PIXELS) {
+      for (int32_t i = from; i < to; i++, value += buffer.stride) {
+        uint8_t mapped = f(channel, this->correction_.color_uncorrect_channel(channel, *value));
+        *value = this->correction_.color_correct_channel(channel, mapped);
+      }
+      continue;
+    }
+    uint8_t table[256];
+    for (uint16_t raw = 0; raw < 256; raw++) {
+      uint8_t mapped = f(channel, this->correction_.color_uncorrect_channel(channel, raw));
+      table[raw] = this->correction_.color_correct_channel(channel, mapped);
+    }
+    for (int32_t i = from; i < to; i++, value += buffer.stride)
+      *value = table[*value];
+  }
+}
+
+/// Interpolate from \p from to \p to by \p amnt/255, like Color::gradient() but without floats.
+static inline uint8_t blend_channel(uint8_t from, uint8_t to, uint8_t amnt) {
+  return from + (int32_t(to) - int32_t(from)) * amnt / 255;
+}
+
+void AddressableLight::fade(int32_t from, int32_t to, const Color &target, uint8_t amnt) {
+  // same as Color::gradient()
+  const float amnt_f = float(amnt) / 255.0f;
+  this->map_channels_(from, to, [&](uint8_t channel, uint8_t value) {
+    return uint8_t(amnt_f * (target.raw[channel] - value) + value);
+  });
+}
+
+void AddressableLight::lighten(int32_t from, int32_t to, uint8_t delta) {
+  this->map_channels_(from, to,
+                      [delta](uint8_t channel, uint8_t value) { return uint8_t(std::min(value + delta, 255)); });
+}
+
+void AddressableLight::darken(int32_t from, int32_t to, uint8_t delta) {
+  this->map_channels_(from, to,
+                      [delta](uint8_t channel, uint8_t value) { return uint8_t(std::max(value - delta, 0)); });
+}
+
+void AddressableLight::blend_pixels(int32_t from, const Color *colors, int32_t count, uint8_t amnt) {
+  int32_t to = from + count;
+  if (from < 0)
+    colors -= from;
+  if (!this->clamp_range_(from, to))
+    return;
+  ESPPixelBuffer buffer;
+  if (!this->get_pixel_buffer_internal(&buffer)) {
+    for (int32_t i = from; i < to; i++, colors++) {
+      auto view = this->get_view_internal(i);
+      Color color = view.get();
+      view.set(Color(blend_channel(color.r, colors->r, amnt), blend_channel(color.g, colors->g, amnt),
+                     blend_channel(color.b, colors->b, amnt), blend_channel(color.w, colors->w, amnt)));
+    }
+    return;
+  }
+  for (uint8_t channel = 0; channel < buffer.channels; channel++) {
+    uint8_t *value = buffer.data + from * buffer.stride + buffer.offsets[channel];
+    const Color *color = colors;
+    if (to - from < MIN_TABLE_PIXELS) {
+      for (int32_t i = from; i < to; i++, value += buffer.stride, color++) {
+        uint8_t blended = blend_channel(this->correction_.color_uncorrect_channel(channel, *value),
+                                        color->raw[channel], amnt);
+        *value = this->correction_.color_correct_channel(channel, blended);
+      }
+      continue;
+    }
+    uint8_t uncorrect[256], correct[256];
+    this->correction_.calculate_uncorrect_table(channel, uncorrect);
+    this->correction_.calculate_correct_table(channel, correct);
+    for (int32_t i = from; i < to; i++, value += buffer.stride, color++)
+      *value = correct[blend_channel(uncorrect[*value], color->raw[channel], amnt)];
+  }
+}
+
+/// Get a channel of the pixel at \p pixel in raw pixel data of the given format.
+static inline uint8_t pixel_channel(const uint8_t *pixel, ESPPixelFormat format, uint8_t channel) {
+  switch (format) {
+    case PIXEL_FORMAT_MONO:
+      return pixel[0];
+    case PIXEL_FORMAT_RGBW:
+      return pixel[channel];
+    default:
+      break;
+  }
+  if (channel < 3)
+    return pixel[channel];
+  if (format == PIXEL_FORMAT_RGB_WHITE_AVG)
+    return (pixel[0] + pixel[1] + pixel[2]) / 3;
+  if (format == PIXEL_FORMAT_RGB_WHITE_MIN)
+    return std::min(std::min(pixel[0], pixel[1]), pixel[2]);
+  return 0;
+}
+
+void AddressableLight::write_pixels(int32_t from, const uint8_t *data, int32_t count, ESPPixelFormat format) {
+  const uint8_t pixel_size = format == PIXEL_FORMAT_MONO ? 1 : format == PIXEL_FORMAT_RGBW ? 4 : 3;
+  int32_t to = from + count;
+  if (from < 0)
+    data -= from * pixel_size;
+  if (!this->clamp_range_(from, to))
+    return;
+  ESPPixelBuffer buffer;
+  if (!this->get_pixel_buffer_internal(&buffer)) {
+    for (int32_t i = from; i < to; i++, data += pixel_size) {
+      this->get_view_internal(i).set(Color(pixel_channel(data, format, 0), pixel_channel(data, format, 1),
+                                           pixel_channel(data, format, 2), pixel_channel(data, format, 3)));
+    }
+    return;
+  }
+  for (uint8_t channel = 0; channel < buffer.channels; channel++) {
+    uint8_t *value = buffer.data + from * buffer.stride + buffer.offsets[channel];
+    if (channel == 3 && format != PIXEL_FORMAT_MONO && format != PIXEL_FORMAT_RGBW) {
+      // white is derived from the other channels
+      const uint8_t *pixel = data;
+      for (int32_t i = from; i < to; i++, value += buffer.stride, pixel += pixel_size)
+        *value = this->correction_.color_correct_channel(channel, pixel_channel(pixel, format, channel));
+      continue;
+    }
+    const uint8_t *input = data + (format == PIXEL_FORMAT_MONO ? 0 : channel);
+    if (to - from < MIN_TABLE_PIXELS) {
+      for (int32_t i = from; i < to; i++, value += buffer.stride, input += pixel_size)
+        *value = this->correction_.color_correct_channel(channel, *input);
+      continue;
+    }
+    uint8_t table[256];
+    this->correction_.calculate_correct_table(channel, table);
+    for (int32_t i = from; i < to; i++, value += buffer.stride, input += pixel_size)
+      *value = table[*input];
+  }
+}
+
+void AddressableLight::copy_pixels_(int32_t dst, int32_t src, int32_t count) {
+  if (count <= 0 || dst == src)
+    return;
+  ESPPixelBuffer buffer;
+  if (!this->get_pixel_buffer_internal(&buffer)) {
+    if (dst < src) {
+      for (int32_t i = 0; i < count; i++)
+        this->get_view_internal(dst + i).set(this->get_view_internal(src + i).get());
+    } else {
+      for (int32_t i = count - 1; i >= 0; i--)
+        this->get_view_internal(dst + i).set(this->get_view_internal(src + i).get());
+    }
+    return;
+  }
+  // the pixels are copied raw, which also avoids the rounding of uncorrecting and correcting them again
+  int32_t step = dst < src ? 1 : -1;
+  int32_t start = dst < src ? 0 : count - 1;
+  uint8_t *to = buffer.data + (dst + start) * buffer.stride;
+  const uint8_t *from = buffer.data + (src + start) * buffer.stride;
+  for (int32_t i = 0; i < count; i++, to += step * buffer.stride, from += step * buffer.stride) {
+    for (uint8_t channel = 0; channel < buffer.channels; channel++)
+      to[buffer.offsets[channel]] = from[buffer.offsets[channel]];
+  }
+}
+
 std::unique_ptr<LightTransformer> AddressableLight::create_default_transition() {
   return make_unique<AddressableLightTransformer>(*this);
 }
@@ -44,11 +244,16 @@ void AddressableLight::update_state(LightState *state) {
     return;
 
   // don't use LightState helper, gamma correction+brightness is handled by ESPColorView
-  this->all() = color_from_light_color_values(val);
+  this->fill(0, this->size(), color_from_light_color_values(val));
   this->schedule_show();
 }
 
 void AddressableLightTransformer::start() {
+  this->last_transition_progress_ = 0;
+  this->accumulated_alpha_ = 0;
+  // an effect may be started while the transition is running, so always prepare the fallback.
+  this->lerp_.setup(this->start_values_, this->target_values_);
+
   // don't try to transition over running effects.
   if (this->light_.is_effect_active())
     return;
@@ -62,13 +267,13 @@ void AddressableLightTransformer::start() {
 }
 
 optional<LightColorValues> AddressableLightTransformer::apply() {
-  float smoothed_progress = LightTransitionTransformer::smoothed_progress(this->get_progress_());
+  uint32_t smoothed_progress = LightTransformer::smoothed_progress_fixed_(this->get_progress_fixed_());
 
   // When running an output-buffer modifying effect, don't try to transition individual LEDs, but instead just fade the
   // LightColorValues. write_state() then picks up the change in brightness, and the color change is picked up by the
   // effects which respect it.
   if (this->light_.is_effect_active())
-    return LightColorValues::lerp(this->get_start_values(), this->get_target_values(), smoothed_progress);
+    return this->lerp_.at(smoothed_progress);
 
   // Use a specialized transition for addressable lights: instead of using a unified transition for
   // all LEDs, we use the current state of each LED as the start.
@@ -77,30 +282,28 @@ optional<LightColorValues> AddressableLightTransformer::apply() {
   // state of each LED at the start of the transition.
   // Instead, we "fake" the look of the LERP by using an exponential average over time and using
   // dynamically-calculated alpha values to match the look.
+  uint8_t alpha8 = 255;
+  if (smoothed_progress < TRANSITION_PROGRESS_ONE) {
+    // alpha * 255 in 8.8 fixed-point, this can't overflow as the progress is at most 2^16.
+    uint32_t alpha255 = ((smoothed_progress - this->last_transition_progress_) * 255 << 8) /
+                        (TRANSITION_PROGRESS_ONE - smoothed_progress);
 
-  float denom = (1.0f - smoothed_progress);
-  float alpha = denom == 0.0f ? 1.0f : (smoothed_progress - this->last_transition_progress_) / denom;
-
-  // We need to use a low-resolution alpha here which makes the transition set in only after ~half of the length
-  // We solve this by accumulating the fractional part of the alpha over time.
-  float alpha255 = alpha * 255.0f;
-  float alpha255int = floorf(alpha255);
-  float alpha255remainder = alpha255 - alpha255int;
-
-  this->accumulated_alpha_ += alpha255remainder;
-  float alpha_add = floorf(this->accumulated_alpha_);
-  this->accumulated_alpha_ -= alpha_add;
-
-  alpha255 += alpha_add;
-  alpha255 = clamp(alpha255, 0.0f, 255.0f);
-  auto alpha8 = static_cast<uint8_t>(alpha255);
+    // We need to use a low-resolution alpha here which makes the transition set in only after ~half of the length
+    // We solve this by accumulating the fractional part of the alpha over time.
+    this->accumulated_alpha_ += alpha255 & 0xFF;
+    alpha255 = (alpha255 >> 8) + (this->accumulated_alpha_ >> 8);
+    this->accumulated_alpha_ &= 0xFF;
+    alpha8 = std::min<uint32_t>(alpha255, 255);
+  }
 
   if (alpha8 != 0) {
     uint8_t inv_alpha8 = 255 - alpha8;
     Color add = this->target_color_ * alpha8;
 
-    for (auto led : this->light_)
-      led.set(add + led.get() * inv_alpha8);
+    // led = add + led * inv_alpha8, with saturation
+    this->light_.map_channels_(0, this->light_.size(), [&](uint8_t channel, uint8_t value) {
+      return uint8_t(std::min(add.raw[channel] + esp_scale8(value, inv_alpha8), 255));
+    });
   }
 
   this->last_transition_progress_ = smoothed_progress;
@@ -22,6 +22,27 @@ using ESPColor ESPDEPRECATED("esphome::light::ESPColor is deprecated, use esphom
 /// Convert the color information from a `LightColorValues` object to a `Color` object (does not apply brightness).
 Color color_from_light_color_values(LightColorValues val);
 
+/// Layout of the raw pixel data passed to AddressableLight::write_pixels().
+enum ESPPixelFormat : uint8_t {
+  PIXEL_FORMAT_MONO = 0,       ///< One byte per pixel, which is used for all channels.
+  PIXEL_FORMAT_RGB,            ///< Red, green and blue, white is turned off.
+  PIXEL_FORMAT_RGB_WHITE_AVG,  ///< Red, green and blue, white is set to their average.
+  PIXEL_FORMAT_RGB_WHITE_MIN,  ///< Red, green and blue, white is set to their minimum.
+  PIXEL_FORMAT_RGBW,           ///< Red, green, blue and white.
+};
+
+/// Memory of a light that stores all its pixels in a single buffer, so that bulk operations can skip the views.
+struct ESPPixelBuffer {
+  /// The first pixel.
+  uint8_t *data;
+  /// Distance between two pixels in bytes.
+  uint8_t stride;
+  /// Offsets of the red, green, blue and white channels within a pixel.
+  uint8_t offsets[4];
+  /// 3 for RGB and 4 for RGBW pixels.
+  uint8_t channels;
+};
+
 /// Use a custom state class for addressable lights, to allow type system to discriminate between addressable and
 /// non-addressable lights.
 class AddressableLightState : public LightState {
@@ -49,7 +70,7 @@ class AddressableLight : public LightOutput, public Component {
     }
     if (amnt > this->size())
       amnt = this->size();
-    this->range(0, -amnt) = this->range(amnt, this->size());
+    this->copy_pixels_(0, amnt, this->size() - amnt);
   }
   void shift_right(int32_t amnt) {
     if (amnt < 0) {
@@ -58,8 +79,31 @@ class AddressableLight : public LightOutput, public Component {
     }
     if (amnt > this->size())
       amnt = this->size();
-    this->range(amnt, this->size()) = this->range(0, -amnt);
+    this->copy_pixels_(amnt, 0, this->size() - amnt);
   }
+
+  /* Bulk operations on the pixels in [from, to). They give the same result as going through the views of the pixels,
+   * but lights that store their pixels in one buffer (see get_pixel_buffer_internal()) are written directly, with the
+   * color correction of long ranges looked up from a table per channel.
+   */
+
+  /// Set the pixels in [from, to) to \p color.
+  void fill(int32_t from, int32_t to, const Color &color);
+  /// Fade the pixels in [from, to) towards \p target, by \p amnt/255 of the difference.
+  void fade(int32_t from, int32_t to, const Color &target, uint8_t amnt);
+  /// Add \p delta to all channels of the pixels in [from, to).
+  void lighten(int32_t from, int32_t to, uint8_t delta);
+  /// Subtract \p delta from all channels of the pixels in [from, to).
+  void darken(int32_t from, int32_t to, uint8_t delta);
+  /// Blend \p count colors into the pixels starting at \p from, by \p amnt/255 (255 replaces the pixels).
+  void blend_pixels(int32_t from, const Color *colors, int32_t count, uint8_t amnt);
+  /// Set \p count pixels starting at \p from from raw pixel data in the given format.
+  void write_pixels(int32_t from, const uint8_t *data, int32_t count, ESPPixelFormat format);
+  /// Set \p count pixels starting at \p from to the given colors.
+  void write_pixels(int32_t from, const Color *colors, int32_t count) {
+    this->write_pixels(from, colors->raw, count, PIXEL_FORMAT_RGBW);
+  }
+
   // Indicates whether an effect that directly updates the output buffer is active to prevent overwriting
   bool is_effect_active() const { return this->effect_active_; }
   void set_effect_active(bool effect_active) { this->effect_active_ = effect_active; }
@@ -83,6 +127,7 @@ class AddressableLight : public LightOutput, public Component {
 
  protected:
   friend class AddressableLightTransformer;
+  friend class ESPRangeView;
 
   void mark_shown_() {
 #ifdef USE_POWER_SUPPLY
@@ -96,6 +141,15 @@ class AddressableLight : public LightOutput, public Component {
 #endif
   }
   virtual ESPColorView get_view_internal(int32_t index) const = 0;
+  /// Describe the buffer that holds all pixels in \p buffer, or return false if the pixels aren't stored in one.
+  virtual bool get_pixel_buffer_internal(ESPPixelBuffer *buffer) const { return false; }
+
+  /// Copy \p count pixels from \p src to \p dst, the ranges may overlap.
+  void copy_pixels_(int32_t dst, int32_t src, int32_t count);
+  /// Replace every channel value of the pixels in [from, to) (as uncorrected values) with f(channel, value).
+  template<typename F> void map_channels_(int32_t from, int32_t to, F f);
+  /// Clamp the range [from, to) to the pixels of the light, returns false if it's empty.
+  bool clamp_range_(int32_t &from, int32_t &to) const;
 
   bool effect_active_{false};
   ESPColorCorrection correction_{};
@@ -115,8 +169,9 @@ class AddressableLightTransformer : public LightTransitionTransformer {
  protected:
   AddressableLight &light_;
   Color target_color_{};
-  float last_transition_progress_{0.0f};
-  float accumulated_alpha_{0.0f};
+  uint32_t last_transition_progress_{0};
+  /// Fractional part of the alpha that hasn't been applied yet, in 1/256ths.
+  uint32_t accumulated_alpha_{0};
 };
 
 }  // namespace light
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -81,10 +82,16 @@ class AddressableRainbowLightEffect : public AddressableLightEffect {
     hsv.saturation = 240;
     uint16_t hue = (millis() * this->speed_) % 0xFFFF;
     const uint16_t add = 0xFFFF / this->width_;
-    for (auto var : it) {
-      hsv.hue = hue >> 8;
-      var = hsv;
-      hue += add;
+    // compute the colors in chunks, which are written to the light at once
+    Color colors[32];
+    for (int32_t i = 0; i < it.size(); i += 32) {
+      const int32_t count = std::min<int32_t>(32, it.size() - i);
+      for (int32_t j = 0; j < count; j++) {
+        hsv.hue = hue >> 8;
+        colors[j] = hsv.to_rgb();
+        hue += add;
+      }
+      it.write_pixels(i, colors, count);
     }
     it.schedule_show();
   }
@@ -175,10 +182,8 @@ class AddressableScanEffect : public AddressableLightEffect {
     }
     this->last_move_ = now;
 
-    it.all() = Color::BLACK;
-    for (uint32_t i = 0; i < this->scan_width_; i++) {
-      it[this->at_led_ + i] = current_color;
-    }
+    it.fill(0, it.size(), Color::BLACK);
+    it.fill(this->at_led_, this->at_led_ + this->scan_width_, current_color);
 
     it.schedule_show();
   }
@@ -285,7 +290,7 @@ class AddressableFireworksEffect : public AddressableLightEffect {
   explicit AddressableFireworksEffect(const std::string &name) : AddressableLightEffect(name) {}
   void start() override {
     auto &it = *this->get_addressable_();
-    it.all() = Color::BLACK;
+    it.fill(0, it.size(), Color::BLACK);
   }
   void apply(AddressableLight &it, const Color &current_color) override {
     const uint32_t now = millis();
@@ -23,5 +23,15 @@ void ESPColorCorrection::calculate_gamma_table(float gamma) {
   }
 }
 
+void ESPColorCorrection::calculate_correct_table(uint8_t channel, uint8_t *table) const {
+  for (uint16_t i = 0; i < 256; i++)
+    table[i] = this->color_correct_channel(channel, i);
+}
+
+void ESPColorCorrection::calculate_uncorrect_table(uint8_t channel, uint8_t *table) const {
+  for (uint16_t i = 0; i < 256; i++)
+    table[i] = this->color_uncorrect_channel(channel, i);
+}
+
 }  // namespace light
 }  // namespace esphome
@@ -32,6 +32,13 @@ class ESPColorCorrection {
     uint8_t res = esp_scale8(esp_scale8(white, this->max_brightness_.white), this->local_brightness_);
     return this->gamma_table_[res];
   }
+  /// Correct a single channel, 0 to 3 for red, green, blue and white.
+  inline uint8_t color_correct_channel(uint8_t channel, uint8_t value) const ALWAYS_INLINE {
+    uint8_t res = esp_scale8(esp_scale8(value, this->max_brightness_.raw[channel]), this->local_brightness_);
+    return this->gamma_table_[res];
+  }
+  /// Fill \p table with the corrected values of all 256 values of a channel, to correct many pixels at once.
+  void calculate_correct_table(uint8_t channel, uint8_t *table) const;
   inline Color color_uncorrect(Color color) const ALWAYS_INLINE {
     // uncorrected = corrected^(1/gamma) / (max_brightness * local_brightness)
     return Color(this->color_uncorrect_red(color.red), this->color_uncorrect_green(color.green),
@@ -65,6 +72,15 @@ class ESPColorCorrection {
     uint8_t res = ((uncorrected / this->max_brightness_.white) * 255UL) / this->local_brightness_;
     return res;
   }
+  inline uint8_t color_uncorrect_channel(uint8_t channel, uint8_t value) const ALWAYS_INLINE {
+    if (this->max_brightness_.raw[channel] == 0 || this->local_brightness_ == 0)
+      return 0;
+    uint16_t uncorrected = this->gamma_reverse_table_[value] * 255UL;
+    uint8_t res = ((uncorrected / this->max_brightness_.raw[channel]) * 255UL) / this->local_brightness_;
+    return res;
+  }
+  /// Fill \p table with the uncorrected values of all 256 values of a channel.
+  void calculate_uncorrect_table(uint8_t channel, uint8_t *table) const;
 
  protected:
   uint8_t gamma_table_[256];
@@ -17,11 +17,7 @@ ESPColorView ESPRangeView::operator[](int32_t index) const {
 ESPRangeIterator ESPRangeView::begin() { return {*this, this->begin_}; }
 ESPRangeIterator ESPRangeView::end() { return {*this, this->end_}; }
 
-void ESPRangeView::set(const Color &color) {
-  for (int32_t i = this->begin_; i < this->end_; i++) {
-    (*this->parent_)[i] = color;
-  }
-}
+void ESPRangeView::set(const Color &color) { this->parent_->fill(this->begin_, this->end_, color); }
 
 void ESPRangeView::set_red(uint8_t red) {
   for (auto c : *this)
@@ -44,22 +40,10 @@ void ESPRangeView::set_effect_data(uint8_t effect_data) {
     c.set_effect_data(effect_data);
 }
 
-void ESPRangeView::fade_to_white(uint8_t amnt) {
-  for (auto c : *this)
-    c.fade_to_white(amnt);
-}
-void ESPRangeView::fade_to_black(uint8_t amnt) {
-  for (auto c : *this)
-    c.fade_to_black(amnt);
-}
-void ESPRangeView::lighten(uint8_t delta) {
-  for (auto c : *this)
-    c.lighten(delta);
-}
-void ESPRangeView::darken(uint8_t delta) {
-  for (auto c : *this)
-    c.darken(delta);
-}
+void ESPRangeView::fade_to_white(uint8_t amnt) { this->parent_->fade(this->begin_, this->end_, Color::WHITE, amnt); }
+void ESPRangeView::fade_to_black(uint8_t amnt) { this->parent_->fade(this->begin_, this->end_, Color::BLACK, amnt); }
+void ESPRangeView::lighten(uint8_t delta) { this->parent_->lighten(this->begin_, this->end_, delta); }
+void ESPRangeView::darken(uint8_t delta) { this->parent_->darken(this->begin_, this->end_, delta); }
 ESPRangeView &ESPRangeView::operator=(const ESPRangeView &rhs) {  // NOLINT
   // If size doesn't match, error (todo warning)
   if (rhs.size() != this->size())
@@ -71,22 +55,7 @@ ESPRangeView &ESPRangeView::operator=(const ESPRangeView &rhs) {  // NOLINT
     return *this;
   }
 
-  // If both equal, already done
-  if (rhs.begin_ == this->begin_)
-    return *this;
-
-  if (rhs.begin_ > this->begin_) {
-    // Copy from left
-    for (int32_t i = 0; i < this->size(); i++) {
-      (*this)[i].set(rhs[i].get());
-    }
-  } else {
-    // Copy from right
-    for (int32_t i = this->size() - 1; i >= 0; i--) {
-      (*this)[i].set(rhs[i].get());
-    }
-  }
-
+  this->parent_->copy_pixels_(this->begin_, rhs.begin_, this->size());
   return *this;
 }
 
@@ -277,6 +277,8 @@ class LightColorValues {
   void set_warm_white(float warm_white) { this->warm_white_ = clamp(warm_white, 0.0f, 1.0f); }
 
  protected:
+  friend class LightColorValuesLerp;
+
   ColorMode color_mode_;
   float state_;  ///< ON / OFF, float for transition
   float brightness_;
@@ -15,10 +15,13 @@ class LightJSONSchema {
  public:
   /// Dump the state of a light as JSON.
   static void dump_json(LightState &state, JsonObject root);
+  /// Write the state of a light as JSON, into an object that was started on \p writer.
+  static void dump_json(LightState &state, json::JsonWriter &writer);
   /// Parse the JSON state of a light to a LightCall.
   static void parse_json(LightState &state, LightCall &call, JsonObject root);
 
  protected:
+  static const char *color_mode_to_json(ColorMode color_mode);
   static void parse_color_json(LightState &state, LightCall &call, JsonObject root);
 };
 
@@ -239,7 +239,9 @@ void LightState::stop_effect_() {
 }
 
 void LightState::start_transition_(const LightColorValues &target, uint32_t length, bool set_remote_values) {
-  this->transformer_ = this->output_->create_default_transition();
+  if (this->transition_ == nullptr)
+    this->transition_ = this->output_->create_default_transition();
+  this->transformer_ = this->transition_.get();
   this->transformer_->setup(this->current_values, target, length);
 
   if (set_remote_values) {
@@ -254,7 +256,9 @@ void LightState::start_flash_(const LightColorValues &target, uint32_t length, b
   if (this->transformer_ != nullptr)
     end_colors = this->transformer_->get_start_values();
 
-  this->transformer_ = make_unique<LightFlashTransformer>(*this);
+  if (this->flash_ == nullptr)
+    this->flash_ = make_unique<LightFlashTransformer>(*this);
+  this->transformer_ = this->flash_.get();
   this->transformer_->setup(end_colors, target, length);
 
   if (set_remote_values) {
@@ -171,8 +171,11 @@ class LightState : public EntityBase, public Component {
   LightOutput *output_;
   /// Value for storing the index of the currently active effect. 0 if no effect is active
   uint32_t active_effect_index_{};
-  /// The currently active transformer for this light (transition/flash).
-  std::unique_ptr<LightTransformer> transformer_{nullptr};
+  /// The currently active transformer for this light (transition/flash), one of the two below.
+  LightTransformer *transformer_{nullptr};
+  /// The transformers are kept after they finish, so that they can be reused instead of allocating new ones.
+  std::unique_ptr<LightTransformer> transition_{nullptr};
+  std::unique_ptr<LightTransformer> flash_{nullptr};
   /// Whether the light value should be written in the next cycle.
   bool next_write_{true};
 
@@ -0,0 +1,61 @@
+#include "light_transformer.h"
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace light {
+
+// 6x^5 - 15x^4 + 10x^3 sampled at 65 points in 16.16 fixed-point, see LightTransitionTransformer::smoothed_progress().
+static const uint32_t SMOOTHED_PROGRESS_TABLE[65] PROGMEM = {
+    0,     2,     19,    63,    145,   277,   467,   723,   1052,  1460,  1951,  2529,  3196,  3955,  4806,  5749,
+    6784,  7909,  9121,  10418, 11797, 13253, 14781, 16378, 18036, 19751, 21515, 23323, 25168, 27042, 28938, 30849,
+    32768, 34687, 36598, 38494, 40368, 42213, 44021, 45785, 47500, 49158, 50755, 52283, 53739, 55118, 56415, 57627,
+    58752, 59787, 60730, 61581, 62340, 63007, 63585, 64076, 64484, 64813, 65069, 65259, 65391, 65473, 65517, 65534,
+    65536,
+};
+
+uint32_t LightTransformer::smoothed_progress_fixed_(uint32_t x) {
+  if (x >= TRANSITION_PROGRESS_ONE)
+    return TRANSITION_PROGRESS_ONE;
+  // linear interpolation between the table entries is accurate to better than 2e-4
+  uint32_t index = x >> 10;
+  uint32_t frac = x & 0x3FF;
+  uint32_t a = SMOOTHED_PROGRESS_TABLE[index];
+  uint32_t b = SMOOTHED_PROGRESS_TABLE[index + 1];
+  return a + (((b - a) * frac) >> 10);
+}
+
+float LightColorValues::*const LightColorValuesLerp::ATTRIBUTES[NUM_ATTRIBUTES] = {
+    &LightColorValues::state_,      &LightColorValues::brightness_, &LightColorValues::color_brightness_,
+    &LightColorValues::red_,        &LightColorValues::green_,      &LightColorValues::blue_,
+    &LightColorValues::white_,      &LightColorValues::color_temperature_,
+    &LightColorValues::cold_white_, &LightColorValues::warm_white_,
+};
+
+void LightColorValuesLerp::setup(const LightColorValues &start, const LightColorValues &end) {
+  this->start_ = start;
+  this->start_.color_mode_ = end.color_mode_;
+  this->end_ = end;
+  for (uint8_t i = 0; i < NUM_ATTRIBUTES; i++) {
+    this->from_[i] = lroundf(start.*ATTRIBUTES[i] * 65536.0f);
+    this->delta_[i] = lroundf(end.*ATTRIBUTES[i] * 65536.0f) - this->from_[i];
+  }
+}
+
+LightColorValues LightColorValuesLerp::at(uint32_t completion) const {
+  if (completion >= TRANSITION_PROGRESS_ONE)
+    return this->end_;
+  LightColorValues v = this->start_;
+  if (completion == 0)
+    return v;
+  // the interpolated values lie between the start and end values, so they don't need to be clamped again
+  for (uint8_t i = 0; i < NUM_ATTRIBUTES; i++) {
+    if (this->delta_[i] == 0)
+      continue;
+    int32_t value = this->from_[i] + static_cast<int32_t>((static_cast<int64_t>(this->delta_[i]) * completion) >> 16);
+    v.*ATTRIBUTES[i] = value * (1.0f / 65536.0f);
+  }
+  return v;
+}
+
+}  // namespace light
+}  // namespace esphome
@@ -7,6 +7,35 @@
 namespace esphome {
 namespace light {
 
+/// Fixed-point transition progress that represents the end of a transition, the start is 0.
+static const uint32_t TRANSITION_PROGRESS_ONE = 1 << 16;
+
+/** Linear interpolation between two LightColorValues in fixed-point.
+ *
+ * The start value and the difference of every attribute are computed once per transition, so that every step only
+ * costs an integer multiply for each attribute that actually changes. This keeps transitions cheap on chips without an
+ * FPU, like the ESP8266.
+ */
+class LightColorValuesLerp {
+ public:
+  /// Prepare the interpolation from \p start to \p end.
+  void setup(const LightColorValues &start, const LightColorValues &end);
+
+  /// The interpolated values at \p completion, from 0 (start) to TRANSITION_PROGRESS_ONE (end).
+  LightColorValues at(uint32_t completion) const;
+
+ protected:
+  static const uint8_t NUM_ATTRIBUTES = 10;
+  static float LightColorValues::*const ATTRIBUTES[NUM_ATTRIBUTES];
+
+  /// The start values, but with the color mode of the end values.
+  LightColorValues start_{};
+  LightColorValues end_{};
+  /// Start value and difference of every attribute, in 16.16 fixed-point.
+  int32_t from_[NUM_ATTRIBUTES]{};
+  int32_t delta_[NUM_ATTRIBUTES]{};
+};
+
 /// Base class for all light color transformers, such as transitions or flashes.
 class LightTransformer {
  public:
@@ -21,7 +50,7 @@ class LightTransformer {
   }
 
   /// Indicates whether this transformation is finished.
-  virtual bool is_finished() { return this->get_progress_() >= 1.0f; }
+  virtual bool is_finished() { return millis() - this->start_time_ >= this->length_; }
 
   /// This will be called before the transition is started.
   virtual void start() {}
@@ -49,6 +78,19 @@ class LightTransformer {
     return clamp((now - this->start_time_) / float(this->length_), 0.0f, 1.0f);
   }
 
+  /// The progress of this transition in fixed-point, from 0 to TRANSITION_PROGRESS_ONE.
+  uint32_t get_progress_fixed_() {
+    uint32_t elapsed = esphome::millis() - this->start_time_;
+    if (elapsed >= this->length_)
+      return TRANSITION_PROGRESS_ONE;
+    if (elapsed < (1 << 16))
+      return (elapsed << 16) / this->length_;
+    return static_cast<uint32_t>((static_cast<uint64_t>(elapsed) << 16) / this->length_);
+  }
+
+  /// Smooth fixed-point progress \p x with the same sigmoid-like curve as LightTransitionTransformer, using a table.
+  static uint32_t smoothed_progress_fixed_(uint32_t x);
+
   uint32_t start_time_;
   uint32_t length_;
   LightColorValues start_values_;
@@ -28,30 +28,31 @@ class LightTransitionTransformer : public LightTransformer {
     }
 
     // When changing color mode, go through off state, as color modes are orthogonal and there can't be two active.
-    if (this->start_values_.get_color_mode() != this->target_values_.get_color_mode()) {
-      this->changing_color_mode_ = true;
+    this->changing_color_mode_ = this->start_values_.get_color_mode() != this->target_values_.get_color_mode();
+    if (this->changing_color_mode_) {
       this->intermediate_values_ = this->start_values_;
       this->intermediate_values_.set_state(false);
+      this->lerp_.setup(this->start_values_, this->intermediate_values_);
+    } else {
+      this->lerp_.setup(this->start_values_, this->end_values_);
     }
   }
 
   optional<LightColorValues> apply() override {
-    float p = this->get_progress_();
-
-    // Halfway through, when intermediate state (off) is reached, flip it to the target, but remain off.
-    if (this->changing_color_mode_ && p > 0.5f &&
-        this->intermediate_values_.get_color_mode() != this->target_values_.get_color_mode()) {
-      this->intermediate_values_ = this->target_values_;
-      this->intermediate_values_.set_state(false);
+    uint32_t p = this->get_progress_fixed_();
+
+    if (this->changing_color_mode_) {
+      const uint32_t half = TRANSITION_PROGRESS_ONE / 2;
+      // Halfway through, when intermediate state (off) is reached, flip it to the target, but remain off.
+      if (p > half && this->intermediate_values_.get_color_mode() != this->target_values_.get_color_mode()) {
+        this->intermediate_values_ = this->target_values_;
+        this->intermediate_values_.set_state(false);
+        this->lerp_.setup(this->intermediate_values_, this->end_values_);
+      }
+      p = p <= half ? p * 2 : (p - half) * 2;
     }
 
-    LightColorValues &start = this->changing_color_mode_ && p > 0.5f ? this->intermediate_values_ : this->start_values_;
-    LightColorValues &end = this->changing_color_mode_ && p < 0.5f ? this->intermediate_values_ : this->end_values_;
-    if (this->changing_color_mode_)
-      p = p < 0.5f ? p * 2 : (p - 0.5) * 2;
-
-    float v = LightTransitionTransformer::smoothed_progress(p);
-    return LightColorValues::lerp(start, end, v);
+    return this->lerp_.at(LightTransformer::smoothed_progress_fixed_(p));
   }
 
  protected:
@@ -62,6 +63,8 @@ class LightTransitionTransformer : public LightTransformer {
   bool changing_color_mode_{false};
   LightColorValues end_values_{};
   LightColorValues intermediate_values_{};
+  /// Interpolation of the current half of the transition (the whole transition if the color mode doesn't change).
+  LightColorValuesLerp lerp_{};
 };
 
 class LightFlashTransformer : public LightTransformer {
@@ -76,7 +79,9 @@ class LightFlashTransformer : public LightTransformer {
     this->begun_lightstate_restore_ = false;
 
     // first transition to original target
-    this->transformer_ = this->state_.get_output()->create_default_transition();
+    if (this->transition_ == nullptr)
+      this->transition_ = this->state_.get_output()->create_default_transition();
+    this->transformer_ = this->transition_.get();
     this->transformer_->setup(this->state_.current_values, this->target_values_, this->transition_length_);
   }
 
@@ -85,7 +90,7 @@ class LightFlashTransformer : public LightTransformer {
 
     if (this->transformer_ == nullptr && millis() > this->start_time_ + this->length_ - this->transition_length_) {
       // second transition back to start value
-      this->transformer_ = this->state_.get_output()->create_default_transition();
+      this->transformer_ = this->transition_.get();
       this->transformer_->setup(this->state_.current_values, this->get_start_values(), this->transition_length_);
       this->begun_lightstate_restore_ = true;
     }
@@ -118,7 +123,9 @@ class LightFlashTransformer : public LightTransformer {
  protected:
   LightState &state_;
   uint32_t transition_length_;
-  std::unique_ptr<LightTransformer> transformer_{nullptr};
+  /// The running transition (if any), the transition object itself is reused for every transition.
+  LightTransformer *transformer_{nullptr};
+  std::unique_ptr<LightTransformer> transition_{nullptr};
   bool begun_lightstate_restore_;
 };
 
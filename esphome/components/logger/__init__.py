@@ -22,6 +22,7 @@ from esphome.const import (
     PLATFORM_ESP32,
     PLATFORM_ESP8266,
     PLATFORM_RP2040,
+    PLATFORM_HOST,
 )
 from esphome.core import CORE, EsphomeError, Lambda, coroutine_with_priority
 from esphome.components.esp32 import add_idf_sdkconfig_option, get_esp32_variant
@@ -160,6 +161,7 @@ LoggerMessageTrigger = logger_ns.class_(
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_ASYNC_QUEUE_SIZE = "async_queue_size"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -205,6 +207,10 @@ CONFIG_SCHEMA = cv.All(
             cv.SplitDefault(
                 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH, esp8266=True
             ): cv.All(cv.only_on_esp8266, cv.boolean),
+            cv.Optional(CONF_ASYNC_QUEUE_SIZE): cv.All(
+                cv.only_on([PLATFORM_ESP32, PLATFORM_HOST]),
+                cv.int_range(min=2, max=256),
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     validate_local_no_higher_than_global,
@@ -221,6 +227,9 @@ async def to_code(config):
                 HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]]
             )
         )
+    if CONF_ASYNC_QUEUE_SIZE in config:
+        cg.add_define("USE_LOGGER_ASYNC")
+        cg.add(log.set_async_queue_size(config[CONF_ASYNC_QUEUE_SIZE]))
     cg.add(log.pre_setup())
 
     for tag, level in config[CONF_LOGS].items():
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_ASYNC
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace logger {
+
+/** Lock-free queue of log messages, which can be written by any task and is read by the main loop.
+ *
+ * Producers claim a slot with a compare-and-swap on the write position and format the message straight into it, the
+ * slot's sequence number then publishes it to the consumer. The queue never blocks: if all slots are in use, pushing
+ * fails and it's up to the caller to drop the message.
+ */
+class LogQueue {
+ public:
+  struct Entry {
+    std::atomic<uint32_t> sequence;
+    uint8_t level;
+    uint16_t line;
+    const char *tag;
+    uint32_t timestamp;
+    uint16_t length;
+    char *message;
+  };
+
+  /// Create a queue of \p count (rounded up to a power of two) messages of at most \p message_size characters each.
+  LogQueue(size_t count, size_t message_size) : message_size_(message_size) {
+    size_t size = 1;
+    while (size < count)
+      size <<= 1;
+    this->mask_ = size - 1;
+    this->entries_ = new Entry[size];                       // NOLINT(cppcoreguidelines-owning-memory)
+    this->messages_ = new char[size * (message_size + 1)];  // NOLINT(cppcoreguidelines-owning-memory)
+    for (size_t i = 0; i < size; i++) {
+      this->entries_[i].sequence.store(i, std::memory_order_relaxed);
+      this->entries_[i].message = this->messages_ + i * (message_size + 1);
+    }
+  }
+
+  /// Format a message into the queue. Safe to call from any task, returns false if the queue is full.
+  bool push(int level, const char *tag, int line, const char *format, va_list args) {
+    uint32_t pos = this->write_pos_.load(std::memory_order_relaxed);
+    Entry *entry;
+    while (true) {
+      entry = &this->entries_[pos & this->mask_];
+      uint32_t sequence = entry->sequence.load(std::memory_order_acquire);
+      int32_t diff = static_cast<int32_t>(sequence - pos);
+      if (diff == 0) {
+        if (this->write_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        // the consumer hasn't caught up with this slot yet
+        return false;
+      } else {
+        pos = this->write_pos_.load(std::memory_order_relaxed);
+      }
+    }
+
+    entry->level = level;
+    entry->line = line;
+    entry->tag = tag;
+    entry->timestamp = millis();
+    int ret = vsnprintf(entry->message, this->message_size_ + 1, format, args);
+    if (ret < 0) {
+      ret = 0;
+    } else if (static_cast<size_t>(ret) > this->message_size_) {
+      // output was too long, truncated
+      ret = this->message_size_;
+    }
+    entry->length = ret;
+    entry->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// The oldest message in the queue, or nullptr if it's empty. Only to be called from the main loop.
+  Entry *front() {
+    Entry *entry = &this->entries_[this->read_pos_ & this->mask_];
+    if (entry->sequence.load(std::memory_order_acquire) != this->read_pos_ + 1)
+      return nullptr;
+    return entry;
+  }
+  /// Release the message returned by front().
+  void pop() {
+    Entry *entry = &this->entries_[this->read_pos_ & this->mask_];
+    entry->sequence.store(this->read_pos_ + this->mask_ + 1, std::memory_order_release);
+    this->read_pos_++;
+  }
+
+  /// Count a message that was dropped because the queue was full.
+  void add_dropped() { this->dropped_.fetch_add(1, std::memory_order_relaxed); }
+  /// Total number of messages dropped because the queue was full.
+  uint32_t get_dropped() const { return this->dropped_.load(std::memory_order_relaxed); }
+
+ protected:
+  Entry *entries_;
+  char *messages_;
+  size_t message_size_;
+  uint32_t mask_;
+  std::atomic<uint32_t> write_pos_{0};
+  uint32_t read_pos_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_ASYNC
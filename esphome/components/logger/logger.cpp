@@ -25,6 +25,9 @@
 #endif  // USE_ESP32_FRAMEWORK_ARDUINO || USE_ESP_IDF
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
+#ifdef USE_LOGGER_ASYNC
+#include "esphome/core/application.h"
+#endif
 
 namespace esphome {
 namespace logger {
@@ -61,10 +64,35 @@ void Logger::write_header_(int level, const char *tag, int line) {
   const char *color = LOG_LEVEL_COLORS[level];
   const char *letter = LOG_LEVEL_LETTERS[level];
   this->printf_to_buffer_("%s[%s][%s:%03u]: ", color, letter, tag, line);
+  this->current_line_ = line;
+  this->current_timestamp_ = millis();
+  this->message_start_ = this->tx_buffer_at_;
 }
 
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag))
+    return;
+#ifdef USE_LOGGER_ASYNC
+  if (this->async_queue_ != nullptr) {
+    // Messages logged by the callbacks while the queue is drained are dropped like without the queue, otherwise a
+    // callback that logs would keep feeding the queue it's being called from.
+    if (recursion_guard_ && this->is_main_task_())
+      return;
+    // The arguments are formatted right away, as strings passed to %s often don't outlive the call. Writing the
+    // message out and calling the callbacks is deferred to the main loop.
+    if (this->async_queue_->push(level, tag, line, format, args)) {
+      App.wake_loop_any_context();
+      return;
+    }
+    // when the main loop itself fills up the queue (e.g. during setup), it empties it instead of dropping messages
+    if (!this->is_main_task_()) {
+      this->async_queue_->add_dropped();
+      return;
+    }
+    this->process_queue_();
+  }
+#endif
+  if (recursion_guard_)
     return;
 
   recursion_guard_ = true;
@@ -218,6 +246,53 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
   this->log_callback_.call(level, tag, msg);
 }
 
+#ifdef USE_LOGGER_ASYNC
+bool Logger::is_main_task_() const {
+#ifdef USE_ESP32
+  return xTaskGetCurrentTaskHandle() == this->main_task_;
+#endif
+#ifdef USE_HOST
+  return pthread_equal(pthread_self(), this->main_task_);
+#endif
+}
+void Logger::process_queue_() {
+  this->recursion_guard_ = true;
+  LogQueue::Entry *entry;
+  while ((entry = this->async_queue_->front()) != nullptr) {
+    this->reset_buffer_();
+    this->write_header_(entry->level, entry->tag, entry->line);
+    this->current_timestamp_ = entry->timestamp;
+    this->write_to_buffer_(entry->message, entry->length);
+    this->write_footer_();
+    int level = entry->level;
+    const char *tag = entry->tag;
+    // release the slot before the (slow) output, so other tasks can queue new messages
+    this->async_queue_->pop();
+    this->log_message_(level, tag);
+  }
+
+  uint32_t dropped = this->async_queue_->get_dropped();
+  if (dropped != this->reported_dropped_) {
+    this->reset_buffer_();
+    this->write_header_(ESPHOME_LOG_LEVEL_WARN, TAG, __LINE__);
+    this->printf_to_buffer_("%" PRIu32 " log messages dropped, the queue was full", dropped - this->reported_dropped_);
+    this->write_footer_();
+    this->log_message_(ESPHOME_LOG_LEVEL_WARN, TAG);
+    this->reported_dropped_ = dropped;
+  }
+  this->recursion_guard_ = false;
+}
+void Logger::loop() {
+  if (this->async_queue_ != nullptr)
+    this->process_queue_();
+}
+uint32_t Logger::get_dropped_messages() const {
+  if (this->async_queue_ == nullptr)
+    return 0;
+  return this->async_queue_->get_dropped();
+}
+#endif
+
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size) {
   // add 1 to buffer size for null terminator
   this->tx_buffer_ = new char[this->tx_buffer_size_ + 1];  // NOLINT
@@ -345,6 +420,17 @@ void Logger::pre_setup() {
 #endif  // USE_ESP8266
 
   global_logger = this;
+#ifdef USE_LOGGER_ASYNC
+  if (this->async_queue_size_ > 0) {
+#ifdef USE_ESP32
+    this->main_task_ = xTaskGetCurrentTaskHandle();
+#endif
+#ifdef USE_HOST
+    this->main_task_ = pthread_self();
+#endif
+    this->async_queue_ = new LogQueue(this->async_queue_size_, this->tx_buffer_size_);  // NOLINT
+  }
+#endif
 #if defined(USE_ESP_IDF) || defined(USE_ESP32_FRAMEWORK_ARDUINO)
   esp_log_set_vprintf(esp_idf_log_vprintf_);
   if (ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE) {
@@ -450,8 +536,17 @@ void Logger::dump_config() {
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
   }
+#ifdef USE_LOGGER_ASYNC
+  if (this->async_queue_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Async Queue Size: %zu", this->async_queue_size_);
+    ESP_LOGCONFIG(TAG, "  Dropped Messages: %" PRIu32, this->get_dropped_messages());
+  }
+#endif
+}
+void Logger::write_footer_() {
+  this->message_end_ = this->tx_buffer_at_;
+  this->write_to_buffer_(ESPHOME_LOG_RESET_COLOR, strlen(ESPHOME_LOG_RESET_COLOR));
 }
-void Logger::write_footer_() { this->write_to_buffer_(ESPHOME_LOG_RESET_COLOR, strlen(ESPHOME_LOG_RESET_COLOR)); }
 
 Logger *global_logger = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
@@ -6,6 +6,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
+#include "log_queue.h"
 
 #ifdef USE_ARDUINO
 #if defined(USE_ESP8266) || defined(USE_ESP32)
@@ -21,6 +22,14 @@
 #include <driver/uart.h>
 #endif  // USE_ESP_IDF
 
+#if defined(USE_LOGGER_ASYNC) && defined(USE_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+#if defined(USE_LOGGER_ASYNC) && defined(USE_HOST)
+#include <pthread.h>
+#endif
+
 namespace esphome {
 
 namespace logger {
@@ -64,6 +73,16 @@ enum UARTSelection {
 };
 #endif  // USE_ESP32 || USE_ESP8266 || USE_RP2040 || USE_LIBRETINY
 
+/// Parts of the log message that's currently being processed, for log callbacks that don't need the formatted line.
+struct LogRecord {
+  int line;
+  /// millis() when the message was logged.
+  uint32_t timestamp;
+  /// The message without header and color codes, not null-terminated.
+  const char *message;
+  size_t message_length;
+};
+
 class Logger : public Component {
  public:
   explicit Logger(uint32_t baud_rate, size_t tx_buffer_size);
@@ -86,6 +105,17 @@ class Logger : public Component {
   /// Set the log level of the specified tag.
   void set_log_level(const std::string &tag, int log_level);
 
+#ifdef USE_LOGGER_ASYNC
+  /** Queue up to \p size messages and write them out from the main loop, instead of in the calling task.
+   *
+   * Must be called before pre_setup().
+   */
+  void set_async_queue_size(size_t size) { this->async_queue_size_ = size; }
+  /// Number of messages dropped because the queue was full.
+  uint32_t get_dropped_messages() const;
+  void loop() override;
+#endif
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Set up this component.
@@ -96,6 +126,11 @@ class Logger : public Component {
 
   /// Register a callback that will be called for every log message sent
   void add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback);
+  /// The parts of the current message. Only valid while the log callbacks are called.
+  LogRecord get_current_record() const {
+    return LogRecord{this->current_line_, this->current_timestamp_, this->tx_buffer_ + this->message_start_,
+                     static_cast<size_t>(this->message_end_ - this->message_start_)};
+  }
 
   float get_setup_priority() const override;
 
@@ -118,6 +153,11 @@ class Logger : public Component {
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
+#ifdef USE_LOGGER_ASYNC
+  bool is_main_task_() const;
+  /// Write out all queued messages.
+  void process_queue_();
+#endif
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -161,6 +201,10 @@ class Logger : public Component {
   char *tx_buffer_{nullptr};
   int tx_buffer_at_{0};
   int tx_buffer_size_{0};
+  int current_line_{0};
+  uint32_t current_timestamp_{0};
+  int message_start_{0};
+  int message_end_{0};
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040)
   UARTSelection uart_{UART_SELECTION_UART0};
 #endif
@@ -181,6 +225,17 @@ class Logger : public Component {
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
+#ifdef USE_LOGGER_ASYNC
+  size_t async_queue_size_{0};
+  LogQueue *async_queue_{nullptr};
+  uint32_t reported_dropped_{0};
+#ifdef USE_ESP32
+  TaskHandle_t main_task_{nullptr};
+#endif
+#ifdef USE_HOST
+  pthread_t main_task_{};
+#endif
+#endif
 };
 
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -37,45 +37,45 @@ static const uint8_t MANUFACTURER_NRF52_DATA_LENGTH = 10;
 
 bool MopekaListener::parse_device(const esp32_ble_tracker::ESPBTDevice &device) {
   // Fetch information about BLE device.
-  const auto &service_uuids = device.get_service_uuids();
-  if (service_uuids.size() != 1) {
+  auto advertisement = device.get_advertisement();
+  if (advertisement.count_service_uuids() != 1) {
     return false;
   }
-  const auto &service_uuid = service_uuids[0];
-
-  const auto &manu_datas = device.get_manufacturer_datas();
-  if (manu_datas.size() != 1) {
+  if (advertisement.count_manufacturer_datas() != 1) {
     return false;
   }
-  const auto &manu_data = manu_datas[0];
 
   // Is the device maybe a Mopeka Std (CC2540) sensor.
-  if (service_uuid == esp32_ble_tracker::ESPBTUUID::from_uint16(SERVICE_UUID_CC2540)) {
-    if (manu_data.uuid != esp32_ble_tracker::ESPBTUUID::from_uint16(MANUFACTURER_CC2540_ID)) {
+  if (advertisement.has_service_uuid(esp32_ble_tracker::ESPBTUUID::from_uint16(SERVICE_UUID_CC2540))) {
+    auto manu_data =
+        advertisement.get_manufacturer_data(esp32_ble_tracker::ESPBTUUID::from_uint16(MANUFACTURER_CC2540_ID));
+    if (!manu_data.has_value()) {
       return false;
     }
 
-    if (manu_data.data.size() != MANUFACTURER_CC2540_DATA_LENGTH) {
+    if (manu_data->length != MANUFACTURER_CC2540_DATA_LENGTH) {
       return false;
     }
 
-    const bool sync_button_pressed = (manu_data.data[3] & 0x80) != 0;
+    const bool sync_button_pressed = (manu_data->data[3] & 0x80) != 0;
 
     if (this->show_sensors_without_sync_ || sync_button_pressed) {
       ESP_LOGI(TAG, "MOPEKA STD (CC2540) SENSOR FOUND: %s", device.address_str().c_str());
     }
 
     // Is the device maybe a Mopeka Pro (NRF52) sensor.
-  } else if (service_uuid == esp32_ble_tracker::ESPBTUUID::from_uint16(SERVICE_UUID_NRF52)) {
-    if (manu_data.uuid != esp32_ble_tracker::ESPBTUUID::from_uint16(MANUFACTURER_NRF52_ID)) {
+  } else if (advertisement.has_service_uuid(esp32_ble_tracker::ESPBTUUID::from_uint16(SERVICE_UUID_NRF52))) {
+    auto manu_data =
+        advertisement.get_manufacturer_data(esp32_ble_tracker::ESPBTUUID::from_uint16(MANUFACTURER_NRF52_ID));
+    if (!manu_data.has_value()) {
       return false;
     }
 
-    if (manu_data.data.size() != MANUFACTURER_NRF52_DATA_LENGTH) {
+    if (manu_data->length != MANUFACTURER_NRF52_DATA_LENGTH) {
       return false;
     }
 
-    const bool sync_button_pressed = (manu_data.data[2] & 0x80) != 0;
+    const bool sync_button_pressed = (manu_data->data[2] & 0x80) != 0;
 
     if (this->show_sensors_without_sync_ || sync_button_pressed) {
       ESP_LOGI(TAG, "MOPEKA PRO (NRF52) SENSOR FOUND: %s", device.address_str().c_str());
@@ -121,6 +121,14 @@ class NeoPixelRGBLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_COL
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                nullptr, this->effect_data_ + index, &this->correction_);
   }
+  bool get_pixel_buffer_internal(light::ESPPixelBuffer *buffer) const override {  // NOLINT
+    buffer->data = this->controller_->Pixels();
+    buffer->stride = 3;
+    for (int i = 0; i < 4; i++)
+      buffer->offsets[i] = this->rgb_offsets_[i];
+    buffer->channels = 3;
+    return true;
+  }
 };
 
 template<typename T_METHOD, typename T_COLOR_FEATURE = NeoRgbwFeature>
@@ -138,6 +146,14 @@ class NeoPixelRGBWLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_CO
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                base + this->rgb_offsets_[3], this->effect_data_ + index, &this->correction_);
   }
+  bool get_pixel_buffer_internal(light::ESPPixelBuffer *buffer) const override {  // NOLINT
+    buffer->data = this->controller_->Pixels();
+    buffer->stride = 4;
+    for (int i = 0; i < 4; i++)
+      buffer->offsets[i] = this->rgb_offsets_[i];
+    buffer->channels = 4;
+    return true;
+  }
 };
 
 }  // namespace neopixelbus
@@ -90,6 +90,9 @@ void OTAComponent::setup() {
     return;
   }
 
+  // only run the loop when a client connects, if the socket supports it
+  this->server_watched_ = server_->set_ready_component(this);
+
   this->dump_config();
 }
 
@@ -117,6 +120,10 @@ void OTAComponent::loop() {
     ESP_LOGI(TAG, "Boot seems successful, resetting boot loop counter.");
     this->clean_rtc();
   }
+
+  // the safe mode timeout needs the loop, after that there's only work when a client connects
+  if (this->client_ == nullptr && !this->has_safe_mode_ && this->server_watched_)
+    this->disable_loop();
 }
 
 static const uint8_t FEATURE_SUPPORTS_COMPRESSION = 0x01;
@@ -89,6 +89,7 @@ class OTAComponent : public Component {
 
   std::unique_ptr<socket::Socket> server_;
   std::unique_ptr<socket::Socket> client_;
+  bool server_watched_{false};  ///< whether the server socket enables the loop when a client connects.
 
   bool has_safe_mode_{false};              ///< stores whether safe mode can be enabled.
   uint32_t safe_mode_start_time_;          ///< stores when safe mode was enabled.
@@ -87,15 +87,18 @@ bool RemoteReceiveData::expect_pulse_with_gap(uint32_t mark, uint32_t space) {
 bool RemoteReceiverBinarySensorBase::on_receive(RemoteReceiveData src) {
   if (!this->matches(src))
     return false;
+  this->publish_pulse_();
+  return true;
+}
+void RemoteReceiverBinarySensorBase::publish_pulse_() {
   this->publish_state(true);
   yield();
   this->publish_state(false);
-  return true;
 }
 
 /* RemoteReceiverBase */
 
-void RemoteReceiverBase::register_dumper(RemoteReceiverDumperBase *dumper) {
+void RemoteReceiverBase::register_dumper_(RemoteReceiverDumperBase *dumper, const void * /*unused*/) {
   if (dumper->is_secondary()) {
     this->secondary_dumpers_.push_back(dumper);
   } else {
@@ -104,6 +107,8 @@ void RemoteReceiverBase::register_dumper(RemoteReceiverDumperBase *dumper) {
 }
 
 void RemoteReceiverBase::call_listeners_() {
+  for (auto *dispatcher : this->dispatchers_)
+    dispatcher->reset();
   for (auto *listener : this->listeners_)
     listener->on_receive(RemoteReceiveData(this->temp_, this->tolerance_));
 }
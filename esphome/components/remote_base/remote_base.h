@@ -156,15 +156,110 @@ class RemoteReceiverDumperBase {
   virtual bool is_secondary() { return false; }
 };
 
+/// Unique identifier of the protocol \p T, to find its dispatcher without RTTI.
+template<typename T> const void *remote_protocol_id() {
+  static const char ID = 0;
+  return &ID;
+}
+
+class RemoteProtocolDispatcherBase {
+ public:
+  explicit RemoteProtocolDispatcherBase(const void *protocol_id) : protocol_id_(protocol_id) {}
+  const void *get_protocol_id() const { return this->protocol_id_; }
+  /// Forget the result of the previous frame, must be called before a new frame is passed on.
+  void reset() { this->decoded_ = false; }
+
+ protected:
+  const void *protocol_id_;
+  bool decoded_{false};
+};
+
+/** Decodes each received frame only once with the protocol \p T, for all listeners and the dumper of the protocol.
+ *
+ * Without this, every binary sensor, trigger and dumper of a protocol would decode the same frame again.
+ */
+template<typename T> class RemoteProtocolDispatcher : public RemoteProtocolDispatcherBase {
+ public:
+  RemoteProtocolDispatcher() : RemoteProtocolDispatcherBase(remote_protocol_id<T>()) {}
+
+  /// Decode the frame, or return the result of decoding it earlier.
+  const optional<typename T::ProtocolData> &decode(RemoteReceiveData src) {
+    if (!this->decoded_) {
+      this->result_ = T().decode(src);
+      this->decoded_ = true;
+    }
+    return this->result_;
+  }
+
+ protected:
+  optional<typename T::ProtocolData> result_;
+};
+
+/** Listener for frames of the protocol \p T.
+ *
+ * The listeners of a protocol share the frame decoded by its dispatcher, but are still called in the order in which
+ * they were registered with the receiver.
+ */
+template<typename T> class RemoteProtocolListener {
+ public:
+  virtual ~RemoteProtocolListener() = default;
+  virtual bool on_decode(const typename T::ProtocolData &data) = 0;
+  void set_dispatcher(RemoteProtocolDispatcher<T> *dispatcher) { this->dispatcher_ = dispatcher; }
+
+ protected:
+  /// Decode the frame, or reuse the result of a listener of the same protocol that already decoded it.
+  optional<typename T::ProtocolData> decode_(RemoteReceiveData src) {
+    if (this->dispatcher_ == nullptr)
+      return T().decode(src);
+    return this->dispatcher_->decode(src);
+  }
+  /// Implementation of RemoteReceiverListener::on_receive() for the listeners.
+  bool receive_(RemoteReceiveData src) {
+    auto res = this->decode_(src);
+    return res.has_value() && this->on_decode(*res);
+  }
+
+  RemoteProtocolDispatcher<T> *dispatcher_{nullptr};
+};
+
+template<typename T> class RemoteReceiverDumper;
+
 class RemoteReceiverBase : public RemoteComponentBase {
  public:
   RemoteReceiverBase(InternalGPIOPin *pin) : RemoteComponentBase(pin) {}
-  void register_listener(RemoteReceiverListener *listener) { this->listeners_.push_back(listener); }
-  void register_dumper(RemoteReceiverDumperBase *dumper);
+  /// Register a listener. Listeners of a protocol share a dispatcher, so that each frame is decoded only once.
+  template<typename L> void register_listener(L *listener) { this->register_listener_(listener, listener); }
+  /// Register a dumper. Dumpers of a protocol reuse the frame decoded for its listeners.
+  template<typename L> void register_dumper(L *dumper) { this->register_dumper_(dumper, dumper); }
   void set_tolerance(uint8_t tolerance) { tolerance_ = tolerance; }
 
  protected:
+  // The templates are the better match for protocol listeners and dumpers, these take everything else.
+  void register_listener_(RemoteReceiverListener *listener, const void * /*unused*/) {
+    this->listeners_.push_back(listener);
+  }
+  template<typename L, typename T> void register_listener_(L *listener, RemoteProtocolListener<T> *protocol_listener) {
+    protocol_listener->set_dispatcher(this->get_dispatcher_<T>());
+    this->listeners_.push_back(listener);
+  }
+  void register_dumper_(RemoteReceiverDumperBase *dumper, const void * /*unused*/);
+  template<typename L, typename T> void register_dumper_(L *dumper, RemoteReceiverDumper<T> * /*unused*/) {
+    dumper->set_dispatcher(this->get_dispatcher_<T>());
+    this->register_dumper_(static_cast<RemoteReceiverDumperBase *>(dumper), nullptr);
+  }
+  template<typename T> RemoteProtocolDispatcher<T> *get_dispatcher_() {
+    for (auto *dispatcher : this->dispatchers_) {
+      if (dispatcher->get_protocol_id() == remote_protocol_id<T>())
+        return static_cast<RemoteProtocolDispatcher<T> *>(dispatcher);
+    }
+    auto *dispatcher = new RemoteProtocolDispatcher<T>();  // NOLINT(cppcoreguidelines-owning-memory)
+    this->dispatchers_.push_back(dispatcher);
+    return dispatcher;
+  }
+
+  /// Pass a new frame to the listeners, this starts a new frame for the dispatchers.
   void call_listeners_();
+  /// Pass the frame to the dumpers, must be called after call_listeners_() for the same frame.
   void call_dumpers_();
   void call_listeners_dumpers_() {
     this->call_listeners_();
@@ -172,6 +267,7 @@ class RemoteReceiverBase : public RemoteComponentBase {
   }
 
   std::vector<RemoteReceiverListener *> listeners_;
+  std::vector<RemoteProtocolDispatcherBase *> dispatchers_;
   std::vector<RemoteReceiverDumperBase *> dumpers_;
   std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
   RawTimings temp_;
@@ -186,6 +282,10 @@ class RemoteReceiverBinarySensorBase : public binary_sensor::BinarySensorInitial
   void dump_config() override;
   virtual bool matches(RemoteReceiveData src) = 0;
   bool on_receive(RemoteReceiveData src) override;
+
+ protected:
+  /// Publish a short pulse for a received code.
+  void publish_pulse_();
 };
 
 /* TEMPLATES */
@@ -198,16 +298,23 @@ template<typename T> class RemoteProtocol {
   virtual void dump(const ProtocolData &data) = 0;
 };
 
-template<typename T> class RemoteReceiverBinarySensor : public RemoteReceiverBinarySensorBase {
+template<typename T>
+class RemoteReceiverBinarySensor : public RemoteReceiverBinarySensorBase, public RemoteProtocolListener<T> {
  public:
   RemoteReceiverBinarySensor() : RemoteReceiverBinarySensorBase() {}
 
  protected:
   bool matches(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = this->decode_(src);
     return res.has_value() && *res == this->data_;
   }
+  bool on_receive(RemoteReceiveData src) override { return this->receive_(src); }
+  bool on_decode(const typename T::ProtocolData &data) override {
+    if (!(data == this->data_))
+      return false;
+    this->publish_pulse_();
+    return true;
+  }
 
  public:
   void set_data(typename T::ProtocolData data) { data_ = data; }
@@ -217,16 +324,14 @@ template<typename T> class RemoteReceiverBinarySensor : public RemoteReceiverBin
 };
 
 template<typename T>
-class RemoteReceiverTrigger : public Trigger<typename T::ProtocolData>, public RemoteReceiverListener {
+class RemoteReceiverTrigger : public Trigger<typename T::ProtocolData>,
+                              public RemoteReceiverListener,
+                              public RemoteProtocolListener<T> {
  protected:
-  bool on_receive(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
-    if (res.has_value()) {
-      this->trigger(*res);
-      return true;
-    }
-    return false;
+  bool on_receive(RemoteReceiveData src) override { return this->receive_(src); }
+  bool on_decode(const typename T::ProtocolData &data) override {
+    this->trigger(data);
+    return true;
   }
 };
 
@@ -262,13 +367,21 @@ template<typename... Ts> class RemoteTransmitterActionBase : public RemoteTransm
 template<typename T> class RemoteReceiverDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override {
-    auto proto = T();
-    auto decoded = proto.decode(src);
+    if (this->dispatcher_ == nullptr)
+      return this->dump_(T().decode(src));
+    return this->dump_(this->dispatcher_->decode(src));
+  }
+  void set_dispatcher(RemoteProtocolDispatcher<T> *dispatcher) { this->dispatcher_ = dispatcher; }
+
+ protected:
+  bool dump_(const optional<typename T::ProtocolData> &decoded) {
     if (!decoded.has_value())
       return false;
-    proto.dump(*decoded);
+    T().dump(*decoded);
     return true;
   }
+
+  RemoteProtocolDispatcher<T> *dispatcher_{nullptr};
 };
 
 #define DECLARE_REMOTE_PROTOCOL_(prefix) \
@@ -121,6 +121,9 @@ void IRAM_ATTR HOT RotaryEncoderSensorStore::gpio_intr(RotaryEncoderSensorStore
   }
   arg->first_read = false;
 
+  if (rotation_dir != 0)
+    arg->parent->enable_loop_soon_any_context();
+
   arg->state = new_state;
 }
 
@@ -143,6 +146,7 @@ void RotaryEncoderSensor::setup() {
 
   this->store_.counter = initial_value;
   this->store_.last_read = initial_value;
+  this->store_.parent = this;
 
   this->pin_a_->setup();
   this->store_.pin_a = this->pin_a_->to_isr();
@@ -228,6 +232,10 @@ void RotaryEncoderSensor::loop() {
     this->publish_state(counter);
     this->publish_initial_value_ = false;
   }
+
+  // Without an index pin, there's nothing to do until the interrupt handler records a rotation
+  if (this->pin_i_ == nullptr)
+    this->disable_loop();
 }
 
 float RotaryEncoderSensor::get_setup_priority() const { return setup_priority::DATA; }
@@ -38,6 +38,7 @@ struct RotaryEncoderSensorStore {
 
   std::array<int8_t, 8> rotation_events{};
   bool rotation_events_overflow{false};
+  Component *parent{nullptr};
 
   static void gpio_intr(RotaryEncoderSensorStore *arg);
 };
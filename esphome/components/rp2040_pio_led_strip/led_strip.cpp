@@ -81,7 +81,19 @@ void RP2040PIOLEDStripLightOutput::write_state(light::LightState *state) {
 }
 
 light::ESPColorView RP2040PIOLEDStripLightOutput::get_view_internal(int32_t index) const {
-  int32_t r = 0, g = 0, b = 0, w = 0;
+  light::ESPPixelBuffer buffer;
+  this->get_pixel_buffer_internal(&buffer);
+  uint8_t *pixel = buffer.data + index * buffer.stride;
+  return {pixel + buffer.offsets[0],
+          pixel + buffer.offsets[1],
+          pixel + buffer.offsets[2],
+          this->is_rgbw_ ? pixel + buffer.offsets[3] : nullptr,
+          &this->effect_data_[index],
+          &this->correction_};
+}
+
+bool RP2040PIOLEDStripLightOutput::get_pixel_buffer_internal(light::ESPPixelBuffer *buffer) const {
+  uint8_t r = 0, g = 0, b = 0;
   switch (this->rgb_order_) {
     case ORDER_RGB:
       r = 0;
@@ -114,13 +126,14 @@ light::ESPColorView RP2040PIOLEDStripLightOutput::get_view_internal(int32_t inde
       b = 0;
       break;
   }
-  uint8_t multiplier = this->is_rgbw_ ? 4 : 3;
-  return {this->buf_ + (index * multiplier) + r,
-          this->buf_ + (index * multiplier) + g,
-          this->buf_ + (index * multiplier) + b,
-          this->is_rgbw_ ? this->buf_ + (index * multiplier) + 3 : nullptr,
-          &this->effect_data_[index],
-          &this->correction_};
+  buffer->data = this->buf_;
+  buffer->stride = this->is_rgbw_ ? 4 : 3;
+  buffer->offsets[0] = r;
+  buffer->offsets[1] = g;
+  buffer->offsets[2] = b;
+  buffer->offsets[3] = 3;
+  buffer->channels = buffer->stride;
+  return true;
 }
 
 void RP2040PIOLEDStripLightOutput::dump_config() {
@@ -80,6 +80,7 @@ class RP2040PIOLEDStripLightOutput : public light::AddressableLight {
 
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override;
+  bool get_pixel_buffer_internal(light::ESPPixelBuffer *buffer) const override;
 
   size_t get_buffer_size_() const { return this->num_leds_ * (3 + this->is_rgbw_); }
 
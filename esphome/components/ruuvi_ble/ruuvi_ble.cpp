@@ -8,12 +8,10 @@ namespace ruuvi_ble {
 
 static const char *const TAG = "ruuvi_ble";
 
-bool parse_ruuvi_data_byte(const esp32_ble_tracker::adv_data_t &adv_data, RuuviParseResult &result) {
-  const uint8_t data_type = adv_data[0];
-  const auto *data = &adv_data[1];
+bool parse_ruuvi_data_byte(uint8_t data_type, const uint8_t *data, uint8_t data_length, RuuviParseResult &result) {
   switch (data_type) {
     case 0x03: {  // RAWv1
-      if (adv_data.size() != 14)
+      if (data_length != 13)
         return false;
 
       const uint8_t temp_sign = (data[1] >> 7) & 1;
@@ -40,7 +38,7 @@ bool parse_ruuvi_data_byte(const esp32_ble_tracker::adv_data_t &adv_data, RuuviP
       return true;
     }
     case 0x05: {  // RAWv2
-      if (adv_data.size() != 24)
+      if (data_length != 23)
         return false;
 
       const float temperature = (int16_t(data[0] << 8) + int16_t(data[1])) * 0.005f;
@@ -81,12 +79,13 @@ bool parse_ruuvi_data_byte(const esp32_ble_tracker::adv_data_t &adv_data, RuuviP
 optional<RuuviParseResult> parse_ruuvi(const esp32_ble_tracker::ESPBTDevice &device) {
   bool success = false;
   RuuviParseResult result{};
-  for (auto &it : device.get_manufacturer_datas()) {
-    bool is_ruuvi = it.uuid.contains(0x99, 0x04);
-    if (!is_ruuvi)
+  for (auto record : device.get_advertisement()) {
+    auto it = record.as_manufacturer_data();
+    bool is_ruuvi = it.has_value() && it->uuid.contains(0x99, 0x04);
+    if (!is_ruuvi || it->length < 1)
       continue;
 
-    if (parse_ruuvi_data_byte(it.data, result))
+    if (parse_ruuvi_data_byte(it->data[0], it->data + 1, it->length - 1, result))
       success = true;
   }
   if (!success)
@@ -1,4 +1,5 @@
 #include "filter.h"
+#include <algorithm>
 #include <cmath>
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
@@ -31,40 +32,46 @@ void Filter::initialize(Sensor *parent, Filter *next) {
   this->next_ = next;
 }
 
+// SortedWindow
+void SortedWindow::init(size_t window_size) {
+  this->window_.init(window_size);
+  this->sorted_.clear();
+  this->sorted_.reserve(window_size);
+}
+void SortedWindow::push(float value) {
+  if (this->window_.full()) {
+    float old = this->window_.front();
+    this->window_.pop_front();
+    if (!std::isnan(old))
+      this->sorted_.erase(std::lower_bound(this->sorted_.begin(), this->sorted_.end(), old));
+  }
+  this->window_.push_back(value);
+  if (!std::isnan(value))
+    this->sorted_.insert(std::upper_bound(this->sorted_.begin(), this->sorted_.end(), value), value);
+}
+
 // MedianFilter
 MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
     : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
 void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
 void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
 optional<float> MedianFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  if (this->window_.window_size() != this->window_size_)
+    this->window_.init(this->window_size_);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
     float median = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> median_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          median_queue.push_back(v);
-        }
-      }
-
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size) {
-        if (queue_size % 2) {
-          median = median_queue[queue_size / 2];
-        } else {
-          median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
-        }
+    const std::vector<float> &sorted = this->window_.sorted();
+    size_t queue_size = sorted.size();
+    if (queue_size) {
+      if (queue_size % 2) {
+        median = sorted[queue_size / 2];
+      } else {
+        median = (sorted[queue_size / 2] + sorted[(queue_size / 2) - 1]) / 2.0f;
       }
     }
 
@@ -94,33 +101,21 @@ void QuantileFilter::set_send_every(size_t send_every) { this->send_every_ = sen
 void QuantileFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
 void QuantileFilter::set_quantile(float quantile) { this->quantile_ = quantile; }
 optional<float> QuantileFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  if (this->window_.window_size() != this->window_size_)
+    this->window_.init(this->window_size_);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f), quantile:%f", this, value, this->quantile_);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
     float result = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> quantile_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          quantile_queue.push_back(v);
-        }
-      }
-
-      sort(quantile_queue.begin(), quantile_queue.end());
-
-      size_t queue_size = quantile_queue.size();
-      if (queue_size) {
-        size_t position = ceilf(queue_size * this->quantile_) - 1;
-        ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position + 1, queue_size);
-        result = quantile_queue[position];
-      }
+    const std::vector<float> &sorted = this->window_.sorted();
+    size_t queue_size = sorted.size();
+    if (queue_size) {
+      size_t position = ceilf(queue_size * this->quantile_) - 1;
+      ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position + 1, queue_size);
+      result = sorted[position];
     }
 
     ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f) SENDING %f", this, value, result);
@@ -135,22 +130,15 @@ MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at
 void MinFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
 void MinFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
 optional<float> MinFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  if (this->window_.window_size() != this->window_size_)
+    this->window_.init(this->window_size_);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float min = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        min = std::isnan(min) ? v : std::min(min, v);
-      }
-    }
-
+    float min = this->window_.get();
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f) SENDING %f", this, value, min);
     return min;
   }
@@ -163,22 +151,15 @@ MaxFilter::MaxFilter(size_t window_size, size_t send_every, size_t send_first_at
 void MaxFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
 void MaxFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
 optional<float> MaxFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  if (this->window_.window_size() != this->window_size_)
+    this->window_.init(this->window_size_);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float max = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        max = std::isnan(max) ? v : std::max(max, v);
-      }
-    }
-
+    float max = this->window_.get();
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f) SENDING %f", this, value, max);
     return max;
   }
@@ -192,27 +173,40 @@ SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window
 void SlidingWindowMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
 void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
 optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
+  if (this->queue_.capacity() != this->window_size_) {
+    this->queue_.init(this->window_size_);
+    this->sum_ = 0;
+    this->valid_count_ = 0;
+  }
+  if (this->queue_.full()) {
+    float old = this->queue_.front();
     this->queue_.pop_front();
+    if (!std::isnan(old)) {
+      this->sum_ -= old;
+      this->valid_count_--;
+    }
   }
   this->queue_.push_back(value);
+  if (!std::isnan(value)) {
+    this->sum_ += value;
+    this->valid_count_++;
+  }
   ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float sum = 0;
-    size_t valid_count = 0;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        sum += v;
-        valid_count++;
-      }
-    }
-
     float average = NAN;
-    if (valid_count) {
-      average = sum / valid_count;
+    if (this->valid_count_) {
+      if (!std::isfinite(this->sum_)) {
+        // an infinite value poisons the running sum even after it left the window, so start over from the window
+        this->sum_ = 0;
+        for (size_t i = 0; i < this->queue_.size(); i++) {
+          if (!std::isnan(this->queue_[i]))
+            this->sum_ += this->queue_[i];
+        }
+      }
+      average = this->sum_ / this->valid_count_;
     }
 
     ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f) SENDING %f", this, value, average);
@@ -1,6 +1,8 @@
 #pragma once
 
-#include <queue>
+#include <cmath>
+#include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 #include "esphome/core/component.h"
@@ -43,6 +45,100 @@ class Filter {
   Sensor *parent_{nullptr};
 };
 
+/// Ring buffer with a fixed capacity, allocated once instead of growing and shrinking like a std::deque.
+template<typename T> class FilterRingBuffer {
+ public:
+  /// (Re)allocate the buffer for \p capacity elements, dropping all current contents.
+  void init(size_t capacity) {
+    this->storage_.reset(new T[capacity]);  // NOLINT(cppcoreguidelines-owning-memory)
+    this->capacity_ = capacity;
+    this->head_ = 0;
+    this->size_ = 0;
+  }
+
+  size_t capacity() const { return this->capacity_; }
+  size_t size() const { return this->size_; }
+  bool empty() const { return this->size_ == 0; }
+  bool full() const { return this->size_ == this->capacity_; }
+
+  T &front() { return this->storage_[this->head_]; }
+  T &back() { return this->storage_[this->wrap_(this->head_ + this->size_ - 1)]; }
+  T &operator[](size_t index) { return this->storage_[this->wrap_(this->head_ + index)]; }
+  /// Append an element, the buffer must not be full.
+  void push_back(const T &value) {
+    this->storage_[this->wrap_(this->head_ + this->size_)] = value;
+    this->size_++;
+  }
+  void pop_front() {
+    this->head_ = this->wrap_(this->head_ + 1);
+    this->size_--;
+  }
+  void pop_back() { this->size_--; }
+
+ protected:
+  size_t wrap_(size_t index) const { return index >= this->capacity_ ? index - this->capacity_ : index; }
+
+  std::unique_ptr<T[]> storage_;
+  size_t capacity_{0};
+  size_t head_{0};
+  size_t size_{0};
+};
+
+/** Sorted copy of the valid values of a sliding window, to look up the median or a quantile without sorting.
+ *
+ * Each new value is inserted at its place and the value leaving the window is removed, which only moves memory within
+ * a buffer that is allocated once.
+ */
+class SortedWindow {
+ public:
+  void init(size_t window_size);
+  size_t window_size() const { return this->window_.capacity(); }
+  void push(float value);
+
+  /// The valid (non-NaN) values in the window in ascending order.
+  const std::vector<float> &sorted() const { return this->sorted_; }
+
+ protected:
+  FilterRingBuffer<float> window_;
+  std::vector<float> sorted_;
+};
+
+/** Minimum or maximum of a sliding window in amortized constant time.
+ *
+ * Only the values that can still become the extreme are kept: once a newer value compares better, the older ones can
+ * never be the extreme of the window again, so the candidates are always ordered and the front is the result.
+ */
+template<typename Compare> class SlidingWindowExtreme {
+ public:
+  void init(size_t window_size) {
+    this->candidates_.init(window_size);
+    this->index_ = 0;
+  }
+  size_t window_size() const { return this->candidates_.capacity(); }
+
+  void push(float value) {
+    uint32_t index = this->index_++;
+    if (!this->candidates_.empty() && index - this->candidates_.front().index >= this->window_size())
+      this->candidates_.pop_front();
+    if (std::isnan(value))
+      return;
+    while (!this->candidates_.empty() && !Compare()(this->candidates_.back().value, value))
+      this->candidates_.pop_back();
+    this->candidates_.push_back(Candidate{index, value});
+  }
+
+  /// The extreme of the valid (non-NaN) values in the window, or NaN if there are none.
+  float get() { return this->candidates_.empty() ? NAN : this->candidates_.front().value; }
+
+ protected:
+  struct Candidate {
+    uint32_t index;
+    float value;
+  };
+  FilterRingBuffer<Candidate> candidates_;
+  uint32_t index_{0};
+};
+
 /** Simple quantile filter.
  *
  * Takes the quantile of the last <send_every> values and pushes it out every <send_every>.
@@ -67,7 +163,7 @@ class QuantileFilter : public Filter {
   void set_quantile(float quantile);
 
  protected:
-  std::deque<float> queue_;
+  SortedWindow window_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -96,7 +192,7 @@ class MedianFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SortedWindow window_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -142,7 +238,7 @@ class MinFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowExtreme<std::less<float>> window_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -170,7 +266,7 @@ class MaxFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowExtreme<std::greater<float>> window_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -199,7 +295,9 @@ class SlidingWindowMovingAverageFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  FilterRingBuffer<float> queue_;
+  double sum_{0};
+  size_t valid_count_{0};
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -1,5 +1,6 @@
 import esphome.config_validation as cv
 import esphome.codegen as cg
+from esphome.core import CORE
 
 CODEOWNERS = ["@esphome/core"]
 
@@ -37,3 +38,6 @@ async def to_code(config):
         cg.add_define("USE_SOCKET_IMPL_LWIP_SOCKETS")
     elif impl == IMPLEMENTATION_BSD_SOCKETS:
         cg.add_define("USE_SOCKET_IMPL_BSD_SOCKETS")
+        if CORE.is_esp32 or CORE.is_host:
+            # the main loop can wait for these sockets with select()/poll()
+            cg.add_define("USE_SOCKET_SELECT_SUPPORT")
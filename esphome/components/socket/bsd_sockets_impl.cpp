@@ -4,6 +4,10 @@
 
 #ifdef USE_SOCKET_IMPL_BSD_SOCKETS
 
+#ifdef USE_SOCKET_SELECT_SUPPORT
+#include "esphome/core/application.h"
+#endif
+
 #include <cstring>
 
 #ifdef USE_ESP32
@@ -54,6 +58,12 @@ class BSDSocketImpl : public Socket {
   }
   int bind(const struct sockaddr *addr, socklen_t addrlen) override { return ::bind(fd_, addr, addrlen); }
   int close() override {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    if (watched_) {
+      App.unregister_socket_fd(fd_);
+      watched_ = false;
+    }
+#endif
     int ret = ::close(fd_);
     closed_ = true;
     return ret;
@@ -118,9 +128,27 @@ class BSDSocketImpl : public Socket {
     return 0;
   }
 
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  bool set_ready_component(Component *component) override {
+    if (component == nullptr) {
+      if (watched_)
+        App.unregister_socket_fd(fd_);
+      watched_ = false;
+      return true;
+    }
+    if (closed_)
+      return false;
+    watched_ = App.register_socket_fd(fd_, component);
+    return watched_;
+  }
+#endif
+
  protected:
   int fd_;
   bool closed_ = false;
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  bool watched_ = false;
+#endif
 };
 
 std::unique_ptr<Socket> socket(int domain, int type, int protocol) {
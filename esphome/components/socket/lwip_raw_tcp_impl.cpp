@@ -11,6 +11,7 @@
 #include <cstring>
 #include <queue>
 
+#include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
@@ -484,6 +485,14 @@ class LWIPRawImpl : public Socket {
     return 0;
   }
 
+  bool set_ready_component(Component *component) override {
+    ready_component_ = component;
+    // data that arrived before won't cause another callback
+    if (!accepted_sockets_.empty() || rx_buf_ != nullptr || rx_closed_ || pcb_ == nullptr)
+      notify_ready_();
+    return true;
+  }
+
   err_t accept_fn(struct tcp_pcb *newpcb, err_t err) {
     LWIP_LOG("accept(newpcb=%p err=%d)", newpcb, err);
     if (err != ERR_OK || newpcb == nullptr) {
@@ -496,6 +505,7 @@ class LWIPRawImpl : public Socket {
     auto sock = make_unique<LWIPRawImpl>(family_, newpcb);
     sock->init();
     accepted_sockets_.push(std::move(sock));
+    notify_ready_();
     return ERR_OK;
   }
   void err_fn(err_t err) {
@@ -506,6 +516,7 @@ class LWIPRawImpl : public Socket {
     // ERR_RST: connection was reset by remote host
     // ERR_ABRT: aborted through tcp_abort or TCP timer
     pcb_ = nullptr;
+    notify_ready_();
   }
   err_t recv_fn(struct pbuf *pb, err_t err) {
     LWIP_LOG("recv(pb=%p err=%d)", pb, err);
@@ -513,10 +524,12 @@ class LWIPRawImpl : public Socket {
       // "An error code if there has been an error receiving Only return ERR_ABRT if you have
       // called tcp_abort from within the callback function!"
       rx_closed_ = true;
+      notify_ready_();
       return ERR_OK;
     }
     if (pb == nullptr) {
       rx_closed_ = true;
+      notify_ready_();
       return ERR_OK;
     }
     if (rx_buf_ == nullptr) {
@@ -526,6 +539,7 @@ class LWIPRawImpl : public Socket {
     } else {
       pbuf_cat(rx_buf_, pb);
     }
+    notify_ready_();
     return ERR_OK;
   }
 
@@ -545,6 +559,11 @@ class LWIPRawImpl : public Socket {
   }
 
  protected:
+  void notify_ready_() {
+    if (ready_component_ != nullptr)
+      ready_component_->enable_loop_soon_any_context();
+  }
+
   int ip2sockaddr_(ip_addr_t *ip, uint16_t port, struct sockaddr *name, socklen_t *addrlen) {
     if (family_ == AF_INET) {
       if (*addrlen < sizeof(struct sockaddr_in)) {
@@ -594,6 +613,7 @@ class LWIPRawImpl : public Socket {
   // instead use it for determining whether to call lwip_output
   bool nodelay_ = false;
   sa_family_t family_ = 0;
+  Component *ready_component_ = nullptr;
 };
 
 std::unique_ptr<Socket> socket(int domain, int type, int protocol) {
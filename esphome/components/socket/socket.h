@@ -6,6 +6,9 @@
 #include "headers.h"
 
 namespace esphome {
+
+class Component;
+
 namespace socket {
 
 class Socket {
@@ -38,6 +41,14 @@ class Socket {
 
   virtual int setblocking(bool blocking) = 0;
   virtual int loop() { return 0; };
+
+  /** Enable the loop of \p component whenever this socket has data to read or a connection to accept.
+   *
+   * The component can then disable its loop while there's nothing to do, and the main loop sleeps until the socket
+   * becomes ready. Pass nullptr to stop. Returns false if the implementation can't notify, the component must keep
+   * polling the socket then.
+   */
+  virtual bool set_ready_component(Component *component) { return false; }
 };
 
 /// Create a socket of the given domain, type and protocol.
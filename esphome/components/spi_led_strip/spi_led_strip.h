@@ -80,6 +80,15 @@ class SpiLedStrip : public light::AddressableLight,
     return {this->buf_ + pos + 2,       this->buf_ + pos + 1, this->buf_ + pos + 0, nullptr,
             this->effect_data_ + index, &this->correction_};
   }
+  bool get_pixel_buffer_internal(light::ESPPixelBuffer *buffer) const override {
+    buffer->data = this->buf_ + 5;
+    buffer->stride = 4;
+    buffer->offsets[0] = 2;
+    buffer->offsets[1] = 1;
+    buffer->offsets[2] = 0;
+    buffer->channels = 3;
+    return true;
+  }
 
   size_t buffer_size_{};
   uint8_t *effect_data_{nullptr};
@@ -149,36 +149,39 @@ void ST7789V::update() {
 void ST7789V::set_model_str(const char *model_str) { this->model_str_ = model_str; }
 
 void ST7789V::write_display_data() {
-  uint16_t x1 = this->offset_height_;
-  uint16_t x2 = x1 + get_width_internal() - 1;
-  uint16_t y1 = this->offset_width_;
-  uint16_t y2 = y1 + get_height_internal() - 1;
+  size_t band = 0;
+  int x1, y1, x2, y2;
+  while (this->take_dirty_region_(band, x1, y1, x2, y2))
+    this->write_region_(x1, y1, x2, y2);
+}
 
+void ST7789V::write_region_(int x1, int y1, int x2, int y2) {
   this->enable();
 
   // set column(x) address
   this->dc_pin_->digital_write(false);
   this->write_byte(ST7789_CASET);
   this->dc_pin_->digital_write(true);
-  this->write_addr_(x1, x2);
+  this->write_addr_(x1 + this->offset_height_, x2 + this->offset_height_);
   // set page(y) address
   this->dc_pin_->digital_write(false);
   this->write_byte(ST7789_RASET);
   this->dc_pin_->digital_write(true);
-  this->write_addr_(y1, y2);
+  this->write_addr_(y1 + this->offset_width_, y2 + this->offset_width_);
   // write display memory
   this->dc_pin_->digital_write(false);
   this->write_byte(ST7789_RAMWR);
   this->dc_pin_->digital_write(true);
 
+  size_t width = x2 - x1 + 1;
   if (this->eightbitcolor_) {
     uint8_t temp_buffer[TEMP_BUFFER_SIZE];
     size_t temp_index = 0;
-    for (int line = 0; line < this->get_buffer_length_(); line = line + this->get_width_internal()) {
-      for (int index = 0; index < this->get_width_internal(); ++index) {
-        auto color = display::ColorUtil::color_to_565(
-            display::ColorUtil::to_color(this->buffer_[index + line], display::ColorOrder::COLOR_ORDER_RGB,
-                                         display::ColorBitness::COLOR_BITNESS_332, true));
+    for (int line = y1; line <= y2; line++) {
+      const uint8_t *pos = this->buffer_ + line * this->get_width_internal() + x1;
+      for (size_t index = 0; index < width; ++index) {
+        auto color = display::ColorUtil::color_to_565(display::ColorUtil::to_color(
+            pos[index], display::ColorOrder::COLOR_ORDER_RGB, display::ColorBitness::COLOR_BITNESS_332, true));
         temp_buffer[temp_index++] = (uint8_t) (color >> 8);
         temp_buffer[temp_index++] = (uint8_t) color;
         if (temp_index == TEMP_BUFFER_SIZE) {
@@ -189,8 +192,12 @@ void ST7789V::write_display_data() {
     }
     if (temp_index != 0)
       this->write_array(temp_buffer, temp_index);
+  } else if (width == size_t(this->get_width_internal())) {
+    // whole rows are contiguous in the buffer
+    this->write_array(this->buffer_ + y1 * width * 2, (y2 - y1 + 1) * width * 2);
   } else {
-    this->write_array(this->buffer_, this->get_buffer_length_());
+    for (int line = y1; line <= y2; line++)
+      this->write_array(this->buffer_ + (line * this->get_width_internal() + x1) * 2, width * 2);
   }
 
   this->disable();
@@ -296,13 +303,122 @@ void HOT ST7789V::draw_absolute_pixel_internal(int x, int y, Color color) {
   if (this->eightbitcolor_) {
     auto color332 = display::ColorUtil::color_to_332(color);
     uint32_t pos = (x + y * this->get_width_internal());
+    if (this->buffer_[pos] == color332)
+      return;
     this->buffer_[pos] = color332;
   } else {
     auto color565 = display::ColorUtil::color_to_565(color);
     uint32_t pos = (x + y * this->get_width_internal()) * 2;
+    if (this->buffer_[pos] == ((color565 >> 8) & 0xff) && this->buffer_[pos + 1] == (color565 & 0xff))
+      return;
     this->buffer_[pos++] = (color565 >> 8) & 0xff;
     this->buffer_[pos] = color565 & 0xff;
   }
+  this->mark_dirty_(x, y, x, y);
+}
+
+void HOT ST7789V::fill_absolute_block_internal(int x, int y, int width, int height, Color color) {
+  bool updated = false;
+  if (this->eightbitcolor_) {
+    uint8_t color332 = display::ColorUtil::color_to_332(color);
+    for (int row = y; row < y + height; row++) {
+      uint8_t *pos = this->buffer_ + row * this->get_width_internal() + x;
+      for (int i = 0; i < width; i++, pos++) {
+        if (*pos != color332) {
+          *pos = color332;
+          updated = true;
+        }
+      }
+    }
+  } else {
+    uint16_t color565 = display::ColorUtil::color_to_565(color);
+    uint8_t high = color565 >> 8, low = color565;
+    for (int row = y; row < y + height; row++) {
+      uint8_t *pos = this->buffer_ + (row * this->get_width_internal() + x) * 2;
+      for (int i = 0; i < width; i++, pos += 2) {
+        if (pos[0] != high || pos[1] != low) {
+          pos[0] = high;
+          pos[1] = low;
+          updated = true;
+        }
+      }
+    }
+  }
+  if (updated)
+    this->mark_dirty_(x, y, x + width - 1, y + height - 1);
+}
+
+void ST7789V::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
+                             display::ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) {
+  // only big endian RGB565 is stored in the buffer as is, and without rotation its rows are the rows of the source
+  if (this->buffer_ == nullptr || this->rotation_ != display::DISPLAY_ROTATION_0_DEGREES || this->eightbitcolor_ ||
+      bitness != display::COLOR_BITNESS_565 || order != display::COLOR_ORDER_RGB || !big_endian) {
+    display::Display::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset,
+                                     x_pad);
+    return;
+  }
+  int x1, x2, y1, y2;
+  if (!this->clamp_x_(x_start, w, x1, x2) || !this->clamp_y_(y_start, h, y1, y2))
+    return;
+  size_t line_stride = x_offset + w + x_pad;
+  for (int y = y1; y < y2; y++) {
+    const uint8_t *src = ptr + ((y_offset + y - y_start) * line_stride + x_offset + x1 - x_start) * 2;
+    memcpy(this->buffer_ + (y * this->get_width_internal() + x1) * 2, src, (x2 - x1) * 2);
+  }
+  this->mark_dirty_(x1, y1, x2 - 1, y2 - 1);
+}
+
+bool ST7789V::copy_rows(int src_y, int dst_y, int height) {
+  int rows = this->get_height_internal();
+  if (this->buffer_ == nullptr || this->is_clipping() || height <= 0 || src_y < 0 || dst_y < 0 ||
+      src_y + height > rows || dst_y + height > rows)
+    return false;
+  switch (this->rotation_) {
+    case display::DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case display::DISPLAY_ROTATION_180_DEGREES:
+      src_y = rows - src_y - height;
+      dst_y = rows - dst_y - height;
+      break;
+    default:
+      // the rows are columns of the buffer
+      return false;
+  }
+  size_t row_length = this->get_buffer_length_() / rows;
+  memmove(this->buffer_ + dst_y * row_length, this->buffer_ + src_y * row_length, height * row_length);
+  this->mark_dirty_(0, dst_y, this->get_width_internal() - 1, dst_y + height - 1);
+  return true;
+}
+
+bool ST7789V::copy_block(int src_x, int src_y, int width, int height, int dst_x, int dst_y) {
+  int columns = this->get_width_internal(), rows = this->get_height_internal();
+  if (this->buffer_ == nullptr || this->is_clipping() || width <= 0 || height <= 0 || src_x < 0 || src_y < 0 ||
+      dst_x < 0 || dst_y < 0 || src_x + width > columns || dst_x + width > columns || src_y + height > rows ||
+      dst_y + height > rows)
+    return false;
+  switch (this->rotation_) {
+    case display::DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case display::DISPLAY_ROTATION_180_DEGREES:
+      src_x = columns - src_x - width;
+      dst_x = columns - dst_x - width;
+      src_y = rows - src_y - height;
+      dst_y = rows - dst_y - height;
+      break;
+    default:
+      return false;
+  }
+  size_t row_length = this->get_buffer_length_() / rows;
+  size_t bytes_per_pixel = row_length / columns;
+  // copy the rows in an order that doesn't overwrite rows still to be copied
+  bool down = dst_y > src_y;
+  for (int i = 0; i < height; i++) {
+    int row = down ? height - 1 - i : i;
+    memmove(this->buffer_ + (dst_y + row) * row_length + dst_x * bytes_per_pixel,
+            this->buffer_ + (src_y + row) * row_length + src_x * bytes_per_pixel, width * bytes_per_pixel);
+  }
+  this->mark_dirty_(dst_x, dst_y, dst_x + width - 1, dst_y + height - 1);
+  return true;
 }
 
 }  // namespace st7789v
@@ -132,8 +132,14 @@ class ST7789V : public display::DisplayBuffer,
   float get_setup_priority() const override;
   void update() override;
 
+  /// Send the changed regions of the buffer to the display.
   void write_display_data();
 
+  void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
+                      display::ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) override;
+  bool copy_rows(int src_y, int dst_y, int height) override;
+  bool copy_block(int src_x, int src_y, int width, int height, int dst_x, int dst_y) override;
+
   display::DisplayType get_display_type() override { return display::DisplayType::DISPLAY_TYPE_COLOR; }
 
  protected:
@@ -156,6 +162,7 @@ class ST7789V : public display::DisplayBuffer,
   void write_data_(uint8_t value);
   void write_addr_(uint16_t addr1, uint16_t addr2);
   void write_color_(uint16_t color, uint16_t size);
+  void write_region_(int x1, int y1, int x2, int y2);
 
   int get_height_internal() override { return this->height_; }
   int get_width_internal() override { return this->width_; }
@@ -164,6 +171,7 @@ class ST7789V : public display::DisplayBuffer,
   void draw_filled_rect_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_block_internal(int x, int y, int width, int height, Color color) override;
 
   const char *model_str_;
 };
@@ -34,6 +34,13 @@ namespace web_server {
 
 static const char *const TAG = "web_server";
 
+/// State changes are collected for this long before they're pushed, faster updates of an entity are coalesced.
+static const uint32_t STATE_FLUSH_INTERVAL = 100;
+/// Maximum size of the state events pushed per flush, what's left is pushed in the next one.
+static const size_t STATE_FLUSH_MAX_BYTES = 2048;
+/// Don't push states while the clients have more events than this waiting to be sent on average.
+static const size_t MAX_EVENTS_WAITING = 4;
+
 #ifdef USE_WEBSERVER_PRIVATE_NETWORK_ACCESS
 static const char *const HEADER_PNA_NAME = "Private-Network-Access-Name";
 static const char *const HEADER_PNA_ID = "Private-Network-Access-ID";
@@ -110,13 +117,16 @@ void WebServer::set_js_include(const char *js_include) { this->js_include_ = js_
 #endif
 
 std::string WebServer::get_config_json() {
-  return json::build_json([this](JsonObject root) {
-    root["title"] = App.get_friendly_name().empty() ? App.get_name() : App.get_friendly_name();
-    root["comment"] = App.get_comment();
-    root["ota"] = this->allow_ota_;
-    root["log"] = this->expose_log_;
-    root["lang"] = "en";
-  });
+  std::string data;
+  json::JsonWriter writer(data);
+  writer.begin_object();
+  writer.add("title", App.get_friendly_name().empty() ? App.get_name() : App.get_friendly_name());
+  writer.add("comment", App.get_comment());
+  writer.add("ota", this->allow_ota_);
+  writer.add("log", this->expose_log_);
+  writer.add("lang", "en");
+  writer.end_object();
+  return data;
 }
 
 void WebServer::setup() {
@@ -163,6 +173,11 @@ void WebServer::loop() {
   }
 #endif
   this->entities_iterator_.advance();
+#ifdef USE_ESP_IDF
+  this->events_.flush();
+#endif
+  if (!this->pending_states_.empty() && millis() - this->last_state_flush_ >= STATE_FLUSH_INTERVAL)
+    this->flush_states_();
 }
 void WebServer::dump_config() {
   ESP_LOGCONFIG(TAG, "Web Server:");
@@ -395,90 +410,98 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
 }
 #endif
 
-#define set_json_id(root, obj, sensor, start_config) \
-  (root)["id"] = sensor; \
+#define set_json_id(writer, obj, sensor, start_config) \
+  (writer).add("id", sensor); \
   if (((start_config) == DETAIL_ALL)) { \
-    (root)["name"] = (obj)->get_name(); \
-    (root)["icon"] = (obj)->get_icon(); \
-    (root)["entity_category"] = (obj)->get_entity_category(); \
+    (writer).add("name", (obj)->get_name()); \
+    (writer).add("icon", (obj)->get_icon()); \
+    (writer).add("entity_category", (obj)->get_entity_category()); \
     if ((obj)->is_disabled_by_default()) \
-      (root)["is_disabled_by_default"] = (obj)->is_disabled_by_default(); \
+      (writer).add("is_disabled_by_default", (obj)->is_disabled_by_default()); \
   }
 
-#define set_json_value(root, obj, sensor, value, start_config) \
-  set_json_id((root), (obj), sensor, start_config); \
-  (root)["value"] = value;
+#define set_json_value(writer, obj, sensor, value, start_config) \
+  set_json_id((writer), (obj), sensor, start_config); \
+  (writer).add("value", value);
 
-#define set_json_icon_state_value(root, obj, sensor, state, value, start_config) \
-  set_json_value(root, obj, sensor, value, start_config); \
-  (root)["state"] = state;
+#define set_json_icon_state_value(writer, obj, sensor, state, value, start_config) \
+  set_json_value(writer, obj, sensor, value, start_config); \
+  (writer).add("state", state);
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  this->events_.send(this->sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_(obj, StateEventType::SENSOR);
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (sensor::Sensor *obj : App.get_sensors()) {
     if (obj->get_object_id() != match.id)
       continue;
-    std::string data = this->sensor_json(obj, obj->state, DETAIL_STATE);
-    request->send(200, "application/json", data.c_str());
+    std::string data;
+    request->send(200, "application/json", this->sensor_json(obj, obj->state, DETAIL_STATE, data).c_str());
     return;
   }
   request->send(404);
 }
-std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
-    std::string state;
-    if (std::isnan(value)) {
-      state = "NA";
-    } else {
-      state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
-      if (!obj->get_unit_of_measurement().empty())
-        state += " " + obj->get_unit_of_measurement();
-    }
-    set_json_icon_state_value(root, obj, "sensor-" + obj->get_object_id(), state, value, start_config);
-    if (start_config == DETAIL_ALL) {
-      if (!obj->get_unit_of_measurement().empty())
-        root["uom"] = obj->get_unit_of_measurement();
-    }
-  });
+const std::string &WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail start_config,
+                                          std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  std::string state;
+  if (std::isnan(value)) {
+    state = "NA";
+  } else {
+    state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
+    if (!obj->get_unit_of_measurement().empty())
+      state += " " + obj->get_unit_of_measurement();
+  }
+  set_json_icon_state_value(writer, obj, "sensor-" + obj->get_object_id(), state, value, start_config);
+  if (start_config == DETAIL_ALL) {
+    if (!obj->get_unit_of_measurement().empty())
+      writer.add("uom", obj->get_unit_of_measurement());
+  }
+  writer.end_object();
+  return buffer;
 }
 #endif
 
 #ifdef USE_TEXT_SENSOR
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
-  this->events_.send(this->text_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_(obj, StateEventType::TEXT_SENSOR);
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
     if (obj->get_object_id() != match.id)
       continue;
-    std::string data = this->text_sensor_json(obj, obj->state, DETAIL_STATE);
-    request->send(200, "application/json", data.c_str());
+    std::string data;
+    request->send(200, "application/json", this->text_sensor_json(obj, obj->state, DETAIL_STATE, data).c_str());
     return;
   }
   request->send(404);
 }
-std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value,
-                                        JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "text_sensor-" + obj->get_object_id(), value, value, start_config);
-  });
+const std::string &WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value,
+                                               JsonDetail start_config, std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  set_json_icon_state_value(writer, obj, "text_sensor-" + obj->get_object_id(), value, value, start_config);
+  writer.end_object();
+  return buffer;
 }
 #endif
 
 #ifdef USE_SWITCH
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
-  this->events_.send(this->switch_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_(obj, StateEventType::SWITCH);
 }
-std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "switch-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
-    if (start_config == DETAIL_ALL) {
-      root["assumed_state"] = obj->assumed_state();
-    }
-  });
+const std::string &WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail start_config,
+                                          std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  set_json_icon_state_value(writer, obj, "switch-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
+  if (start_config == DETAIL_ALL) {
+    writer.add("assumed_state", obj->assumed_state());
+  }
+  writer.end_object();
+  return buffer;
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (switch_::Switch *obj : App.get_switches()) {
@@ -486,8 +509,8 @@ void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlM
       continue;
 
     if (request->method() == HTTP_GET) {
-      std::string data = this->switch_json(obj, obj->state, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
+      std::string data;
+      request->send(200, "application/json", this->switch_json(obj, obj->state, DETAIL_STATE, data).c_str());
     } else if (match.method == "toggle") {
       this->schedule_([obj]() { obj->toggle(); });
       request->send(200);
@@ -507,9 +530,12 @@ void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlM
 #endif
 
 #ifdef USE_BUTTON
-std::string WebServer::button_json(button::Button *obj, JsonDetail start_config) {
-  return json::build_json(
-      [obj, start_config](JsonObject root) { set_json_id(root, obj, "button-" + obj->get_object_id(), start_config); });
+const std::string &WebServer::button_json(button::Button *obj, JsonDetail start_config, std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  set_json_id(writer, obj, "button-" + obj->get_object_id(), start_config);
+  writer.end_object();
+  return buffer;
 }
 
 void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -531,20 +557,23 @@ void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlM
 
 #ifdef USE_BINARY_SENSOR
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
-  this->events_.send(this->binary_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_(obj, StateEventType::BINARY_SENSOR);
 }
-std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "binary_sensor-" + obj->get_object_id(), value ? "ON" : "OFF", value,
-                              start_config);
-  });
+const std::string &WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value,
+                                                 JsonDetail start_config, std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  set_json_icon_state_value(writer, obj, "binary_sensor-" + obj->get_object_id(), value ? "ON" : "OFF", value,
+                            start_config);
+  writer.end_object();
+  return buffer;
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (binary_sensor::BinarySensor *obj : App.get_binary_sensors()) {
     if (obj->get_object_id() != match.id)
       continue;
-    std::string data = this->binary_sensor_json(obj, obj->state, DETAIL_STATE);
-    request->send(200, "application/json", data.c_str());
+    std::string data;
+    request->send(200, "application/json", this->binary_sensor_json(obj, obj->state, DETAIL_STATE, data).c_str());
     return;
   }
   request->send(404);
@@ -552,19 +581,23 @@ void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, con
 #endif
 
 #ifdef USE_FAN
-void WebServer::on_fan_update(fan::Fan *obj) { this->events_.send(this->fan_json(obj, DETAIL_STATE).c_str(), "state"); }
-std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "fan-" + obj->get_object_id(), obj->state ? "ON" : "OFF", obj->state,
-                              start_config);
-    const auto traits = obj->get_traits();
-    if (traits.supports_speed()) {
-      root["speed_level"] = obj->speed;
-      root["speed_count"] = traits.supported_speed_count();
-    }
-    if (obj->get_traits().supports_oscillation())
-      root["oscillation"] = obj->oscillating;
-  });
+void WebServer::on_fan_update(fan::Fan *obj) {
+  this->queue_state_(obj, StateEventType::FAN);
+}
+const std::string &WebServer::fan_json(fan::Fan *obj, JsonDetail start_config, std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  set_json_icon_state_value(writer, obj, "fan-" + obj->get_object_id(), obj->state ? "ON" : "OFF", obj->state,
+                            start_config);
+  const auto traits = obj->get_traits();
+  if (traits.supports_speed()) {
+    writer.add("speed_level", obj->speed);
+    writer.add("speed_count", traits.supported_speed_count());
+  }
+  if (obj->get_traits().supports_oscillation())
+    writer.add("oscillation", obj->oscillating);
+  writer.end_object();
+  return buffer;
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (fan::Fan *obj : App.get_fans()) {
@@ -572,8 +605,8 @@ void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatc
       continue;
 
     if (request->method() == HTTP_GET) {
-      std::string data = this->fan_json(obj, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
+      std::string data;
+      request->send(200, "application/json", this->fan_json(obj, DETAIL_STATE, data).c_str());
     } else if (match.method == "toggle") {
       this->schedule_([obj]() { obj->toggle().perform(); });
       request->send(200);
@@ -622,7 +655,7 @@ void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatc
 
 #ifdef USE_LIGHT
 void WebServer::on_light_update(light::LightState *obj) {
-  this->events_.send(this->light_json(obj, DETAIL_STATE).c_str(), "state");
+  this->queue_state_(obj, StateEventType::LIGHT);
 }
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (light::LightState *obj : App.get_lights()) {
@@ -630,8 +663,8 @@ void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMa
       continue;
 
     if (request->method() == HTTP_GET) {
-      std::string data = this->light_json(obj, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
+      std::string data;
+      request->send(200, "application/json", this->light_json(obj, DETAIL_STATE, data).c_str());
     } else if (match.method == "toggle") {
       this->schedule_([obj]() { obj->toggle().perform(); });
       request->send(200);
@@ -709,26 +742,31 @@ void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMa
   }
   request->send(404);
 }
-std::string WebServer::light_json(light::LightState *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "light-" + obj->get_object_id(), start_config);
-    root["state"] = obj->remote_values.is_on() ? "ON" : "OFF";
-
-    light::LightJSONSchema::dump_json(*obj, root);
-    if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("effects");
-      opt.add("None");
-      for (auto const &option : obj->get_effects()) {
-        opt.add(option->get_name());
-      }
+const std::string &WebServer::light_json(light::LightState *obj, JsonDetail start_config, std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  set_json_id(writer, obj, "light-" + obj->get_object_id(), start_config);
+  // the schema only writes the state for color modes that can be switched on and off
+  if (!(obj->remote_values.get_color_mode() & light::ColorCapability::ON_OFF))
+    writer.add("state", obj->remote_values.is_on() ? "ON" : "OFF");
+
+  light::LightJSONSchema::dump_json(*obj, writer);
+  if (start_config == DETAIL_ALL) {
+    writer.begin_array("effects");
+    writer.value("None");
+    for (auto const &option : obj->get_effects()) {
+      writer.value(option->get_name());
     }
-  });
+    writer.end_array();
+  }
+  writer.end_object();
+  return buffer;
 }
 #endif
 
 #ifdef USE_COVER
 void WebServer::on_cover_update(cover::Cover *obj) {
-  this->events_.send(this->cover_json(obj, DETAIL_STATE).c_str(), "state");
+  this->queue_state_(obj, StateEventType::COVER);
 }
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (cover::Cover *obj : App.get_covers()) {
@@ -736,8 +774,8 @@ void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMa
       continue;
 
     if (request->method() == HTTP_GET) {
-      std::string data = this->cover_json(obj, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
+      std::string data;
+      request->send(200, "application/json", this->cover_json(obj, DETAIL_STATE, data).c_str());
       continue;
     }
 
@@ -779,21 +817,23 @@ void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMa
   }
   request->send(404);
 }
-std::string WebServer::cover_json(cover::Cover *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "cover-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
-                              obj->position, start_config);
-    root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
-
-    if (obj->get_traits().get_supports_tilt())
-      root["tilt"] = obj->tilt;
-  });
+const std::string &WebServer::cover_json(cover::Cover *obj, JsonDetail start_config, std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  set_json_icon_state_value(writer, obj, "cover-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
+                            obj->position, start_config);
+  writer.add("current_operation", cover::cover_operation_to_str(obj->current_operation));
+
+  if (obj->get_traits().get_supports_tilt())
+    writer.add("tilt", obj->tilt);
+  writer.end_object();
+  return buffer;
 }
 #endif
 
 #ifdef USE_NUMBER
 void WebServer::on_number_update(number::Number *obj, float state) {
-  this->events_.send(this->number_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_(obj, StateEventType::NUMBER);
 }
 void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_numbers()) {
@@ -801,8 +841,8 @@ void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlM
       continue;
 
     if (request->method() == HTTP_GET) {
-      std::string data = this->number_json(obj, obj->state, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
+      std::string data;
+      request->send(200, "application/json", this->number_json(obj, obj->state, DETAIL_STATE, data).c_str());
       return;
     }
     if (match.method != "set") {
@@ -824,34 +864,37 @@ void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 
-std::string WebServer::number_json(number::Number *obj, float value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_id(root, obj, "number-" + obj->get_object_id(), start_config);
-    if (start_config == DETAIL_ALL) {
-      root["min_value"] = obj->traits.get_min_value();
-      root["max_value"] = obj->traits.get_max_value();
-      root["step"] = obj->traits.get_step();
-      root["mode"] = (int) obj->traits.get_mode();
-      if (!obj->traits.get_unit_of_measurement().empty())
-        root["uom"] = obj->traits.get_unit_of_measurement();
-    }
-    if (std::isnan(value)) {
-      root["value"] = "\"NaN\"";
-      root["state"] = "NA";
-    } else {
-      root["value"] = value;
-      std::string state = value_accuracy_to_string(value, step_to_accuracy_decimals(obj->traits.get_step()));
-      if (!obj->traits.get_unit_of_measurement().empty())
-        state += " " + obj->traits.get_unit_of_measurement();
-      root["state"] = state;
-    }
-  });
+const std::string &WebServer::number_json(number::Number *obj, float value, JsonDetail start_config,
+                                          std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  set_json_id(writer, obj, "number-" + obj->get_object_id(), start_config);
+  if (start_config == DETAIL_ALL) {
+    writer.add("min_value", obj->traits.get_min_value());
+    writer.add("max_value", obj->traits.get_max_value());
+    writer.add("step", obj->traits.get_step());
+    writer.add("mode", (int) obj->traits.get_mode());
+    if (!obj->traits.get_unit_of_measurement().empty())
+      writer.add("uom", obj->traits.get_unit_of_measurement());
+  }
+  if (std::isnan(value)) {
+    writer.add("value", "\"NaN\"");
+    writer.add("state", "NA");
+  } else {
+    writer.add("value", value);
+    std::string state = value_accuracy_to_string(value, step_to_accuracy_decimals(obj->traits.get_step()));
+    if (!obj->traits.get_unit_of_measurement().empty())
+      state += " " + obj->traits.get_unit_of_measurement();
+    writer.add("state", state);
+  }
+  writer.end_object();
+  return buffer;
 }
 #endif
 
 #ifdef USE_TEXT
 void WebServer::on_text_update(text::Text *obj, const std::string &state) {
-  this->events_.send(this->text_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_(obj, StateEventType::TEXT);
 }
 void WebServer::handle_text_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_texts()) {
@@ -859,8 +902,8 @@ void WebServer::handle_text_request(AsyncWebServerRequest *request, const UrlMat
       continue;
 
     if (request->method() == HTTP_GET) {
-      std::string data = this->text_json(obj, obj->state, DETAIL_STATE);
-      request->send(200, "text/json", data.c_str());
+      std::string data;
+      request->send(200, "text/json", this->text_json(obj, obj->state, DETAIL_STATE, data).c_str());
       return;
     }
     if (match.method != "set") {
@@ -881,28 +924,31 @@ void WebServer::handle_text_request(AsyncWebServerRequest *request, const UrlMat
   request->send(404);
 }
 
-std::string WebServer::text_json(text::Text *obj, const std::string &value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_id(root, obj, "text-" + obj->get_object_id(), start_config);
-    if (start_config == DETAIL_ALL) {
-      root["mode"] = (int) obj->traits.get_mode();
-    }
-    root["min_length"] = obj->traits.get_min_length();
-    root["max_length"] = obj->traits.get_max_length();
-    root["pattern"] = obj->traits.get_pattern();
-    if (obj->traits.get_mode() == text::TextMode::TEXT_MODE_PASSWORD) {
-      root["state"] = "********";
-    } else {
-      root["state"] = value;
-    }
-    root["value"] = value;
-  });
+const std::string &WebServer::text_json(text::Text *obj, const std::string &value, JsonDetail start_config,
+                                        std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  set_json_id(writer, obj, "text-" + obj->get_object_id(), start_config);
+  if (start_config == DETAIL_ALL) {
+    writer.add("mode", (int) obj->traits.get_mode());
+  }
+  writer.add("min_length", obj->traits.get_min_length());
+  writer.add("max_length", obj->traits.get_max_length());
+  writer.add("pattern", obj->traits.get_pattern());
+  if (obj->traits.get_mode() == text::TextMode::TEXT_MODE_PASSWORD) {
+    writer.add("state", "********");
+  } else {
+    writer.add("state", value);
+  }
+  writer.add("value", value);
+  writer.end_object();
+  return buffer;
 }
 #endif
 
 #ifdef USE_SELECT
 void WebServer::on_select_update(select::Select *obj, const std::string &state, size_t index) {
-  this->events_.send(this->select_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_(obj, StateEventType::SELECT);
 }
 void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_selects()) {
@@ -915,8 +961,8 @@ void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlM
       if (param && param->value() == "all") {
         detail = DETAIL_ALL;
       }
-      std::string data = this->select_json(obj, obj->state, detail);
-      request->send(200, "application/json", data.c_str());
+      std::string data;
+      request->send(200, "application/json", this->select_json(obj, obj->state, detail, data).c_str());
       return;
     }
 
@@ -938,16 +984,20 @@ void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlM
   }
   request->send(404);
 }
-std::string WebServer::select_json(select::Select *obj, const std::string &value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "select-" + obj->get_object_id(), value, value, start_config);
-    if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("option");
-      for (auto &option : obj->traits.get_options()) {
-        opt.add(option);
-      }
+const std::string &WebServer::select_json(select::Select *obj, const std::string &value, JsonDetail start_config,
+                                          std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  set_json_icon_state_value(writer, obj, "select-" + obj->get_object_id(), value, value, start_config);
+  if (start_config == DETAIL_ALL) {
+    writer.begin_array("option");
+    for (auto &option : obj->traits.get_options()) {
+      writer.value(option);
     }
-  });
+    writer.end_array();
+  }
+  writer.end_object();
+  return buffer;
 }
 #endif
 
@@ -956,7 +1006,7 @@ std::string WebServer::select_json(select::Select *obj, const std::string &value
 
 #ifdef USE_CLIMATE
 void WebServer::on_climate_update(climate::Climate *obj) {
-  this->events_.send(this->climate_json(obj, DETAIL_STATE).c_str(), "state");
+  this->queue_state_(obj, StateEventType::CLIMATE);
 }
 
 void WebServer::handle_climate_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -965,8 +1015,8 @@ void WebServer::handle_climate_request(AsyncWebServerRequest *request, const Url
       continue;
 
     if (request->method() == HTTP_GET) {
-      std::string data = this->climate_json(obj, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
+      std::string data;
+      request->send(200, "application/json", this->climate_json(obj, DETAIL_STATE, data).c_str());
       return;
     }
 
@@ -1007,103 +1057,115 @@ void WebServer::handle_climate_request(AsyncWebServerRequest *request, const Url
   request->send(404);
 }
 
-std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "climate-" + obj->get_object_id(), start_config);
-    const auto traits = obj->get_traits();
-    int8_t target_accuracy = traits.get_target_temperature_accuracy_decimals();
-    int8_t current_accuracy = traits.get_current_temperature_accuracy_decimals();
-    char buf[16];
-
-    if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("modes");
-      for (climate::ClimateMode m : traits.get_supported_modes())
-        opt.add(PSTR_LOCAL(climate::climate_mode_to_string(m)));
-      if (!traits.get_supported_custom_fan_modes().empty()) {
-        JsonArray opt = root.createNestedArray("fan_modes");
-        for (climate::ClimateFanMode m : traits.get_supported_fan_modes())
-          opt.add(PSTR_LOCAL(climate::climate_fan_mode_to_string(m)));
-      }
-
-      if (!traits.get_supported_custom_fan_modes().empty()) {
-        JsonArray opt = root.createNestedArray("custom_fan_modes");
-        for (auto const &custom_fan_mode : traits.get_supported_custom_fan_modes())
-          opt.add(custom_fan_mode);
-      }
-      if (traits.get_supports_swing_modes()) {
-        JsonArray opt = root.createNestedArray("swing_modes");
-        for (auto swing_mode : traits.get_supported_swing_modes())
-          opt.add(PSTR_LOCAL(climate::climate_swing_mode_to_string(swing_mode)));
-      }
-      if (traits.get_supports_presets() && obj->preset.has_value()) {
-        JsonArray opt = root.createNestedArray("presets");
-        for (climate::ClimatePreset m : traits.get_supported_presets())
-          opt.add(PSTR_LOCAL(climate::climate_preset_to_string(m)));
-      }
-      if (!traits.get_supported_custom_presets().empty() && obj->custom_preset.has_value()) {
-        JsonArray opt = root.createNestedArray("custom_presets");
-        for (auto const &custom_preset : traits.get_supported_custom_presets())
-          opt.add(custom_preset);
-      }
+const std::string &WebServer::climate_json(climate::Climate *obj, JsonDetail start_config, std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  set_json_id(writer, obj, "climate-" + obj->get_object_id(), start_config);
+  const auto traits = obj->get_traits();
+  int8_t target_accuracy = traits.get_target_temperature_accuracy_decimals();
+  int8_t current_accuracy = traits.get_current_temperature_accuracy_decimals();
+  char buf[16];
+
+  if (start_config == DETAIL_ALL) {
+    writer.begin_array("modes");
+    for (climate::ClimateMode m : traits.get_supported_modes())
+      writer.value(PSTR_LOCAL(climate::climate_mode_to_string(m)));
+    writer.end_array();
+    if (!traits.get_supported_custom_fan_modes().empty()) {
+      writer.begin_array("fan_modes");
+      for (climate::ClimateFanMode m : traits.get_supported_fan_modes())
+        writer.value(PSTR_LOCAL(climate::climate_fan_mode_to_string(m)));
+      writer.end_array();
     }
 
-    bool has_state = false;
-    root["mode"] = PSTR_LOCAL(climate_mode_to_string(obj->mode));
-    root["max_temp"] = value_accuracy_to_string(traits.get_visual_max_temperature(), target_accuracy);
-    root["min_temp"] = value_accuracy_to_string(traits.get_visual_min_temperature(), target_accuracy);
-    root["step"] = traits.get_visual_target_temperature_step();
-    if (traits.get_supports_action()) {
-      root["action"] = PSTR_LOCAL(climate_action_to_string(obj->action));
-      root["state"] = root["action"];
-      has_state = true;
+    if (!traits.get_supported_custom_fan_modes().empty()) {
+      writer.begin_array("custom_fan_modes");
+      for (auto const &custom_fan_mode : traits.get_supported_custom_fan_modes())
+        writer.value(custom_fan_mode);
+      writer.end_array();
     }
-    if (traits.get_supports_fan_modes() && obj->fan_mode.has_value()) {
-      root["fan_mode"] = PSTR_LOCAL(climate_fan_mode_to_string(obj->fan_mode.value()));
-    }
-    if (!traits.get_supported_custom_fan_modes().empty() && obj->custom_fan_mode.has_value()) {
-      root["custom_fan_mode"] = obj->custom_fan_mode.value().c_str();
+    if (traits.get_supports_swing_modes()) {
+      writer.begin_array("swing_modes");
+      for (auto swing_mode : traits.get_supported_swing_modes())
+        writer.value(PSTR_LOCAL(climate::climate_swing_mode_to_string(swing_mode)));
+      writer.end_array();
     }
     if (traits.get_supports_presets() && obj->preset.has_value()) {
-      root["preset"] = PSTR_LOCAL(climate_preset_to_string(obj->preset.value()));
+      writer.begin_array("presets");
+      for (climate::ClimatePreset m : traits.get_supported_presets())
+        writer.value(PSTR_LOCAL(climate::climate_preset_to_string(m)));
+      writer.end_array();
     }
     if (!traits.get_supported_custom_presets().empty() && obj->custom_preset.has_value()) {
-      root["custom_preset"] = obj->custom_preset.value().c_str();
-    }
-    if (traits.get_supports_swing_modes()) {
-      root["swing_mode"] = PSTR_LOCAL(climate_swing_mode_to_string(obj->swing_mode));
-    }
-    if (traits.get_supports_current_temperature()) {
-      if (!std::isnan(obj->current_temperature)) {
-        root["current_temperature"] = value_accuracy_to_string(obj->current_temperature, current_accuracy);
-      } else {
-        root["current_temperature"] = "NA";
-      }
+      writer.begin_array("custom_presets");
+      for (auto const &custom_preset : traits.get_supported_custom_presets())
+        writer.value(custom_preset);
+      writer.end_array();
     }
-    if (traits.get_supports_two_point_target_temperature()) {
-      root["target_temperature_low"] = value_accuracy_to_string(obj->target_temperature_low, target_accuracy);
-      root["target_temperature_high"] = value_accuracy_to_string(obj->target_temperature_high, target_accuracy);
-      if (!has_state) {
-        root["state"] = value_accuracy_to_string((obj->target_temperature_high + obj->target_temperature_low) / 2.0f,
-                                                 target_accuracy);
-      }
+  }
+
+  bool has_state = false;
+  writer.add("mode", PSTR_LOCAL(climate_mode_to_string(obj->mode)));
+  writer.add("max_temp", value_accuracy_to_string(traits.get_visual_max_temperature(), target_accuracy));
+  writer.add("min_temp", value_accuracy_to_string(traits.get_visual_min_temperature(), target_accuracy));
+  writer.add("step", traits.get_visual_target_temperature_step());
+  if (traits.get_supports_action()) {
+    writer.add("action", PSTR_LOCAL(climate_action_to_string(obj->action)));
+    writer.add("state", buf);
+    has_state = true;
+  }
+  if (traits.get_supports_fan_modes() && obj->fan_mode.has_value()) {
+    writer.add("fan_mode", PSTR_LOCAL(climate_fan_mode_to_string(obj->fan_mode.value())));
+  }
+  if (!traits.get_supported_custom_fan_modes().empty() && obj->custom_fan_mode.has_value()) {
+    writer.add("custom_fan_mode", obj->custom_fan_mode.value());
+  }
+  if (traits.get_supports_presets() && obj->preset.has_value()) {
+    writer.add("preset", PSTR_LOCAL(climate_preset_to_string(obj->preset.value())));
+  }
+  if (!traits.get_supported_custom_presets().empty() && obj->custom_preset.has_value()) {
+    writer.add("custom_preset", obj->custom_preset.value());
+  }
+  if (traits.get_supports_swing_modes()) {
+    writer.add("swing_mode", PSTR_LOCAL(climate_swing_mode_to_string(obj->swing_mode)));
+  }
+  if (traits.get_supports_current_temperature()) {
+    if (!std::isnan(obj->current_temperature)) {
+      writer.add("current_temperature", value_accuracy_to_string(obj->current_temperature, current_accuracy));
     } else {
-      root["target_temperature"] = value_accuracy_to_string(obj->target_temperature, target_accuracy);
-      if (!has_state)
-        root["state"] = root["target_temperature"];
+      writer.add("current_temperature", "NA");
     }
-  });
+  }
+  if (traits.get_supports_two_point_target_temperature()) {
+    writer.add("target_temperature_low", value_accuracy_to_string(obj->target_temperature_low, target_accuracy));
+    writer.add("target_temperature_high", value_accuracy_to_string(obj->target_temperature_high, target_accuracy));
+    if (!has_state) {
+      writer.add("state", value_accuracy_to_string((obj->target_temperature_high + obj->target_temperature_low) / 2.0f,
+                                                   target_accuracy));
+    }
+  } else {
+    std::string target_temperature = value_accuracy_to_string(obj->target_temperature, target_accuracy);
+    writer.add("target_temperature", target_temperature);
+    if (!has_state)
+      writer.add("state", target_temperature);
+  }
+  writer.end_object();
+  return buffer;
 }
 #endif
 
 #ifdef USE_LOCK
 void WebServer::on_lock_update(lock::Lock *obj) {
-  this->events_.send(this->lock_json(obj, obj->state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_(obj, StateEventType::LOCK);
 }
-std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "lock-" + obj->get_object_id(), lock::lock_state_to_string(value), value,
-                              start_config);
-  });
+const std::string &WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDetail start_config,
+                                        std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  set_json_icon_state_value(writer, obj, "lock-" + obj->get_object_id(), lock::lock_state_to_string(value), value,
+                            start_config);
+  writer.end_object();
+  return buffer;
 }
 void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (lock::Lock *obj : App.get_locks()) {
@@ -1111,8 +1173,8 @@ void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMat
       continue;
 
     if (request->method() == HTTP_GET) {
-      std::string data = this->lock_json(obj, obj->state, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
+      std::string data;
+      request->send(200, "application/json", this->lock_json(obj, obj->state, DETAIL_STATE, data).c_str());
     } else if (match.method == "lock") {
       this->schedule_([obj]() { obj->lock(); });
       request->send(200);
@@ -1133,16 +1195,18 @@ void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMat
 
 #ifdef USE_ALARM_CONTROL_PANEL
 void WebServer::on_alarm_control_panel_update(alarm_control_panel::AlarmControlPanel *obj) {
-  this->events_.send(this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE).c_str(), "state");
+  this->queue_state_(obj, StateEventType::ALARM_CONTROL_PANEL);
 }
-std::string WebServer::alarm_control_panel_json(alarm_control_panel::AlarmControlPanel *obj,
-                                                alarm_control_panel::AlarmControlPanelState value,
-                                                JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
-    char buf[16];
-    set_json_icon_state_value(root, obj, "alarm-control-panel-" + obj->get_object_id(),
-                              PSTR_LOCAL(alarm_control_panel_state_to_string(value)), value, start_config);
-  });
+const std::string &WebServer::alarm_control_panel_json(alarm_control_panel::AlarmControlPanel *obj,
+                                                       alarm_control_panel::AlarmControlPanelState value,
+                                                       JsonDetail start_config, std::string &buffer) {
+  json::JsonWriter writer(buffer);
+  writer.begin_object();
+  char buf[16];
+  set_json_icon_state_value(writer, obj, "alarm-control-panel-" + obj->get_object_id(),
+                            PSTR_LOCAL(alarm_control_panel_state_to_string(value)), value, start_config);
+  writer.end_object();
+  return buffer;
 }
 void WebServer::handle_alarm_control_panel_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (alarm_control_panel::AlarmControlPanel *obj : App.get_alarm_control_panels()) {
@@ -1150,7 +1214,8 @@ void WebServer::handle_alarm_control_panel_request(AsyncWebServerRequest *reques
       continue;
 
     if (request->method() == HTTP_GET) {
-      std::string data = this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE);
+      std::string data;
+      this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE, data);
       request->send(200, "application/json", data.c_str());
       return;
     }
@@ -1401,5 +1466,131 @@ void WebServer::schedule_(std::function<void()> &&f) {
 #endif
 }
 
+void WebServer::queue_state_(EntityBase *obj, StateEventType type) {
+  // clients that connect later get the current state from the entity list
+  if (this->events_.count() == 0)
+    return;
+  for (auto &pending : this->pending_states_) {
+    if (pending.obj == obj)
+      return;
+  }
+  this->pending_states_.push_back(PendingState{obj, type});
+}
+
+void WebServer::flush_states_() {
+  this->last_state_flush_ = millis();
+  if (this->events_.count() == 0) {
+    this->pending_states_.clear();
+    return;
+  }
+  // keep coalescing while the clients can't keep up, rather than queueing even more events for them
+  if (this->events_.avgPacketsWaiting() > MAX_EVENTS_WAITING)
+    return;
+
+  size_t sent = 0, bytes = 0;
+  while (sent < this->pending_states_.size() && bytes < STATE_FLUSH_MAX_BYTES) {
+    this->state_json_(this->pending_states_[sent++]);
+    this->events_.send(this->json_buffer_.c_str(), "state");
+    bytes += this->json_buffer_.size();
+  }
+  this->pending_states_.erase(this->pending_states_.begin(), this->pending_states_.begin() + sent);
+}
+
+void WebServer::state_json_(const PendingState &pending) {
+  switch (pending.type) {
+#ifdef USE_SENSOR
+    case StateEventType::SENSOR: {
+      auto *obj = static_cast<sensor::Sensor *>(pending.obj);
+      this->sensor_json(obj, obj->state, DETAIL_STATE, this->json_buffer_);
+      break;
+    }
+#endif
+#ifdef USE_SWITCH
+    case StateEventType::SWITCH: {
+      auto *obj = static_cast<switch_::Switch *>(pending.obj);
+      this->switch_json(obj, obj->state, DETAIL_STATE, this->json_buffer_);
+      break;
+    }
+#endif
+#ifdef USE_BINARY_SENSOR
+    case StateEventType::BINARY_SENSOR: {
+      auto *obj = static_cast<binary_sensor::BinarySensor *>(pending.obj);
+      this->binary_sensor_json(obj, obj->state, DETAIL_STATE, this->json_buffer_);
+      break;
+    }
+#endif
+#ifdef USE_FAN
+    case StateEventType::FAN: {
+      auto *obj = static_cast<fan::Fan *>(pending.obj);
+      this->fan_json(obj, DETAIL_STATE, this->json_buffer_);
+      break;
+    }
+#endif
+#ifdef USE_LIGHT
+    case StateEventType::LIGHT: {
+      auto *obj = static_cast<light::LightState *>(pending.obj);
+      this->light_json(obj, DETAIL_STATE, this->json_buffer_);
+      break;
+    }
+#endif
+#ifdef USE_TEXT_SENSOR
+    case StateEventType::TEXT_SENSOR: {
+      auto *obj = static_cast<text_sensor::TextSensor *>(pending.obj);
+      this->text_sensor_json(obj, obj->state, DETAIL_STATE, this->json_buffer_);
+      break;
+    }
+#endif
+#ifdef USE_COVER
+    case StateEventType::COVER: {
+      auto *obj = static_cast<cover::Cover *>(pending.obj);
+      this->cover_json(obj, DETAIL_STATE, this->json_buffer_);
+      break;
+    }
+#endif
+#ifdef USE_NUMBER
+    case StateEventType::NUMBER: {
+      auto *obj = static_cast<number::Number *>(pending.obj);
+      this->number_json(obj, obj->state, DETAIL_STATE, this->json_buffer_);
+      break;
+    }
+#endif
+#ifdef USE_TEXT
+    case StateEventType::TEXT: {
+      auto *obj = static_cast<text::Text *>(pending.obj);
+      this->text_json(obj, obj->state, DETAIL_STATE, this->json_buffer_);
+      break;
+    }
+#endif
+#ifdef USE_SELECT
+    case StateEventType::SELECT: {
+      auto *obj = static_cast<select::Select *>(pending.obj);
+      this->select_json(obj, obj->state, DETAIL_STATE, this->json_buffer_);
+      break;
+    }
+#endif
+#ifdef USE_CLIMATE
+    case StateEventType::CLIMATE: {
+      auto *obj = static_cast<climate::Climate *>(pending.obj);
+      this->climate_json(obj, DETAIL_STATE, this->json_buffer_);
+      break;
+    }
+#endif
+#ifdef USE_LOCK
+    case StateEventType::LOCK: {
+      auto *obj = static_cast<lock::Lock *>(pending.obj);
+      this->lock_json(obj, obj->state, DETAIL_STATE, this->json_buffer_);
+      break;
+    }
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+    case StateEventType::ALARM_CONTROL_PANEL: {
+      auto *obj = static_cast<alarm_control_panel::AlarmControlPanel *>(pending.obj);
+      this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE, this->json_buffer_);
+      break;
+    }
+#endif
+  }
+}
+
 }  // namespace web_server
 }  // namespace esphome
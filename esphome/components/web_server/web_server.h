@@ -41,6 +41,49 @@ struct UrlMatch {
 
 enum JsonDetail { DETAIL_ALL, DETAIL_STATE };
 
+/// The kind of entity whose state is waiting to be pushed to the event stream.
+enum class StateEventType : uint8_t {
+#ifdef USE_SENSOR
+  SENSOR,
+#endif
+#ifdef USE_SWITCH
+  SWITCH,
+#endif
+#ifdef USE_BINARY_SENSOR
+  BINARY_SENSOR,
+#endif
+#ifdef USE_FAN
+  FAN,
+#endif
+#ifdef USE_LIGHT
+  LIGHT,
+#endif
+#ifdef USE_TEXT_SENSOR
+  TEXT_SENSOR,
+#endif
+#ifdef USE_COVER
+  COVER,
+#endif
+#ifdef USE_NUMBER
+  NUMBER,
+#endif
+#ifdef USE_TEXT
+  TEXT,
+#endif
+#ifdef USE_SELECT
+  SELECT,
+#endif
+#ifdef USE_CLIMATE
+  CLIMATE,
+#endif
+#ifdef USE_LOCK
+  LOCK,
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+  ALARM_CONTROL_PANEL,
+#endif
+};
+
 /** This class allows users to create a web server with their ESP nodes.
  *
  * Behind the scenes it's using AsyncWebServer to set up the server. It exposes 3 things:
@@ -140,8 +183,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a sensor request under '/sensor/<id>'.
   void handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the sensor state with its value as a JSON string.
-  std::string sensor_json(sensor::Sensor *obj, float value, JsonDetail start_config);
+  /// Dump the sensor state with its value as a JSON string into \p buffer, and return it.
+  const std::string &sensor_json(sensor::Sensor *obj, float value, JsonDetail start_config, std::string &buffer);
 #endif
 
 #ifdef USE_SWITCH
@@ -150,16 +193,16 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a switch request under '/switch/<id>/</turn_on/turn_off/toggle>'.
   void handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the switch state with its value as a JSON string.
-  std::string switch_json(switch_::Switch *obj, bool value, JsonDetail start_config);
+  /// Dump the switch state with its value as a JSON string into \p buffer, and return it.
+  const std::string &switch_json(switch_::Switch *obj, bool value, JsonDetail start_config, std::string &buffer);
 #endif
 
 #ifdef USE_BUTTON
   /// Handle a button request under '/button/<id>/press'.
   void handle_button_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the button details with its value as a JSON string.
-  std::string button_json(button::Button *obj, JsonDetail start_config);
+  /// Dump the button details with its value as a JSON string into \p buffer, and return it.
+  const std::string &button_json(button::Button *obj, JsonDetail start_config, std::string &buffer);
 #endif
 
 #ifdef USE_BINARY_SENSOR
@@ -168,8 +211,9 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a binary sensor request under '/binary_sensor/<id>'.
   void handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the binary sensor state with its value as a JSON string.
-  std::string binary_sensor_json(binary_sensor::BinarySensor *obj, bool value, JsonDetail start_config);
+  /// Dump the binary sensor state with its value as a JSON string into \p buffer, and return it.
+  const std::string &binary_sensor_json(binary_sensor::BinarySensor *obj, bool value, JsonDetail start_config,
+                                        std::string &buffer);
 #endif
 
 #ifdef USE_FAN
@@ -178,8 +222,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a fan request under '/fan/<id>/</turn_on/turn_off/toggle>'.
   void handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the fan state as a JSON string.
-  std::string fan_json(fan::Fan *obj, JsonDetail start_config);
+  /// Dump the fan state as a JSON string into \p buffer, and return it.
+  const std::string &fan_json(fan::Fan *obj, JsonDetail start_config, std::string &buffer);
 #endif
 
 #ifdef USE_LIGHT
@@ -188,8 +232,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a light request under '/light/<id>/</turn_on/turn_off/toggle>'.
   void handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the light state as a JSON string.
-  std::string light_json(light::LightState *obj, JsonDetail start_config);
+  /// Dump the light state as a JSON string into \p buffer, and return it.
+  const std::string &light_json(light::LightState *obj, JsonDetail start_config, std::string &buffer);
 #endif
 
 #ifdef USE_TEXT_SENSOR
@@ -198,8 +242,9 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a text sensor request under '/text_sensor/<id>'.
   void handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the text sensor state with its value as a JSON string.
-  std::string text_sensor_json(text_sensor::TextSensor *obj, const std::string &value, JsonDetail start_config);
+  /// Dump the text sensor state with its value as a JSON string into \p buffer, and return it.
+  const std::string &text_sensor_json(text_sensor::TextSensor *obj, const std::string &value, JsonDetail start_config,
+                                      std::string &buffer);
 #endif
 
 #ifdef USE_COVER
@@ -208,8 +253,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a cover request under '/cover/<id>/<open/close/stop/set>'.
   void handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the cover state as a JSON string.
-  std::string cover_json(cover::Cover *obj, JsonDetail start_config);
+  /// Dump the cover state as a JSON string into \p buffer, and return it.
+  const std::string &cover_json(cover::Cover *obj, JsonDetail start_config, std::string &buffer);
 #endif
 
 #ifdef USE_NUMBER
@@ -217,8 +262,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a number request under '/number/<id>'.
   void handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the number state with its value as a JSON string.
-  std::string number_json(number::Number *obj, float value, JsonDetail start_config);
+  /// Dump the number state with its value as a JSON string into \p buffer, and return it.
+  const std::string &number_json(number::Number *obj, float value, JsonDetail start_config, std::string &buffer);
 #endif
 
 #ifdef USE_TEXT
@@ -226,8 +271,9 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a text input request under '/text/<id>'.
   void handle_text_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the text state with its value as a JSON string.
-  std::string text_json(text::Text *obj, const std::string &value, JsonDetail start_config);
+  /// Dump the text state with its value as a JSON string into \p buffer, and return it.
+  const std::string &text_json(text::Text *obj, const std::string &value, JsonDetail start_config,
+                               std::string &buffer);
 #endif
 
 #ifdef USE_SELECT
@@ -235,8 +281,9 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a select request under '/select/<id>'.
   void handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the select state with its value as a JSON string.
-  std::string select_json(select::Select *obj, const std::string &value, JsonDetail start_config);
+  /// Dump the select state with its value as a JSON string into \p buffer, and return it.
+  const std::string &select_json(select::Select *obj, const std::string &value, JsonDetail start_config,
+                                 std::string &buffer);
 #endif
 
 #ifdef USE_CLIMATE
@@ -244,8 +291,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a climate request under '/climate/<id>'.
   void handle_climate_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the climate details
-  std::string climate_json(climate::Climate *obj, JsonDetail start_config);
+  /// Dump the climate details into \p buffer, and return it.
+  const std::string &climate_json(climate::Climate *obj, JsonDetail start_config, std::string &buffer);
 #endif
 
 #ifdef USE_LOCK
@@ -254,8 +301,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a lock request under '/lock/<id>/</lock/unlock/open>'.
   void handle_lock_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the lock state with its value as a JSON string.
-  std::string lock_json(lock::Lock *obj, lock::LockState value, JsonDetail start_config);
+  /// Dump the lock state with its value as a JSON string into \p buffer, and return it.
+  const std::string &lock_json(lock::Lock *obj, lock::LockState value, JsonDetail start_config, std::string &buffer);
 #endif
 
 #ifdef USE_ALARM_CONTROL_PANEL
@@ -264,9 +311,10 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a alarm_control_panel request under '/alarm_control_panel/<id>'.
   void handle_alarm_control_panel_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the alarm_control_panel state with its value as a JSON string.
-  std::string alarm_control_panel_json(alarm_control_panel::AlarmControlPanel *obj,
-                                       alarm_control_panel::AlarmControlPanelState value, JsonDetail start_config);
+  /// Dump the alarm_control_panel state with its value as a JSON string into \p buffer, and return it.
+  const std::string &alarm_control_panel_json(alarm_control_panel::AlarmControlPanel *obj,
+                                              alarm_control_panel::AlarmControlPanelState value,
+                                              JsonDetail start_config, std::string &buffer);
 #endif
 
   /// Override the web handler's canHandle method.
@@ -277,10 +325,31 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   bool isRequestHandlerTrivial() override;
 
  protected:
+  struct PendingState {
+    EntityBase *obj;
+    StateEventType type;
+  };
+
   void schedule_(std::function<void()> &&f);
+  /// Mark the state of an entity as changed, it's pushed to the clients by flush_states_().
+  void queue_state_(EntityBase *obj, StateEventType type);
+  /// Push the current state of the queued entities, as far as the clients and the bandwidth budget allow.
+  void flush_states_();
+  /// Build the state event of a queued entity into json_buffer_.
+  void state_json_(const PendingState &pending);
+
   friend ListEntitiesIterator;
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
+  /// Reused for the JSON of all state events, which are only built in the main loop.
+  std::string json_buffer_;
+  /** Entities whose state changed since it was last pushed, in the order they first changed.
+   *
+   * An entity is in here at most once, so an entity that updates faster than the events are flushed only has its
+   * latest state sent, and a burst of updates can't grow the queue beyond the number of entities.
+   */
+  std::vector<PendingState> pending_states_;
+  uint32_t last_state_flush_{0};
   ListEntitiesIterator entities_iterator_;
 #if USE_WEBSERVER_VERSION == 1
   const char *css_url_{nullptr};
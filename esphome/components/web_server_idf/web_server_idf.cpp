@@ -1,6 +1,7 @@
 #ifdef USE_ESP_IDF
 
 #include <cstdarg>
+#include <sys/socket.h>
 
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
@@ -21,6 +22,9 @@ namespace web_server_idf {
 
 static const char *const TAG = "web_server_idf";
 
+/// Maximum size of the events queued for a client before new ones are dropped.
+static const size_t MAX_EVENTS_PENDING_SIZE = 8192;
+
 void AsyncWebServer::end() {
   if (this->server_) {
     httpd_stop(this->server_);
@@ -306,6 +310,22 @@ void AsyncEventSource::send(const char *message, const char *event, uint32_t id,
   }
 }
 
+void AsyncEventSource::flush() {
+  for (auto *ses : this->sessions_) {
+    ses->flush();
+  }
+}
+
+size_t AsyncEventSource::avgPacketsWaiting() const {
+  if (this->sessions_.empty())
+    return 0;
+  size_t waiting = 0;
+  for (auto *ses : this->sessions_) {
+    waiting += ses->get_events_waiting();
+  }
+  return waiting / this->sessions_.size();
+}
+
 AsyncEventSourceResponse::AsyncEventSourceResponse(const AsyncWebServerRequest *request, AsyncEventSource *server)
     : server_(server) {
   httpd_req_t *req = *request;
@@ -371,15 +391,33 @@ void AsyncEventSourceResponse::send(const char *message, const char *event, uint
 
   ev.append(CRLF_STR, CRLF_LEN);
 
-  // Sending chunked content prelude
+  // Chunked content prelude, content chunk and end of chunk
   auto cs = str_snprintf("%x" CRLF_STR, 4 * sizeof(ev.size()) + CRLF_LEN, ev.size());
-  httpd_socket_send(this->hd_, this->fd_, cs.c_str(), cs.size(), 0);
-
-  // Sendiing content chunk
-  httpd_socket_send(this->hd_, this->fd_, ev.c_str(), ev.size(), 0);
+  if (this->pending_.size() + cs.size() + ev.size() + CRLF_LEN > MAX_EVENTS_PENDING_SIZE) {
+    // the client isn't reading, drop whole events so the stream stays intact
+    ESP_LOGV(TAG, "Event dropped, client is too slow");
+    return;
+  }
+  this->pending_.append(cs);
+  this->pending_.append(ev);
+  this->pending_.append(CRLF_STR, CRLF_LEN);
+  this->events_waiting_++;
+  this->flush();
+}
 
-  // Indicate end of chunk
-  httpd_socket_send(this->hd_, this->fd_, CRLF_STR, CRLF_LEN, 0);
+void AsyncEventSourceResponse::flush() {
+  size_t sent = 0;
+  while (sent < this->pending_.size()) {
+    int ret = httpd_socket_send(this->hd_, this->fd_, this->pending_.data() + sent, this->pending_.size() - sent,
+                                MSG_DONTWAIT);
+    // the socket buffer is full, or the connection is broken and the session is about to be closed
+    if (ret <= 0)
+      break;
+    sent += ret;
+  }
+  this->pending_.erase(0, sent);
+  if (this->pending_.empty())
+    this->events_waiting_ = 0;
 }
 
 }  // namespace web_server_idf
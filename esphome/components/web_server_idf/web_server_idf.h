@@ -217,7 +217,12 @@ class AsyncEventSourceResponse {
   friend class AsyncEventSource;
 
  public:
+  /// Queue an event and send as much as the socket takes without blocking, events that don't fit are dropped.
   void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+  /// Send as much of the queued events as the socket takes without blocking.
+  void flush();
+  /// Number of events that are (partly) waiting to be sent.
+  size_t get_events_waiting() const { return this->events_waiting_; }
 
  protected:
   AsyncEventSourceResponse(const AsyncWebServerRequest *request, AsyncEventSource *server);
@@ -225,6 +230,9 @@ class AsyncEventSourceResponse {
   AsyncEventSource *server_;
   httpd_handle_t hd_{};
   int fd_{};
+  /// Encoded events that the socket didn't take yet, so a slow client never blocks the sender.
+  std::string pending_;
+  size_t events_waiting_{0};
 };
 
 using AsyncEventSourceClient = AsyncEventSourceResponse;
@@ -247,6 +255,13 @@ class AsyncEventSource : public AsyncWebHandler {
   void onConnect(connect_handler_t cb) { this->on_connect_ = std::move(cb); }
 
   void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+  /// Send as much of the events queued for each client as their sockets take without blocking.
+  void flush();
+
+  size_t count() const { return this->sessions_.size(); }
+  /// Average number of events waiting to be sent per client, like the Arduino AsyncEventSource.
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  size_t avgPacketsWaiting() const;
 
  protected:
   std::string url_;
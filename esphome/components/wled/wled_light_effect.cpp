@@ -42,9 +42,7 @@ void WLEDLightEffect::stop() {
 }
 
 void WLEDLightEffect::blank_all_leds_(light::AddressableLight &it) {
-  for (int led = it.size(); led-- > 0;) {
-    it[led].set(Color::BLACK);
-  }
+  it.fill(0, it.size(), Color::BLACK);
   it.schedule_show();
 }
 
@@ -176,19 +174,7 @@ bool WLEDLightEffect::parse_drgb_frame_(light::AddressableLight &it, const uint8
     return false;
   }
 
-  auto count = size / 3;
-  auto max_leds = it.size();
-
-  for (uint16_t led = 0; led < count; ++led, payload += 3) {
-    uint8_t r = payload[0];
-    uint8_t g = payload[1];
-    uint8_t b = payload[2];
-
-    if (led < max_leds) {
-      it[led].set(Color(r, g, b));
-    }
-  }
-
+  it.write_pixels(0, payload, size / 3, light::PIXEL_FORMAT_RGB);
   return true;
 }
 
@@ -198,20 +184,7 @@ bool WLEDLightEffect::parse_drgbw_frame_(light::AddressableLight &it, const uint
     return false;
   }
 
-  auto count = size / 4;
-  auto max_leds = it.size();
-
-  for (uint16_t led = 0; led < count; ++led, payload += 4) {
-    uint8_t r = payload[0];
-    uint8_t g = payload[1];
-    uint8_t b = payload[2];
-    uint8_t w = payload[3];
-
-    if (led < max_leds) {
-      it[led].set(Color(r, g, b, w));
-    }
-  }
-
+  it.write_pixels(0, payload, size / 4, light::PIXEL_FORMAT_RGBW);
   return true;
 }
 
@@ -230,19 +203,7 @@ bool WLEDLightEffect::parse_dnrgb_frame_(light::AddressableLight &it, const uint
     return false;
   }
 
-  auto count = size / 3;
-  auto max_leds = it.size();
-
-  for (; count > 0; count--, payload += 3, led++) {
-    uint8_t r = payload[0];
-    uint8_t g = payload[1];
-    uint8_t b = payload[2];
-
-    if (led < max_leds) {
-      it[led].set(Color(r, g, b));
-    }
-  }
-
+  it.write_pixels(led, payload, size / 3, light::PIXEL_FORMAT_RGB);
   return true;
 }
 
@@ -7,10 +7,30 @@
 #include "esphome/components/status_led/status_led.h"
 #endif
 
+#ifdef USE_HOST
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+#if defined(USE_ESP32) && defined(USE_SOCKET_SELECT_SUPPORT)
+#include <esp_vfs_eventfd.h>
+#include <sys/select.h>
+#include <unistd.h>
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "app";
 
+#if defined(USE_ESP32) || defined(USE_HOST)
+/// Upper bound for sleeping while no component needs to be polled, sleeps can be interrupted by wakeups.
+static const uint32_t MAX_IDLE_SLEEP = 1000;
+#else
+/// Sleeps can't be interrupted on this platform, so never sleep longer than the loop interval.
+static const uint32_t MAX_IDLE_SLEEP = 0;
+#endif
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -27,6 +47,18 @@ void Application::register_component_(Component *comp) {
 }
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+#ifdef USE_ESP32
+  this->main_task_ = xTaskGetCurrentTaskHandle();
+#endif
+#if defined(USE_ESP32) && defined(USE_SOCKET_SELECT_SUPPORT)
+  this->setup_wake_fd_();
+#endif
+#ifdef USE_HOST
+  if (pipe(this->wake_pipe_) == 0) {
+    fcntl(this->wake_pipe_[0], F_SETFL, O_NONBLOCK);
+    fcntl(this->wake_pipe_[1], F_SETFL, O_NONBLOCK);
+  }
+#endif
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
@@ -35,7 +67,12 @@ void Application::setup() {
   for (uint32_t i = 0; i < this->components_.size(); i++) {
     Component *component = this->components_[i];
 
-    component->call();
+    {
+#ifdef USE_PROFILER
+      ProfileGuard profile_guard{&component->setup_stats_};
+#endif
+      component->call();
+    }
     this->scheduler.process_to_add();
     this->feed_wdt();
     if (component->can_proceed())
@@ -68,9 +105,20 @@ void Application::loop() {
 
   this->scheduler.call();
   this->feed_wdt();
+  if (this->has_pending_enable_loop_requests_)
+    this->process_pending_enable_loop_requests_();
+  bool has_active_loop = false;
   for (Component *component : this->looping_components_) {
+    if (!component->is_loop_enabled()) {
+      new_app_state |= component->get_component_state();
+      continue;
+    }
+    has_active_loop = true;
     {
       WarnIfComponentBlockingGuard guard{component};
+#ifdef USE_PROFILER
+      ProfileGuard profile_guard{&component->loop_stats_};
+#endif
       component->call();
     }
     new_app_state |= component->get_component_state();
@@ -82,18 +130,28 @@ void Application::loop() {
   const uint32_t now = millis();
 
   if (HighFrequencyLoopRequester::is_high_frequency()) {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    // still check the watched sockets, components waiting for them have their loop disabled
+    if (!this->socket_watches_.empty())
+      this->sleep_until_woken_(0);
+#endif
     yield();
   } else {
     uint32_t delay_time = this->loop_interval_;
     if (now - this->last_loop_ < this->loop_interval_)
       delay_time = this->loop_interval_ - (now - this->last_loop_);
 
-    uint32_t next_schedule = this->scheduler.next_schedule_in().value_or(delay_time);
+    // If no component needs to be polled, new work can only come from the scheduler or a wakeup
+    uint32_t max_delay = delay_time;
+    if (!has_active_loop && this->dump_config_at_ >= this->components_.size())
+      max_delay = std::max(delay_time, MAX_IDLE_SLEEP);
+
+    uint32_t next_schedule = this->scheduler.next_schedule_in().value_or(max_delay);
     // next_schedule is max 0.5*delay_time
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
-    delay_time = std::min(next_schedule, delay_time);
-    delay(delay_time);
+    delay_time = std::min(next_schedule, max_delay);
+    this->sleep_until_woken_(delay_time);
   }
   this->last_loop_ = now;
 
@@ -145,6 +203,178 @@ void Application::run_safe_shutdown_hooks() {
   }
 }
 
+void Application::process_pending_enable_loop_requests_() {
+  // Clear the flag first, so that requests coming in while iterating are handled in the next loop
+  this->has_pending_enable_loop_requests_ = false;
+  for (auto *obj : this->looping_components_) {
+    if (obj->pending_enable_loop_)
+      obj->enable_loop();
+  }
+}
+
+void IRAM_ATTR HOT Application::wake_loop_any_context() {
+#if defined(USE_ESP32)
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  if (this->wake_fd_ >= 0) {
+    const uint64_t one = 1;
+    // The counter only saturates after billions of wakeups, the main loop is woken up in any case
+    (void) ::write(this->wake_fd_, &one, sizeof(one));
+    return;
+  }
+#endif
+  if (this->main_task_ == nullptr)
+    return;
+  if (xPortInIsrContext()) {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(this->main_task_, &higher_priority_task_woken);
+    if (higher_priority_task_woken == pdTRUE)
+      portYIELD_FROM_ISR();
+  } else {
+    xTaskNotifyGive(this->main_task_);
+  }
+#elif defined(USE_HOST)
+  if (this->wake_pipe_[1] < 0)
+    return;
+  const uint8_t dummy = 0;
+  // If the pipe is full, the main loop will be woken up anyway
+  (void) ::write(this->wake_pipe_[1], &dummy, 1);
+#endif
+}
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+bool Application::register_socket_fd(int fd, Component *component) {
+  if (fd < 0)
+    return false;
+#ifdef USE_ESP32
+  if (fd >= FD_SETSIZE) {
+    ESP_LOGW(TAG, "Socket fd %d exceeds FD_SETSIZE, it can't be watched", fd);
+    return false;
+  }
+#endif
+  for (auto &watch : this->socket_watches_) {
+    if (watch.fd == fd) {
+      watch.component = component;
+      return true;
+    }
+  }
+  this->socket_watches_.push_back(SocketWatch{fd, component});
+  return true;
+}
+
+void Application::unregister_socket_fd(int fd) {
+  for (auto it = this->socket_watches_.begin(); it != this->socket_watches_.end(); ++it) {
+    if (it->fd == fd) {
+      this->socket_watches_.erase(it);
+      return;
+    }
+  }
+}
+#endif
+
+#if defined(USE_ESP32) && defined(USE_SOCKET_SELECT_SUPPORT)
+void Application::setup_wake_fd_() {
+  // select() can't be woken up by a task notification, so wakeups go through an eventfd that is always selected on
+  esp_vfs_eventfd_config_t config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+  esp_err_t err = esp_vfs_eventfd_register(&config);
+  if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+    ESP_LOGW(TAG, "Could not register the eventfd driver: %s", esp_err_to_name(err));
+    return;
+  }
+  int fd = eventfd(0, EFD_SUPPORT_ISR);
+  if (fd < 0) {
+    ESP_LOGW(TAG, "Could not create the wakeup eventfd");
+    return;
+  }
+  if (fd >= FD_SETSIZE) {
+    ESP_LOGW(TAG, "Wakeup eventfd %d exceeds FD_SETSIZE", fd);
+    ::close(fd);
+    return;
+  }
+  this->wake_fd_ = fd;
+}
+#endif
+
+void Application::sleep_until_woken_(uint32_t ms) {
+#if defined(USE_ESP32) && defined(USE_SOCKET_SELECT_SUPPORT)
+  if (this->wake_fd_ < 0) {
+    if (this->socket_watches_.empty()) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+      return;
+    }
+    // without the eventfd, a wakeup can't interrupt select(), so bound its latency by the loop interval
+    if (ulTaskNotifyTake(pdTRUE, 0) != 0)
+      ms = 0;
+    ms = std::min(ms, this->loop_interval_);
+  }
+  fd_set read_fds;
+  FD_ZERO(&read_fds);
+  int max_fd = -1;
+  if (this->wake_fd_ >= 0) {
+    FD_SET(this->wake_fd_, &read_fds);
+    max_fd = this->wake_fd_;
+  }
+  for (auto &watch : this->socket_watches_) {
+    FD_SET(watch.fd, &read_fds);
+    max_fd = std::max(max_fd, watch.fd);
+  }
+  struct timeval timeout {
+    .tv_sec = static_cast<time_t>(ms / 1000), .tv_usec = static_cast<suseconds_t>((ms % 1000) * 1000),
+  };
+  if (::select(max_fd + 1, &read_fds, nullptr, nullptr, &timeout) <= 0)
+    return;
+  if (this->wake_fd_ >= 0 && FD_ISSET(this->wake_fd_, &read_fds)) {
+    // reading resets the counter, so coalesced wakeups are consumed at once
+    uint64_t count;
+    (void) ::read(this->wake_fd_, &count, sizeof(count));
+  }
+  for (auto &watch : this->socket_watches_) {
+    if (FD_ISSET(watch.fd, &read_fds))
+      watch.component->enable_loop();
+  }
+#elif defined(USE_ESP32)
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+#elif defined(USE_HOST)
+  if (this->wake_pipe_[0] < 0) {
+    delay(ms);
+    return;
+  }
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  this->poll_fds_.resize(1 + this->socket_watches_.size());
+  this->poll_fds_[0] = {.fd = this->wake_pipe_[0], .events = POLLIN, .revents = 0};
+  for (size_t i = 0; i < this->socket_watches_.size(); i++)
+    this->poll_fds_[i + 1] = {.fd = this->socket_watches_[i].fd, .events = POLLIN, .revents = 0};
+  if (poll(this->poll_fds_.data(), this->poll_fds_.size(), ms) <= 0)
+    return;
+  for (size_t i = 0; i < this->socket_watches_.size(); i++) {
+    if (this->poll_fds_[i + 1].revents != 0)
+      this->socket_watches_[i].component->enable_loop();
+  }
+  struct pollfd &pfd = this->poll_fds_[0];
+  if (pfd.revents != 0) {
+#else
+  struct pollfd pfd {
+    .fd = this->wake_pipe_[0], .events = POLLIN, .revents = 0,
+  };
+  if (poll(&pfd, 1, ms) > 0) {
+#endif
+    uint8_t buf[16];
+    while (::read(this->wake_pipe_[0], buf, sizeof(buf)) > 0) {
+    }
+  }
+#else
+  delay(ms);
+#endif
+}
+
+#ifdef USE_PROFILER
+void Application::reset_profile_stats() {
+  for (auto *obj : this->components_)
+    obj->reset_profile_stats();
+  this->scheduler.reset_profile_stats();
+  this->profile_started_ = millis();
+}
+#endif
+
 void Application::calculate_looping_components_() {
   for (auto *obj : this->components_) {
     if (obj->has_overridden_loop())
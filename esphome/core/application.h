@@ -9,6 +9,15 @@
 #include "esphome/core/preferences.h"
 #include "esphome/core/scheduler.h"
 
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+#if defined(USE_HOST) && defined(USE_SOCKET_SELECT_SUPPORT)
+#include <poll.h>
+#endif
+
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -189,6 +198,35 @@ class Application {
 
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
+  /** Wake up the main loop if it is sleeping.
+   *
+   * When no component needs its loop() polled, the main loop sleeps until the next scheduler deadline. Call this
+   * after making work available to the main loop (e.g. through Component::enable_loop_soon_any_context()) so it's
+   * picked up immediately. Safe to call from any task and from interrupt handlers.
+   */
+  void wake_loop_any_context();
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  /** Watch a socket file descriptor while the main loop sleeps.
+   *
+   * When \p fd becomes readable (data arrived or a connection can be accepted), the sleep ends and the loop of
+   * \p component is enabled, so it can disable its loop while there's nothing to read. Returns false if the
+   * descriptor can't be watched, the component must keep polling it then.
+   */
+  bool register_socket_fd(int fd, Component *component);
+  /// Stop watching a file descriptor registered with register_socket_fd().
+  void unregister_socket_fd(int fd);
+#endif
+
+  const std::vector<Component *> &get_components() const { return this->components_; }
+
+#ifdef USE_PROFILER
+  /// Reset the run time statistics of all components and scheduler items.
+  void reset_profile_stats();
+  /// Get the time in ms that the run time statistics have been collected for.
+  uint32_t get_profile_period() const { return millis() - this->profile_started_; }
+#endif
+
   void feed_wdt();
 
   void reboot();
@@ -347,6 +385,14 @@ class Application {
 
   void calculate_looping_components_();
 
+  void process_pending_enable_loop_requests_();
+
+  /// Sleep for at most \p ms milliseconds, returning early if woken up by wake_loop_any_context().
+  void sleep_until_woken_(uint32_t ms);
+#if defined(USE_ESP32) && defined(USE_SOCKET_SELECT_SUPPORT)
+  void setup_wake_fd_();
+#endif
+
   void feed_wdt_arch_();
 
   std::vector<Component *> components_{};
@@ -408,6 +454,30 @@ class Application {
   uint32_t loop_interval_{16};
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
+  volatile bool has_pending_enable_loop_requests_{false};
+#ifdef USE_PROFILER
+  uint32_t profile_started_{0};
+#endif
+#ifdef USE_ESP32
+  TaskHandle_t main_task_{nullptr};
+#endif
+#if defined(USE_ESP32) && defined(USE_SOCKET_SELECT_SUPPORT)
+  /// Counts wakeups, so that they interrupt select() in sleep_until_woken_(). -1 if the eventfd couldn't be created.
+  int wake_fd_{-1};
+#endif
+#ifdef USE_HOST
+  int wake_pipe_[2]{-1, -1};
+#endif
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  struct SocketWatch {
+    int fd;
+    Component *component;
+  };
+  std::vector<SocketWatch> socket_watches_{};
+#ifdef USE_HOST
+  std::vector<struct pollfd> poll_fds_{};
+#endif
+#endif
 };
 
 /// Global storage of Application pointer - only one Application can exist.
@@ -182,6 +182,17 @@ bool Component::has_overridden_loop() const {
   return loop_overridden || call_loop_overridden;
 }
 
+void Component::disable_loop() { this->loop_disabled_ = true; }
+void Component::enable_loop() {
+  this->pending_enable_loop_ = false;
+  this->loop_disabled_ = false;
+}
+void IRAM_ATTR HOT Component::enable_loop_soon_any_context() {
+  this->pending_enable_loop_ = true;
+  App.has_pending_enable_loop_requests_ = true;
+  App.wake_loop_any_context();
+}
+
 PollingComponent::PollingComponent(uint32_t update_interval) : update_interval_(update_interval) {}
 
 void PollingComponent::call_setup() {
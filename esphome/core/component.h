@@ -5,6 +5,7 @@
 #include <cmath>
 
 #include "esphome/core/optional.h"
+#include "esphome/core/profiler.h"
 
 namespace esphome {
 
@@ -141,6 +142,37 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /** Stop calling loop() for this component until enable_loop() is called.
+   *
+   * Components that only have work to do after some event (an interrupt, data on a socket, ...) should disable their
+   * loop when idle. When no component needs to be polled, the main loop sleeps until the next scheduler deadline or
+   * until it is woken up by enable_loop_soon_any_context().
+   */
+  void disable_loop();
+  /// Resume calling loop() for this component. Must be called from the main loop task.
+  void enable_loop();
+  /** Resume calling loop() for this component on the next main loop iteration, and wake up the main loop if it's
+   * sleeping.
+   *
+   * Safe to call from any task and from interrupt handlers.
+   */
+  void enable_loop_soon_any_context();
+  bool is_loop_enabled() const { return !this->loop_disabled_; }
+
+#ifdef USE_PROFILER
+  /// Time spent in setup() of this component.
+  const ProfileStats &get_setup_stats() const { return this->setup_stats_; }
+  /// Time spent in loop() of this component.
+  const ProfileStats &get_loop_stats() const { return this->loop_stats_; }
+  /// Time spent in the timeouts and intervals of this component.
+  const ProfileStats &get_scheduler_stats() const { return this->scheduler_stats_; }
+  /// Reset the loop and scheduler statistics of this component, setup statistics are kept.
+  void reset_profile_stats() {
+    this->loop_stats_.reset();
+    this->scheduler_stats_.reset();
+  }
+#endif
+
   /** Set where this component was loaded from for some debug messages.
    *
    * This is set by the ESPHome core, and should not be called manually.
@@ -271,6 +303,14 @@ class Component {
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
   const char *component_source_{nullptr};
+  bool loop_disabled_{false};
+  volatile bool pending_enable_loop_{false};
+#ifdef USE_PROFILER
+  friend class Scheduler;
+  ProfileStats setup_stats_;
+  ProfileStats loop_stats_;
+  ProfileStats scheduler_stats_;
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
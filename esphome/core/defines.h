@@ -39,6 +39,7 @@
 #define USE_OTA_STATE_CALLBACK
 #define USE_OUTPUT
 #define USE_POWER_SUPPLY
+#define USE_PROFILER
 #define USE_QR_CODE
 #define USE_SELECT
 #define USE_SENSOR
@@ -75,6 +76,7 @@
 #define USE_ESP32_CAMERA
 #define USE_IMPROV
 #define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 #define USE_WIFI_11KV_SUPPORT
 #define USE_BLUETOOTH_PROXY
 #define USE_VOICE_ASSISTANT
@@ -122,6 +124,7 @@
 
 #ifdef USE_HOST
 #define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 #endif
 
 // Disabled feature flags
@@ -490,6 +490,130 @@ template<typename... Ts> class CallbackManager<void(Ts...)> {
   std::vector<std::function<void(Ts...)>> callbacks_;
 };
 
+template<typename Sig, size_t Capacity = 2 * sizeof(void *)> class InlineFunction;
+
+/** Type-erased callable like std::function, that stores small callables without a heap allocation.
+ *
+ * Callables that are trivially copyable and fit in \p Capacity bytes (the default fits a lambda capturing two
+ * pointers) are stored inside the object, larger ones are moved to the heap. Unlike std::function, there's only a
+ * single pointer of overhead and the object is move-only.
+ */
+template<typename R, typename... Ts, size_t Capacity> class InlineFunction<R(Ts...), Capacity> {
+ public:
+  InlineFunction() = default;
+  template<typename F, typename T = typename std::decay<F>::type,
+           enable_if_t<!std::is_same<T, InlineFunction>::value, int> = 0>
+  InlineFunction(F &&callable) {  // NOLINT(google-explicit-constructor)
+    this->assign_<T>(std::forward<F>(callable), std::integral_constant<bool, fits_inline<T>()>{});
+  }
+  InlineFunction(InlineFunction &&other) noexcept : ops_(other.ops_) {
+    memcpy(this->storage_, other.storage_, Capacity);
+    other.ops_ = nullptr;
+  }
+  InlineFunction &operator=(InlineFunction &&other) noexcept {
+    if (this != &other) {
+      this->reset();
+      this->ops_ = other.ops_;
+      memcpy(this->storage_, other.storage_, Capacity);
+      other.ops_ = nullptr;
+    }
+    return *this;
+  }
+  InlineFunction(const InlineFunction &) = delete;
+  InlineFunction &operator=(const InlineFunction &) = delete;
+  ~InlineFunction() { this->reset(); }
+
+  /// Whether a callable of type \p T is stored inline.
+  template<typename T> static constexpr bool fits_inline() {
+    return sizeof(T) <= Capacity && alignof(T) <= alignof(void *) && is_trivially_copyable<T>::value &&
+           std::is_trivially_destructible<T>::value;
+  }
+
+  /// Call the stored callable. Calling an empty (default-constructed or moved-from) function does nothing and returns
+  /// a default-constructed \p R.
+  R operator()(Ts... args) const {
+    if (this->ops_ == nullptr)
+      return R();
+    return this->ops_->invoke(this->storage_, std::forward<Ts>(args)...);
+  }
+  explicit operator bool() const { return this->ops_ != nullptr; }
+  void reset() {
+    if (this->ops_ != nullptr && this->ops_->destroy != nullptr)
+      this->ops_->destroy(this->storage_);
+    this->ops_ = nullptr;
+  }
+
+ protected:
+  /// Operations on the stored callable, one static instance per callable type.
+  struct Ops {
+    R (*invoke)(const void *storage, Ts... args);
+    /// Only set for callables on the heap, inline ones are trivially destructible.
+    void (*destroy)(void *storage);
+  };
+
+  template<typename T> struct InlineOps {
+    static R invoke(const void *storage, Ts... args) {
+      return (*const_cast<T *>(reinterpret_cast<const T *>(storage)))(std::forward<Ts>(args)...);
+    }
+    static constexpr Ops OPS{&InlineOps::invoke, nullptr};
+  };
+  template<typename T> struct HeapOps {
+    static R invoke(const void *storage, Ts... args) {
+      return (**reinterpret_cast<T *const *>(storage))(std::forward<Ts>(args)...);
+    }
+    static void destroy(void *storage) { delete *reinterpret_cast<T **>(storage); }
+    static constexpr Ops OPS{&HeapOps::invoke, &HeapOps::destroy};
+  };
+
+  template<typename T, typename F> void assign_(F &&callable, std::true_type /*fits_inline*/) {
+    new (this->storage_) T(std::forward<F>(callable));
+    this->ops_ = &InlineOps<T>::OPS;
+  }
+  template<typename T, typename F> void assign_(F &&callable, std::false_type /*fits_inline*/) {
+    *reinterpret_cast<T **>(this->storage_) = new T(std::forward<F>(callable));  // NOLINT
+    this->ops_ = &HeapOps<T>::OPS;
+  }
+
+  static_assert(Capacity >= sizeof(void *), "InlineFunction must be able to store a pointer");
+  const Ops *ops_{nullptr};
+  alignas(void *) mutable uint8_t storage_[Capacity];
+};
+
+template<typename R, typename... Ts, size_t Capacity>
+template<typename T>
+constexpr typename InlineFunction<R(Ts...), Capacity>::Ops InlineFunction<R(Ts...), Capacity>::InlineOps<T>::OPS;
+template<typename R, typename... Ts, size_t Capacity>
+template<typename T>
+constexpr typename InlineFunction<R(Ts...), Capacity>::Ops InlineFunction<R(Ts...), Capacity>::HeapOps<T>::OPS;
+
+template<typename... X> class InlineCallbackManager;
+
+/** Variant of CallbackManager that stores the callbacks in an InlineFunction instead of a std::function.
+ *
+ * For the common case of a lambda capturing a few pointers, this avoids a heap allocation per callback and makes each
+ * entry smaller.
+ *
+ * @tparam Ts The arguments for the callbacks, wrapped in void().
+ */
+template<typename... Ts> class InlineCallbackManager<void(Ts...)> {
+ public:
+  /// Add a callback to the list.
+  template<typename F> void add(F &&callback) { this->callbacks_.emplace_back(std::forward<F>(callback)); }
+
+  /// Call all callbacks in this manager.
+  void call(Ts... args) {
+    for (auto &cb : this->callbacks_)
+      cb(args...);
+  }
+  size_t size() const { return this->callbacks_.size(); }
+
+  /// Call all callbacks in this manager.
+  void operator()(Ts... args) { call(args...); }
+
+ protected:
+  std::vector<InlineFunction<void(Ts...)>> callbacks_;
+};
+
 /// Helper class to deduplicate items in a series of values.
 template<typename T> class Deduplicator {
  public:
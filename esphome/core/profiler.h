@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_PROFILER
+
+#include "esphome/core/hal.h"
+
+namespace esphome {
+
+/// Accumulated run time statistics of a piece of code, in microseconds.
+struct ProfileStats {
+  uint32_t count{0};
+  uint64_t total_us{0};
+  uint32_t max_us{0};
+
+  void record(uint32_t duration_us) {
+    this->count++;
+    this->total_us += duration_us;
+    if (duration_us > this->max_us)
+      this->max_us = duration_us;
+  }
+  void reset() { *this = ProfileStats{}; }
+};
+
+/** Helper class that records the time spent in its scope.
+ *
+ * As long as the object is alive, time is counted; it's recorded into the statistics on destruction.
+ */
+class ProfileGuard {
+ public:
+  ProfileGuard(ProfileStats *stats) : stats_(stats), started_(micros()) {}
+  ~ProfileGuard() { this->stats_->record(micros() - this->started_); }
+
+ protected:
+  ProfileStats *stats_;
+  uint32_t started_;
+};
+
+}  // namespace esphome
+
+#endif  // USE_PROFILER
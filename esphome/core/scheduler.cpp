@@ -10,6 +10,10 @@ namespace esphome {
 static const char *const TAG = "scheduler";
 
 static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+static const size_t MAX_POOLED_ITEMS = 16;
+#ifdef USE_PROFILER
+static const size_t MAX_PROFILES = 64;
+#endif
 
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
@@ -17,40 +21,58 @@ static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
 // A note on locking: the `lock_` lock protects the `items_` and `to_add_` containers. It must be taken when writing to
 // them (i.e. when adding/removing items, but not when changing items). As items are only deleted from the loop task,
 // iterating over them from the loop task is fine; but iterating from any other context requires the lock to be held to
-// avoid the main thread modifying the list while it is being accessed.
+// avoid the main thread modifying the list while it is being accessed. The same lock also protects `index_` and
+// `pool_`.
+//
+// Every named item that isn't cancelled has an entry in `index_`, which is sorted by the hash of the name so that
+// cancelling (and thus re-arming) an item is a binary search instead of a scan over all items with string compares; the
+// full name is only compared for the entries with a matching hash. Items are recycled through `pool_` instead of being
+// freed, so re-arming doesn't hit the allocator either.
 
 void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
                                 std::function<void()> func) {
   const uint32_t now = this->millis_();
+  const uint32_t name_hash = hash_name_(name);
 
-  if (!name.empty())
-    this->cancel_timeout(component, name);
+  if (name_hash != 0)
+    this->cancel_item_(component, name_hash, name, SchedulerItem::TIMEOUT);
 
   if (timeout == SCHEDULER_DONT_RUN)
     return;
 
   ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%" PRIu32 ")", name.c_str(), timeout);
 
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
   item->name = name;
+  item->name_hash = name_hash;
   item->type = SchedulerItem::TIMEOUT;
   item->timeout = timeout;
   item->last_execution = now;
   item->last_execution_major = this->millis_major_;
   item->callback = std::move(func);
   item->remove = false;
-  this->push_(std::move(item));
+  item->in_heap = false;
+  {
+    LockGuard guard{this->lock_};
+#ifdef USE_PROFILER
+    item->stats = this->get_profile_stats_(component, name);
+#endif
+    if (name_hash != 0)
+      this->add_index_(item.get());
+    this->to_add_.push_back(std::move(item));
+  }
 }
 bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
+  return this->cancel_item_(component, hash_name_(name), name, SchedulerItem::TIMEOUT);
 }
 void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
                                  std::function<void()> func) {
   const uint32_t now = this->millis_();
+  const uint32_t name_hash = hash_name_(name);
 
-  if (!name.empty())
-    this->cancel_interval(component, name);
+  if (name_hash != 0)
+    this->cancel_item_(component, name_hash, name, SchedulerItem::INTERVAL);
 
   if (interval == SCHEDULER_DONT_RUN)
     return;
@@ -62,9 +84,10 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
 
   ESP_LOGVV(TAG, "set_interval(name='%s', interval=%" PRIu32 ", offset=%" PRIu32 ")", name.c_str(), interval, offset);
 
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
   item->name = name;
+  item->name_hash = name_hash;
   item->type = SchedulerItem::INTERVAL;
   item->interval = interval;
   item->last_execution = now - offset - interval;
@@ -73,10 +96,19 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
     item->last_execution_major--;
   item->callback = std::move(func);
   item->remove = false;
-  this->push_(std::move(item));
+  item->in_heap = false;
+  {
+    LockGuard guard{this->lock_};
+#ifdef USE_PROFILER
+    item->stats = this->get_profile_stats_(component, name);
+#endif
+    if (name_hash != 0)
+      this->add_index_(item.get());
+    this->to_add_.push_back(std::move(item));
+  }
 }
 bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
+  return this->cancel_item_(component, hash_name_(name), name, SchedulerItem::INTERVAL);
 }
 
 struct RetryArgs {
@@ -161,8 +193,8 @@ void HOT Scheduler::call() {
       this->pop_raw_();
       this->lock_.unlock();
 
-      ESP_LOGVV(TAG, "  %s '%s' interval=%" PRIu32 " last_execution=%" PRIu32 " (%u) next=%" PRIu32 " (%u)",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution,
+      ESP_LOGVV(TAG, "  %s 0x%08" PRIX32 " interval=%" PRIu32 " last_execution=%" PRIu32 " (%u) next=%" PRIu32 " (%u)",
+                item->get_type_str(), item->name_hash, item->interval, item->last_execution,
                 item->last_execution_major, item->next_execution(), item->next_execution_major());
 
       old_items.push_back(std::move(item));
@@ -178,8 +210,9 @@ void HOT Scheduler::call() {
 
   auto to_remove_was = to_remove_;
   auto items_was = this->items_.size();
-  // If we have too many items to remove
-  if (to_remove_ > MAX_LOGICALLY_DELETED_ITEMS) {
+  // If we have too many items to remove. Rebuilding the heap takes O(n log n), so with many items it's only done once a
+  // fair part of them has been cancelled, to keep re-arming O(log n) on average.
+  if (to_remove_ > std::max<uint32_t>(MAX_LOGICALLY_DELETED_ITEMS, this->items_.size() / 4)) {
     std::vector<std::unique_ptr<SchedulerItem>> valid_items;
     while (!this->empty_()) {
       LockGuard guard{this->lock_};
@@ -216,14 +249,19 @@ void HOT Scheduler::call() {
 
       // Don't run on failed components
       if (item->component != nullptr && item->component->is_failed()) {
-        LockGuard guard{this->lock_};
+        this->lock_.lock();
+        auto failed = std::move(this->items_[0]);
         this->pop_raw_();
+        this->remove_index_(failed.get());
+        this->lock_.unlock();
+        this->release_item_(std::move(failed));
         continue;
       }
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
-      ESP_LOGVV(TAG, "Running %s '%s' with interval=%" PRIu32 " last_execution=%" PRIu32 " (now=%" PRIu32 ")",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution, now);
+      ESP_LOGVV(TAG,
+                "Running %s 0x%08" PRIX32 " with interval=%" PRIu32 " last_execution=%" PRIu32 " (now=%" PRIu32 ")",
+                item->get_type_str(), item->name_hash, item->interval, item->last_execution, now);
 #endif
 
       // Warning: During callback(), a lot of stuff can happen, including:
@@ -231,7 +269,18 @@ void HOT Scheduler::call() {
       //  - timeouts/intervals get cancelled
       {
         WarnIfComponentBlockingGuard guard{item->component};
+#ifdef USE_PROFILER
+        Component *component = item->component;
+        ProfileStats *stats = item->stats;
+        const uint32_t started = micros();
+#endif
         item->callback();
+#ifdef USE_PROFILER
+        const uint32_t duration = micros() - started;
+        stats->record(duration);
+        if (component != nullptr)
+          component->scheduler_stats_.record(duration);
+#endif
       }
     }
 
@@ -245,11 +294,15 @@ void HOT Scheduler::call() {
       // during the function call and know if we were cancelled.
       this->pop_raw_();
 
+      if (!item->remove && item->type == SchedulerItem::TIMEOUT)
+        this->remove_index_(item.get());
+
       this->lock_.unlock();
 
       if (item->remove) {
         // We were removed/cancelled in the function call, stop
         to_remove_--;
+        this->release_item_(std::move(item));
         continue;
       }
 
@@ -262,6 +315,8 @@ void HOT Scheduler::call() {
             item->last_execution_major++;
         }
         this->push_(std::move(item));
+      } else {
+        this->release_item_(std::move(item));
       }
     }
   }
@@ -272,9 +327,14 @@ void HOT Scheduler::process_to_add() {
   LockGuard guard{this->lock_};
   for (auto &it : this->to_add_) {
     if (it->remove) {
+      if (this->pool_.size() < MAX_POOLED_ITEMS) {
+        it->callback = nullptr;
+        this->pool_.push_back(std::move(it));
+      }
       continue;
     }
 
+    it->in_heap = true;
     this->items_.push_back(std::move(it));
     std::push_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
   }
@@ -288,10 +348,13 @@ void HOT Scheduler::cleanup_() {
 
     to_remove_--;
 
+    std::unique_ptr<SchedulerItem> removed;
     {
       LockGuard guard{this->lock_};
+      removed = std::move(this->items_[0]);
       this->pop_raw_();
     }
+    this->release_item_(std::move(removed));
   }
 }
 void HOT Scheduler::pop_raw_() {
@@ -300,27 +363,109 @@ void HOT Scheduler::pop_raw_() {
 }
 void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) {
   LockGuard guard{this->lock_};
+  item->in_heap = false;
   this->to_add_.push_back(std::move(item));
 }
-bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
-  // obtain lock because this function iterates and can be called from non-loop task context
-  LockGuard guard{this->lock_};
-  bool ret = false;
-  for (auto &it : this->items_) {
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
-      to_remove_++;
-      it->remove = true;
-      ret = true;
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::acquire_item_() {
+  {
+    LockGuard guard{this->lock_};
+    if (!this->pool_.empty()) {
+      auto item = std::move(this->pool_.back());
+      this->pool_.pop_back();
+      return item;
     }
   }
-  for (auto &it : this->to_add_) {
-    if (it->component == component && it->name == name && it->type == type) {
-      it->remove = true;
-      ret = true;
+  return make_unique<SchedulerItem>();
+}
+void HOT Scheduler::release_item_(std::unique_ptr<SchedulerItem> item) {
+  // Destroy the callback (and whatever it captured) right away, not when the item is reused
+  item->callback = nullptr;
+  LockGuard guard{this->lock_};
+  if (this->pool_.size() < MAX_POOLED_ITEMS)
+    this->pool_.push_back(std::move(item));
+}
+std::vector<Scheduler::IndexEntry>::iterator HOT Scheduler::find_index_(Component *component, uint32_t name_hash,
+                                                                      const std::string &name,
+                                                                      SchedulerItem::Type type) {
+  const IndexEntry key{component, name_hash, type, nullptr};
+  for (auto it = std::lower_bound(this->index_.begin(), this->index_.end(), key);
+       it != this->index_.end() && !(key < *it); ++it) {
+    if (it->item->name == name)
+      return it;
+  }
+  return this->index_.end();
+}
+void HOT Scheduler::add_index_(SchedulerItem *item) {
+  const IndexEntry entry{item->component, item->name_hash, item->type, item};
+  // after any entries with the same key, i.e. other names with the same hash
+  this->index_.insert(std::upper_bound(this->index_.begin(), this->index_.end(), entry), entry);
+}
+void HOT Scheduler::remove_index_(SchedulerItem *item) {
+  if (item->name_hash == 0)
+    return;
+  const IndexEntry key{item->component, item->name_hash, item->type, item};
+  // The item may no longer have an entry, if it has been cancelled
+  for (auto it = std::lower_bound(this->index_.begin(), this->index_.end(), key);
+       it != this->index_.end() && !(key < *it); ++it) {
+    if (it->item == item) {
+      this->index_.erase(it);
+      return;
     }
   }
+}
+bool HOT Scheduler::cancel_item_(Component *component, uint32_t name_hash, const std::string &name,
+                                 Scheduler::SchedulerItem::Type type) {
+  if (name_hash == 0)
+    return false;
+  // obtain lock because this function can be called from non-loop task context
+  LockGuard guard{this->lock_};
+  auto it = this->find_index_(component, name_hash, name, type);
+  if (it == this->index_.end())
+    return false;
+
+  SchedulerItem *item = it->item;
+  this->index_.erase(it);
+  item->remove = true;
+  // Items still in `to_add_` are dropped by process_to_add(), only items in the heap are removed lazily
+  if (item->in_heap)
+    to_remove_++;
+  return true;
+}
+#ifdef USE_PROFILER
+ProfileStats *Scheduler::get_profile_stats_(Component *component, const std::string &name) {
+  auto key = std::make_pair(component, name);
+  auto it = this->profiles_.find(key);
+  if (it == this->profiles_.end()) {
+    if (this->profiles_.size() >= MAX_PROFILES)
+      return &this->other_profile_.stats;
+    it = this->profiles_.emplace(std::move(key), NameProfile{component, name, {}}).first;
+  }
+  return &it->second.stats;
+}
+std::vector<Scheduler::NameProfile> Scheduler::get_profiles() {
+  LockGuard guard{this->lock_};
+  std::vector<NameProfile> profiles;
+  profiles.reserve(this->profiles_.size() + 1);
+  for (auto &it : this->profiles_)
+    profiles.push_back(it.second);
+  if (this->other_profile_.stats.count != 0)
+    profiles.push_back(this->other_profile_);
+  return profiles;
+}
+void Scheduler::reset_profile_stats() {
+  LockGuard guard{this->lock_};
+  for (auto &it : this->profiles_)
+    it.second.stats.reset();
+  this->other_profile_.stats.reset();
+}
+#endif
 
-  return ret;
+uint32_t Scheduler::hash_name_(const std::string &name) {
+  if (name.empty())
+    return 0;
+  const uint32_t hash = fnv1_hash(name);
+  // 0 is reserved for anonymous items
+  return hash != 0 ? hash : 1;
 }
 uint32_t Scheduler::millis_() {
   const uint32_t now = millis();
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+#include <map>
 #include <vector>
 #include <memory>
 
@@ -27,10 +29,25 @@ class Scheduler {
 
   void process_to_add();
 
+#ifdef USE_PROFILER
+  /// Run time statistics of all timeouts/intervals of a component with the same name.
+  struct NameProfile {
+    Component *component;
+    std::string name;
+    ProfileStats stats;
+  };
+
+  /// Get a copy of the run time statistics of all timeouts/intervals that have been scheduled so far.
+  std::vector<NameProfile> get_profiles();
+  void reset_profile_stats();
+#endif
+
  protected:
   struct SchedulerItem {
     Component *component;
     std::string name;
+    /// FNV-1 hash of the name, or 0 for anonymous items (which can't be cancelled).
+    uint32_t name_hash;
     enum Type { TIMEOUT, INTERVAL } type;
     union {
       uint32_t interval;
@@ -39,6 +56,11 @@ class Scheduler {
     uint32_t last_execution;
     std::function<void()> callback;
     bool remove;
+    /// Whether this item lives in `items_` (as opposed to `to_add_`).
+    bool in_heap;
+#ifdef USE_PROFILER
+    ProfileStats *stats;
+#endif
     uint8_t last_execution_major;
 
     inline uint32_t next_execution() { return this->last_execution + this->timeout; }
@@ -63,11 +85,39 @@ class Scheduler {
     }
   };
 
+  /// Entry of the (component, name, type) -> item lookup table, kept sorted by key. Names with the same hash share a
+  /// key, the names of their items tell them apart.
+  struct IndexEntry {
+    Component *component;
+    uint32_t name_hash;
+    SchedulerItem::Type type;
+    SchedulerItem *item;
+
+    bool operator<(const IndexEntry &other) const {
+      if (this->component != other.component)
+        return std::less<Component *>()(this->component, other.component);
+      if (this->name_hash != other.name_hash)
+        return this->name_hash < other.name_hash;
+      return this->type < other.type;
+    }
+  };
+
+  static uint32_t hash_name_(const std::string &name);
   uint32_t millis_();
   void cleanup_();
   void pop_raw_();
   void push_(std::unique_ptr<SchedulerItem> item);
-  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  std::unique_ptr<SchedulerItem> acquire_item_();
+  void release_item_(std::unique_ptr<SchedulerItem> item);
+  // The following index functions must be called with `lock_` held.
+  std::vector<IndexEntry>::iterator find_index_(Component *component, uint32_t name_hash, const std::string &name,
+                                                SchedulerItem::Type type);
+  void add_index_(SchedulerItem *item);
+  void remove_index_(SchedulerItem *item);
+  bool cancel_item_(Component *component, uint32_t name_hash, const std::string &name, SchedulerItem::Type type);
+#ifdef USE_PROFILER
+  ProfileStats *get_profile_stats_(Component *component, const std::string &name);
+#endif
   bool empty_() {
     this->cleanup_();
     return this->items_.empty();
@@ -76,6 +126,16 @@ class Scheduler {
   Mutex lock_;
   std::vector<std::unique_ptr<SchedulerItem>> items_;
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  /// Sorted lookup table of all named, not cancelled items, so that cancelling doesn't need to scan the containers.
+  std::vector<IndexEntry> index_;
+  /// Recycled items, to avoid allocating a new item every time a timeout is (re-)armed.
+  std::vector<std::unique_ptr<SchedulerItem>> pool_;
+#ifdef USE_PROFILER
+  /// Run time statistics by component and name. Entries are never removed, so items can point into it. As names may be
+  /// generated at run time, the number of entries is capped; items with further names are counted in other_profile_.
+  std::map<std::pair<Component *, std::string>, NameProfile> profiles_;
+  NameProfile other_profile_{nullptr, "(other)", {}};
+#endif
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
   uint32_t to_remove_{0};
@@ -176,6 +176,16 @@ class TypeInfo(ABC):
 
     encode_func = None
 
+    @property
+    def size_func(self):
+        # encode_message<Type> -> add_message_field, the template arguments are deduced
+        name = self.encode_func.split("<")[0][len("encode_") :]
+        return f"add_{name}_field"
+
+    @property
+    def size_content(self):
+        return f"ProtoSize::{self.size_func}(total_size, {self.number}, this->{self.field_name});"
+
     @property
     def dump_content(self):
         o = f'out.append("  {self.name}: ");\n'
@@ -526,6 +536,13 @@ class RepeatedTypeInfo(TypeInfo):
         o += "}"
         return o
 
+    @property
+    def size_content(self):
+        o = f"for (auto {'' if self._ti_is_bool else '&'}it : this->{self.field_name}) {{\n"
+        o += f"  ProtoSize::{self._ti.size_func}(total_size, {self.number}, it, true);\n"
+        o += "}"
+        return o
+
     @property
     def dump_content(self):
         o = f'for (const auto {"" if self._ti_is_bool else "&"}it : this->{self.field_name}) {{\n'
@@ -569,6 +586,7 @@ def build_message_type(desc):
     decode_32bit = []
     decode_64bit = []
     encode = []
+    size = []
     dump = []
 
     for field in desc.field:
@@ -579,6 +597,7 @@ def build_message_type(desc):
         protected_content.extend(ti.protected_content)
         public_content.extend(ti.public_content)
         encode.append(ti.encode_content)
+        size.append(ti.size_content)
 
         if ti.decode_varint_content:
             decode_varint.append(ti.decode_varint_content)
@@ -645,6 +664,18 @@ def build_message_type(desc):
     prot = "void encode(ProtoWriteBuffer buffer) const override;"
     public_content.append(prot)
 
+    o = f"void {desc.name}::calculate_size(uint32_t &total_size) const {{"
+    if size:
+        if len(size) == 1 and len(size[0]) + len(o) + 3 < 120:
+            o += f" {size[0]} "
+        else:
+            o += "\n"
+            o += indent("\n".join(size)) + "\n"
+    o += "}\n"
+    cpp += o
+    prot = "void calculate_size(uint32_t &total_size) const override;"
+    public_content.append(prot)
+
     o = f"void {desc.name}::dump_to(std::string &out) const {{"
     if dump:
         if len(dump) == 1 and len(dump[0]) + len(o) + 3 < 120:
@@ -0,0 +1,154 @@
+#include "host_test.h"
+#include "esphome/core/helpers.h"
+
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Compares InlineCallbackManager with the std::function based CallbackManager: the heap used per entity with a few
+// state callbacks, and the cost of calling them on each published state.
+
+using namespace esphome;
+using host_test::time_ns;
+
+static size_t allocated_bytes = 0;
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocated_bytes += size;
+  allocations++;
+  void *ptr = malloc(size);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
+namespace {
+
+struct Counter {
+  float sum{0};
+  int calls{0};
+};
+
+/// Destructor calls of Tracked, to check that callables stored on the heap are destroyed.
+int destroyed = 0;
+struct Tracked {
+  Counter *counter;
+  std::unique_ptr<int> state{new int(1)};
+  explicit Tracked(Counter *counter) : counter(counter) {}
+  Tracked(Tracked &&other) = default;
+  ~Tracked() {
+    if (state)
+      destroyed++;
+  }
+  void operator()(float x) { this->counter->sum += x * *this->state; }
+};
+
+void check_inline_function() {
+  // calling an empty function does nothing
+  InlineFunction<void(float)> empty;
+  HOST_CHECK(!empty);
+  empty(1.0f);
+  InlineFunction<int()> empty_int;
+  HOST_CHECK(empty_int() == 0);
+
+  Counter counter;
+  InlineFunction<void(float)> func([&counter](float x) { counter.sum += x; });
+  HOST_CHECK(bool(func));
+  func(2.0f);
+  InlineFunction<void(float)> moved(std::move(func));
+  func(1.0f);  // moved-from
+  moved(3.0f);
+  HOST_CHECK(counter.sum == 5.0f);
+
+  destroyed = 0;
+  {
+    InlineFunction<void(float)> heap{Tracked(&counter)};
+    HOST_CHECK(!InlineFunction<void(float)>::fits_inline<Tracked>());
+    heap(1.0f);
+    InlineFunction<void(float)> other;
+    other = std::move(heap);
+    other(1.0f);
+  }
+  HOST_CHECK(destroyed == 1);
+  HOST_CHECK(counter.sum == 7.0f);
+
+  InlineCallbackManager<void(float)> manager;
+  std::function<void(float)> std_function = [&counter](float x) { counter.calls++; };
+  manager.add([&counter](float x) { counter.calls++; });
+  manager.add(std_function);
+  manager.add(std::bind(&Tracked::operator(), std::make_shared<Tracked>(&counter), std::placeholders::_1));
+  for (int i = 0; i < 10; i++)
+    manager.add([&counter, i](float x) { counter.calls += i; });
+  manager.call(1.0f);
+  HOST_CHECK(manager.size() == 13);
+  HOST_CHECK(counter.calls == 2 + 45);
+}
+
+template<typename M> struct Entity {
+  float state;
+  M callback;
+};
+
+struct Usage {
+  size_t bytes;
+  size_t allocations;
+};
+
+/// Heap used per entity by `count` entities with `callbacks` callbacks each, that capture two pointers.
+template<typename M> Usage heap_per_entity(size_t count, int callbacks) {
+  std::vector<std::unique_ptr<Entity<M>>> entities;
+  entities.reserve(count);
+  Counter counter;
+  size_t bytes = allocated_bytes, count_before = allocations;
+  for (size_t i = 0; i < count; i++) {
+    auto *entity = new Entity<M>();
+    entities.emplace_back(entity);
+    for (int j = 0; j < callbacks; j++)
+      entity->callback.add([&counter, entity](float x) { counter.sum += entity->state; });
+  }
+  return {(allocated_bytes - bytes) / count, (allocations - count_before) / count};
+}
+
+template<typename M> double time_call(int callbacks) {
+  M manager;
+  Counter counter;
+  for (int j = 0; j < callbacks; j++)
+    manager.add([&counter](float x) { counter.sum += x; });
+  float x = 0;
+  double ns = time_ns(1000000, [&]() { manager.call(x += 1.0f); });
+  HOST_CHECK(counter.sum > 0);
+  return ns;
+}
+
+}  // namespace
+
+int main() {
+  check_inline_function();
+
+  using StdManager = CallbackManager<void(float)>;
+  using InlineManager = InlineCallbackManager<void(float)>;
+
+  printf("callback_manager (%zu-bit host, entries of %zu / %zu bytes)\n", sizeof(void *) * 8,
+         sizeof(std::function<void(float)>), sizeof(InlineFunction<void(float)>));
+  printf("  %-40s %15s %15s\n", "heap per entity (bytes / allocations)", "before", "after");
+  char label[64];
+  for (int callbacks : {1, 2, 3}) {
+    snprintf(label, sizeof(label), "%d callbacks", callbacks);
+    Usage before = heap_per_entity<StdManager>(1000, callbacks);
+    Usage after = heap_per_entity<InlineManager>(1000, callbacks);
+    printf("  %-40s %9zu / %3zu %9zu / %3zu\n", label, before.bytes, before.allocations, after.bytes,
+           after.allocations);
+  }
+  host_test::print_header("");
+  for (int callbacks : {1, 2, 4}) {
+    snprintf(label, sizeof(label), "call with %d callbacks", callbacks);
+    host_test::print_timing(label, time_call<StdManager>(callbacks), time_call<InlineManager>(callbacks));
+  }
+
+  return host_test::failures;
+}
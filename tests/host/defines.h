@@ -0,0 +1,11 @@
+#pragma once
+
+// Replaces esphome/core/defines.h when building the host tests, see script/host_test.
+
+#include "esphome/core/macros.h"
+
+#define ESPHOME_BOARD "host"
+#define ESPHOME_VARIANT "host"
+
+#define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
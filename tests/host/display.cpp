@@ -0,0 +1,300 @@
+#include "host_test.h"
+#include "esphome/components/display/display_buffer.h"
+
+#include <cstring>
+#include <vector>
+
+// A 320x240 RGB565 frame buffer display that counts what is drawn and sent to the panel, drawn to pixel by pixel with
+// a full flush on each update as before, and with the span, block and dirty region support of DisplayBuffer.
+
+using namespace esphome;
+using namespace esphome::display;
+using host_test::time_ns;
+
+namespace {
+
+const int WIDTH = 320;
+const int HEIGHT = 240;
+/// Transfer rate of the SPI bus of a typical panel, to estimate the time a flush takes on a device.
+const double SPI_BITS_PER_SECOND = 40e6;
+
+class CountingDisplay : public DisplayBuffer {
+ public:
+  explicit CountingDisplay(bool accelerated) : accelerated_(accelerated) {
+    this->init_internal_(WIDTH * HEIGHT * 2);
+    this->panel_.assign(WIDTH * HEIGHT * 2, 0);
+    this->flush();
+  }
+  ~CountingDisplay() { ExternalRAMAllocator<uint8_t>().deallocate(this->buffer_, WIDTH * HEIGHT * 2); }
+
+  void update() override {}
+  DisplayType get_display_type() override { return DISPLAY_TYPE_COLOR; }
+  int get_width_internal() override { return WIDTH; }
+  int get_height_internal() override { return HEIGHT; }
+
+  void fill_span(int x, int y, int width, Color color) override {
+    if (this->accelerated_) {
+      DisplayBuffer::fill_span(x, y, width, color);
+    } else {
+      Display::fill_span(x, y, width, color);
+    }
+  }
+  void fill_block(int x, int y, int width, int height, Color color) override {
+    if (this->accelerated_) {
+      DisplayBuffer::fill_block(x, y, width, height, color);
+    } else {
+      Display::fill_block(x, y, width, height, color);
+    }
+  }
+
+  void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                      ColorBitness bitness, bool big_endian, int x_offset = 0, int y_offset = 0,
+                      int x_pad = 0) override {
+    if (!this->accelerated_ || this->rotation_ != DISPLAY_ROTATION_0_DEGREES || bitness != COLOR_BITNESS_565 ||
+        order != COLOR_ORDER_RGB || !big_endian) {
+      Display::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset, x_pad);
+      return;
+    }
+    int x1, x2, y1, y2;
+    if (!this->clamp_x_(x_start, w, x1, x2) || !this->clamp_y_(y_start, h, y1, y2))
+      return;
+    size_t line_stride = x_offset + w + x_pad;
+    for (int y = y1; y < y2; y++) {
+      const uint8_t *src = ptr + ((y_offset + y - y_start) * line_stride + x_offset + x1 - x_start) * 2;
+      memcpy(this->buffer_ + (y * WIDTH + x1) * 2, src, (x2 - x1) * 2);
+    }
+    this->block_pixels += (x2 - x1) * (y2 - y1);
+    this->mark_dirty_(x1, y1, x2 - 1, y2 - 1);
+  }
+
+  /// Send the changed pixels, or all of them without dirty region tracking, to the panel.
+  void flush() {
+    if (!this->accelerated_) {
+      this->send_(0, 0, WIDTH - 1, HEIGHT - 1);
+      return;
+    }
+    size_t band = 0;
+    int x1, y1, x2, y2;
+    while (this->take_dirty_region_(band, x1, y1, x2, y2))
+      this->send_(x1, y1, x2, y2);
+  }
+
+  const std::vector<uint8_t> &panel() const { return this->panel_; }
+
+  uint64_t pixel_calls{0};
+  uint64_t block_pixels{0};
+  uint64_t pushed_pixels{0};
+  uint64_t transfers{0};
+
+ protected:
+  void draw_absolute_pixel_internal(int x, int y, Color color) override {
+    this->pixel_calls++;
+    if (x >= WIDTH || x < 0 || y >= HEIGHT || y < 0)
+      return;
+    uint16_t color565 = ColorUtil::color_to_565(color);
+    uint8_t *pos = this->buffer_ + (y * WIDTH + x) * 2;
+    if (pos[0] == uint8_t(color565 >> 8) && pos[1] == uint8_t(color565))
+      return;
+    pos[0] = color565 >> 8;
+    pos[1] = color565;
+    this->mark_dirty_(x, y, x, y);
+  }
+
+  void fill_absolute_block_internal(int x, int y, int width, int height, Color color) override {
+    if (!this->accelerated_) {
+      DisplayBuffer::fill_absolute_block_internal(x, y, width, height, color);
+      return;
+    }
+    this->block_pixels += width * height;
+    uint16_t color565 = ColorUtil::color_to_565(color);
+    uint8_t high = color565 >> 8, low = color565;
+    bool updated = false;
+    for (int row = y; row < y + height; row++) {
+      uint8_t *pos = this->buffer_ + (row * WIDTH + x) * 2;
+      for (int i = 0; i < width; i++, pos += 2) {
+        if (pos[0] != high || pos[1] != low) {
+          pos[0] = high;
+          pos[1] = low;
+          updated = true;
+        }
+      }
+    }
+    if (updated)
+      this->mark_dirty_(x, y, x + width - 1, y + height - 1);
+  }
+
+  void send_(int x1, int y1, int x2, int y2) {
+    this->transfers++;
+    for (int y = y1; y <= y2; y++) {
+      size_t start = (y * WIDTH + x1) * 2, length = (x2 - x1 + 1) * 2;
+      memcpy(&this->panel_[start], this->buffer_ + start, length);
+      this->pushed_pixels += x2 - x1 + 1;
+    }
+  }
+
+  bool accelerated_;
+  /// What the panel shows, as far as it has been sent.
+  std::vector<uint8_t> panel_;
+};
+
+/// Keeps the colors drawn to it, to check the conversion of draw_pixels_at().
+class RecordingDisplay : public Display {
+ public:
+  RecordingDisplay() : pixels_(256 * 256) {}
+  void update() override {}
+  DisplayType get_display_type() override { return DISPLAY_TYPE_COLOR; }
+  int get_width() override { return 256; }
+  int get_height() override { return 256; }
+  void draw_pixel_at(int x, int y, Color color) override { this->pixels_[y * 256 + x] = color; }
+  Color get(int x, int y) const { return this->pixels_[y * 256 + x]; }
+
+ protected:
+  std::vector<Color> pixels_;
+};
+
+/// An RGB565 test image with a gradient, in big endian byte order like images are stored.
+std::vector<uint8_t> make_image(int width, int height) {
+  std::vector<uint8_t> image;
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      uint16_t color565 = ((x * 31 / width) << 11) | ((y * 63 / height) << 5) | ((x + y) & 0x1F);
+      image.push_back(color565 >> 8);
+      image.push_back(color565);
+    }
+  }
+  return image;
+}
+
+/// A screen of a typical dashboard: a background, cards with a frame and a title bar, an icon and a chart.
+void draw_dashboard(Display &it, const std::vector<uint8_t> &icon, int frame) {
+  it.fill(Color(16, 16, 32));
+  for (int card = 0; card < 4; card++) {
+    int x = 8 + (card % 2) * 156, y = 8 + (card / 2) * 116;
+    it.filled_rectangle(x, y, 148, 108, Color(40, 40, 60));
+    it.rectangle(x, y, 148, 108, Color(120, 120, 160));
+    it.filled_rectangle(x + 1, y + 1, 146, 18, Color(60, 90, 160));
+    it.draw_pixels_at(x + 8, y + 28, 48, 48, icon.data(), COLOR_ORDER_RGB, COLOR_BITNESS_565, true);
+    it.filled_circle(x + 110, y + 60, 20 + (frame + card) % 8, Color(200, 120, 40));
+  }
+  for (int i = 0; i < 60; i++)
+    it.line(170 + i * 2, 200 - (i * 7 + frame) % 40, 172 + i * 2, 200 - ((i + 1) * 7 + frame) % 40, COLOR_ON);
+}
+
+/// Redraw the value of one card, as most updates only change a few numbers.
+void draw_value(Display &it, int frame) {
+  it.filled_rectangle(72, 40, 60, 24, Color(40, 40, 60));
+  it.filled_rectangle(72, 40, 10 + frame % 50, 24, Color(240, 240, 240));
+}
+
+void check_same_result(DisplayRotation rotation, const std::vector<uint8_t> &icon) {
+  CountingDisplay before(false), after(true);
+  before.set_rotation(rotation);
+  after.set_rotation(rotation);
+  for (int frame = 0; frame < 3; frame++) {
+    draw_dashboard(before, icon, frame);
+    draw_dashboard(after, icon, frame);
+    draw_value(before, frame);
+    draw_value(after, frame);
+    before.flush();
+    after.flush();
+    HOST_CHECK(before.panel() == after.panel());
+  }
+  // drawing partly outside of the screen and clipped
+  for (Display *it : {(Display *) &before, (Display *) &after}) {
+    it->filled_rectangle(-20, -20, 60, 60, Color(1, 2, 3));
+    it->filled_rectangle(it->get_width() - 30, it->get_height() - 10, 60, 60, Color(4, 5, 6));
+    it->draw_pixels_at(-10, it->get_height() - 20, 48, 48, icon.data(), COLOR_ORDER_RGB, COLOR_BITNESS_565, true);
+    it->start_clipping(50, 50, 120, 100);
+    it->filled_rectangle(0, 0, 200, 200, Color(7, 8, 9));
+    it->horizontal_line(0, 70, 300, Color(10, 11, 12));
+    it->draw_pixels_at(100, 80, 48, 48, icon.data(), COLOR_ORDER_RGB, COLOR_BITNESS_565, true);
+    it->end_clipping();
+  }
+  before.flush();
+  after.flush();
+  HOST_CHECK(before.panel() == after.panel());
+}
+
+void check_pixel_conversion() {
+  // every RGB565 value, converted as images did before they were drawn with draw_pixels_at()
+  std::vector<uint8_t> data;
+  for (uint32_t value = 0; value < 0x10000; value++) {
+    data.push_back(value >> 8);
+    data.push_back(value);
+  }
+  RecordingDisplay display;
+  display.draw_pixels_at(0, 0, 256, 256, data.data(), COLOR_ORDER_RGB, COLOR_BITNESS_565, true);
+  int mismatches = 0;
+  for (uint32_t value = 0; value < 0x10000; value++) {
+    auto r = (value & 0xF800) >> 11;
+    auto g = (value & 0x07E0) >> 5;
+    auto b = value & 0x001F;
+    Color expected((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 0xFF);
+    Color actual = display.get(value % 256, value / 256);
+    if (!(actual == expected))
+      mismatches++;
+  }
+  HOST_CHECK(mismatches == 0);
+
+  // little endian with the channels swapped
+  std::vector<uint8_t> bgr = {0x1F, 0x00, 0x00, 0xF8};
+  display.draw_pixels_at(0, 0, 2, 1, bgr.data(), COLOR_ORDER_BGR, COLOR_BITNESS_565, false);
+  HOST_CHECK(display.get(0, 0) == Color(255, 0, 0, 255));
+  HOST_CHECK(display.get(1, 0) == Color(0, 0, 255, 255));
+
+  std::vector<uint8_t> rgb24 = {0x12, 0x34, 0x56};
+  display.draw_pixels_at(0, 0, 1, 1, rgb24.data(), COLOR_ORDER_RGB, COLOR_BITNESS_888, true);
+  HOST_CHECK(display.get(0, 0) == Color(0x12, 0x34, 0x56, 0xFF));
+}
+
+struct Counts {
+  double ns;
+  double pixel_calls;
+  double block_pixels;
+  double pushed_pixels;
+};
+
+template<typename F> Counts measure(bool accelerated, uint32_t iterations, F &&draw) {
+  CountingDisplay it(accelerated);
+  int frame = 0;
+  draw(it, frame++);
+  it.flush();
+  it.pixel_calls = it.block_pixels = it.pushed_pixels = 0;
+  double ns = time_ns(iterations, [&]() {
+    draw(it, frame++);
+    it.flush();
+  });
+  return {ns, double(it.pixel_calls) / iterations, double(it.block_pixels) / iterations,
+          double(it.pushed_pixels) / iterations};
+}
+
+template<typename F> void print_counts(const char *name, uint32_t iterations, F &&draw) {
+  Counts before = measure(false, iterations, draw);
+  Counts after = measure(true, iterations, draw);
+  host_test::print_timing(name, before.ns, after.ns);
+  printf("  %-40s %15.0f %15.0f\n", "  draw_absolute_pixel_internal() calls", before.pixel_calls, after.pixel_calls);
+  printf("  %-40s %15.0f %15.0f\n", "  pixels filled or copied as blocks", before.block_pixels, after.block_pixels);
+  printf("  %-40s %15.0f %15.0f\n", "  pixels pushed to the panel", before.pushed_pixels, after.pushed_pixels);
+  printf("  %-40s %12.1f ms %12.1f ms\n", "  time to push them at 40 MHz",
+         before.pushed_pixels * 16 / SPI_BITS_PER_SECOND * 1e3, after.pushed_pixels * 16 / SPI_BITS_PER_SECOND * 1e3);
+}
+
+}  // namespace
+
+int main() {
+  auto icon = make_image(48, 48);
+  for (auto rotation : {DISPLAY_ROTATION_0_DEGREES, DISPLAY_ROTATION_90_DEGREES, DISPLAY_ROTATION_180_DEGREES,
+                        DISPLAY_ROTATION_270_DEGREES})
+    check_same_result(rotation, icon);
+  check_pixel_conversion();
+
+  host_test::print_header("display (320x240 RGB565, per update)");
+  print_counts("full redraw", 200, [&icon](CountingDisplay &it, int frame) { draw_dashboard(it, icon, frame); });
+  print_counts("one value changed", 2000, [&icon](CountingDisplay &it, int frame) { draw_value(it, frame); });
+  print_counts("full screen image", 200, [](CountingDisplay &it, int frame) {
+    static const std::vector<uint8_t> IMAGE = make_image(WIDTH, HEIGHT);
+    it.draw_pixels_at(frame % 2, 0, WIDTH, HEIGHT, IMAGE.data(), COLOR_ORDER_RGB, COLOR_BITNESS_565, true);
+  });
+
+  return host_test::failures;
+}
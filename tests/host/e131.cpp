@@ -0,0 +1,376 @@
+#include "host_test.h"
+#include "esphome/components/e131/e131.h"
+#include "esphome/components/e131/e131_addressable_light_effect.h"
+#include "esphome/components/light/addressable_light.h"
+
+#include <arpa/inet.h>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <set>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+// Replays sACN (E1.31) streams through E131Component over a loopback socket: the datagrams are sent the way a sender
+// like xLights sends them, with the universes of each frame in order and optional synchronization packets, and then
+// read, parsed and shown by the loop of the component.
+
+using namespace esphome;
+using namespace esphome::e131;
+using host_test::time_ns;
+
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  void *ptr = malloc(size);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
+/// The multicast groups joined by the component.
+static std::set<uint32_t> joined_groups;
+
+err_t igmp_joingroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr) {
+  joined_groups.insert(ntohl(groupaddr->addr));
+  return 0;
+}
+err_t igmp_leavegroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr) {
+  joined_groups.erase(ntohl(groupaddr->addr));
+  return 0;
+}
+
+namespace {
+
+const uint16_t PORT = 5568;
+const int LIGHTS = 400;
+/// Universes of the light, with 170 RGB lights each.
+const int FIRST_UNIVERSE = 1;
+const int UNIVERSES = 3;
+const int LIGHTS_PER_UNIVERSE = 170;
+const uint16_t SYNC_UNIVERSE = 7999;
+
+class TestLight : public light::AddressableLight {
+ public:
+  TestLight() : pixels_(LIGHTS * 3), effect_data_(LIGHTS) {}
+  int32_t size() const override { return LIGHTS; }
+  void clear_effect_data() override { std::fill(this->effect_data_.begin(), this->effect_data_.end(), 0); }
+  light::LightTraits get_traits() override {
+    light::LightTraits traits;
+    traits.set_supported_color_modes({light::ColorMode::RGB});
+    return traits;
+  }
+  void write_state(light::LightState *state) override {}
+  const uint8_t *pixel(int index) const { return &this->pixels_[index * 3]; }
+
+ protected:
+  light::ESPColorView get_view_internal(int32_t index) const override {
+    auto *pixel = const_cast<uint8_t *>(&this->pixels_[index * 3]);
+    return {pixel, pixel + 1, pixel + 2, nullptr, const_cast<uint8_t *>(&this->effect_data_[index]),
+            &this->correction_};
+  }
+  bool get_pixel_buffer_internal(light::ESPPixelBuffer *buffer) const override {
+    buffer->data = const_cast<uint8_t *>(this->pixels_.data());
+    buffer->stride = 3;
+    buffer->offsets[0] = 0;
+    buffer->offsets[1] = 1;
+    buffer->offsets[2] = 2;
+    buffer->channels = 3;
+    return true;
+  }
+
+  std::vector<uint8_t> pixels_;
+  std::vector<uint8_t> effect_data_;
+};
+
+class TestLightState : public light::LightState {
+ public:
+  using LightState::LightState;
+  /// Whether the light has been shown since the last call.
+  bool take_shown() {
+    bool shown = this->next_write_;
+    this->next_write_ = false;
+    return shown;
+  }
+};
+
+class TestComponent : public E131Component {
+ public:
+  bool is_ready_watched() const { return this->ready_watched_; }
+};
+
+void put16(std::vector<uint8_t> &packet, size_t pos, uint16_t value) {
+  packet[pos] = value >> 8;
+  packet[pos + 1] = value;
+}
+void put32(std::vector<uint8_t> &packet, size_t pos, uint32_t value) {
+  put16(packet, pos, value >> 16);
+  put16(packet, pos + 2, value);
+}
+
+/// The root layer of ANSI E1.17 that all packets start with.
+std::vector<uint8_t> root_layer(size_t length, uint32_t vector) {
+  static const uint8_t ACN_ID[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+  std::vector<uint8_t> packet(length);
+  put16(packet, 0, 0x0010);
+  memcpy(&packet[4], ACN_ID, sizeof(ACN_ID));
+  put16(packet, 16, 0x7000 | (length - 16));
+  put32(packet, 18, vector);
+  memset(&packet[22], 0xAB, 16);  // CID
+  put16(packet, 38, 0x7000 | (length - 38));
+  return packet;
+}
+
+std::vector<uint8_t> data_packet(uint16_t universe, const uint8_t *data, uint16_t count, uint8_t sequence,
+                                 uint16_t sync_universe = 0) {
+  std::vector<uint8_t> packet = root_layer(126 + count, 4);
+  put32(packet, 40, 2);
+  strcpy(reinterpret_cast<char *>(&packet[44]), "host test");
+  packet[108] = 100;  // priority
+  put16(packet, 109, sync_universe);
+  packet[111] = sequence;
+  put16(packet, 113, universe);
+  put16(packet, 115, 0x7000 | (packet.size() - 115));
+  packet[117] = 2;
+  packet[118] = 0xA1;
+  put16(packet, 121, 1);
+  put16(packet, 123, count + 1);
+  memcpy(&packet[126], data, count);
+  return packet;
+}
+
+std::vector<uint8_t> sync_packet(uint16_t sync_universe, uint8_t sequence) {
+  std::vector<uint8_t> packet = root_layer(49, 8);
+  put32(packet, 40, 1);
+  packet[44] = sequence;
+  put16(packet, 45, sync_universe);
+  return packet;
+}
+
+/// The RGB data of all lights in frame `frame`.
+std::vector<uint8_t> frame_data(int frame) {
+  std::vector<uint8_t> data(LIGHTS * 3);
+  for (size_t i = 0; i < data.size(); i++)
+    data[i] = i * 7 + frame * 13;
+  return data;
+}
+
+/// The packets of one frame, in the order a sender sends them.
+std::vector<std::vector<uint8_t>> frame_packets(int frame, uint16_t sync_universe = 0) {
+  std::vector<uint8_t> data = frame_data(frame);
+  std::vector<std::vector<uint8_t>> packets;
+  for (int i = 0; i < UNIVERSES; i++) {
+    int lights = std::min(LIGHTS_PER_UNIVERSE, LIGHTS - i * LIGHTS_PER_UNIVERSE);
+    packets.push_back(data_packet(FIRST_UNIVERSE + i, &data[i * LIGHTS_PER_UNIVERSE * 3], lights * 3, frame,
+                                  sync_universe));
+  }
+  return packets;
+}
+
+class Sender {
+ public:
+  Sender() {
+    this->fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ::connect(this->fd_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr));
+  }
+  ~Sender() { close(this->fd_); }
+  void send(const std::vector<uint8_t> &packet) {
+    HOST_CHECK(::send(this->fd_, packet.data(), packet.size(), 0) == ssize_t(packet.size()));
+  }
+  void send(const std::vector<std::vector<uint8_t>> &packets) {
+    for (auto &packet : packets)
+      this->send(packet);
+  }
+
+ protected:
+  int fd_;
+};
+
+struct Fixture {
+  TestComponent e131;
+  TestLight light;
+  TestLightState state{&light};
+  E131AddressableLightEffect effect{"e131"};
+  Sender sender;
+
+  Fixture() {
+    this->e131.set_sync_universe(SYNC_UNIVERSE);
+    this->e131.setup();
+    this->state.set_gamma_correct(1.0f);
+    this->light.setup_state(&this->state);
+    this->effect.set_first_universe(FIRST_UNIVERSE);
+    this->effect.set_channels(E131_RGB);
+    this->effect.set_e131(&this->e131);
+    this->effect.init_internal(&this->state);
+    this->effect.start_internal();
+  }
+
+  /// Run the loop of the component like the application does, once it's been woken up by the socket.
+  void loop() {
+    this->e131.enable_loop();
+    this->e131.loop();
+  }
+
+  bool shows_frame(int frame) {
+    std::vector<uint8_t> data = frame_data(frame);
+    for (int i = 0; i < LIGHTS; i++) {
+      if (memcmp(this->light.pixel(i), &data[i * 3], 3) != 0)
+        return false;
+    }
+    return true;
+  }
+};
+
+void check_stream(Fixture &f) {
+  // the light joins the groups of its universes and the synchronization universe
+  HOST_CHECK(f.e131.is_ready_watched());
+  HOST_CHECK(joined_groups == std::set<uint32_t>({0xEFFF0001, 0xEFFF0002, 0xEFFF0003, 0xEFFF1F3F}));
+
+  // complete frames are shown right away
+  for (int frame = 0; frame < 5; frame++) {
+    f.sender.send(frame_packets(frame));
+    f.loop();
+    HOST_CHECK(f.state.take_shown());
+    HOST_CHECK(f.shows_frame(frame));
+    HOST_CHECK(!f.e131.is_loop_enabled());
+  }
+
+  // a frame isn't shown before all its universes have arrived
+  auto packets = frame_packets(5);
+  f.sender.send(packets[0]);
+  f.sender.send(packets[1]);
+  f.loop();
+  HOST_CHECK(!f.state.take_shown());
+  f.sender.send(packets[2]);
+  f.loop();
+  HOST_CHECK(f.state.take_shown());
+  HOST_CHECK(f.shows_frame(5));
+
+  // a complete frame followed by a part of the next one in the same loop is shown one loop later
+  f.sender.send(frame_packets(6));
+  f.sender.send(frame_packets(7)[0]);
+  f.loop();
+  HOST_CHECK(!f.state.take_shown());
+  HOST_CHECK(f.e131.is_loop_enabled());
+  f.e131.loop();
+  HOST_CHECK(f.state.take_shown());
+  f.sender.send(frame_packets(7)[1]);
+  f.sender.send(frame_packets(7)[2]);
+  f.loop();
+  HOST_CHECK(f.state.take_shown());
+  HOST_CHECK(f.shows_frame(7));
+}
+
+void check_drain(Fixture &f) {
+  // a backlog is read 32 datagrams per loop, and only the last complete frame is shown
+  for (int frame = 10; frame < 30; frame++)
+    f.sender.send(frame_packets(frame));
+  f.loop();
+  // 10 frames and 2 universes of the next one
+  HOST_CHECK(!f.state.take_shown());
+  HOST_CHECK(f.e131.is_loop_enabled());
+  f.e131.loop();
+  HOST_CHECK(f.state.take_shown());
+  HOST_CHECK(f.shows_frame(29));
+  HOST_CHECK(!f.e131.is_loop_enabled());
+}
+
+void check_sync(Fixture &f) {
+  // a frame that waits for a synchronization packet is only shown once it arrives
+  f.sender.send(frame_packets(40, SYNC_UNIVERSE));
+  f.loop();
+  HOST_CHECK(!f.state.take_shown());
+  f.sender.send(sync_packet(SYNC_UNIVERSE + 1, 40));
+  f.loop();
+  HOST_CHECK(!f.state.take_shown());
+  f.sender.send(sync_packet(SYNC_UNIVERSE, 40));
+  f.loop();
+  HOST_CHECK(f.state.take_shown());
+  HOST_CHECK(f.shows_frame(40));
+
+  // frames and their synchronization packets read in the same loop
+  f.sender.send(frame_packets(41, SYNC_UNIVERSE));
+  f.sender.send(sync_packet(SYNC_UNIVERSE, 41));
+  f.sender.send(frame_packets(42, SYNC_UNIVERSE));
+  f.sender.send(sync_packet(SYNC_UNIVERSE, 42));
+  f.loop();
+  HOST_CHECK(f.state.take_shown());
+  HOST_CHECK(f.shows_frame(42));
+
+  // a lost synchronization packet doesn't hold back the frame for good, it's shown once the next frame has started
+  f.sender.send(frame_packets(43, SYNC_UNIVERSE));
+  f.loop();
+  HOST_CHECK(!f.state.take_shown());
+  f.sender.send(frame_packets(44, SYNC_UNIVERSE)[0]);
+  f.loop();
+  HOST_CHECK(!f.state.take_shown());
+  f.e131.loop();
+  HOST_CHECK(f.state.take_shown());
+}
+
+void check_invalid(Fixture &f) {
+  f.sender.send(frame_packets(50));
+  f.loop();
+  HOST_CHECK(f.state.take_shown());
+
+  std::vector<uint8_t> data = frame_data(51);
+  auto packet = data_packet(FIRST_UNIVERSE, data.data(), 510, 51);
+  auto truncated = packet;
+  truncated.resize(300);
+  auto bad_id = packet;
+  bad_id[4] = 'X';
+  auto bad_start_code = packet;
+  bad_start_code[125] = 0xDD;
+  auto other_universe = data_packet(FIRST_UNIVERSE + UNIVERSES, data.data(), 510, 51);
+  auto bad_sync = sync_packet(SYNC_UNIVERSE, 51);
+  bad_sync.resize(40);
+  for (auto *p : {&truncated, &bad_id, &bad_start_code, &other_universe, &bad_sync})
+    f.sender.send(*p);
+  f.loop();
+  HOST_CHECK(!f.state.take_shown());
+  HOST_CHECK(f.shows_frame(50));
+  HOST_CHECK(!f.e131.is_loop_enabled());
+}
+
+}  // namespace
+
+int main() {
+  Fixture f;
+  check_stream(f);
+  check_drain(f);
+  check_sync(f);
+  check_invalid(f);
+
+  // receiving, parsing and showing frames doesn't allocate
+  f.sender.send(frame_packets(60));
+  f.loop();
+  size_t loop_allocations = 0;
+  for (int frame = 61; frame < 100; frame++) {
+    f.sender.send(frame_packets(frame, frame % 2 ? SYNC_UNIVERSE : 0));
+    if (frame % 2)
+      f.sender.send(sync_packet(SYNC_UNIVERSE, frame));
+    size_t before = allocations;
+    f.loop();
+    loop_allocations += allocations - before;
+  }
+  HOST_CHECK(loop_allocations == 0);
+  HOST_CHECK(f.shows_frame(99));
+
+  host_test::print_header("e131");
+  int frame = 0;
+  double ns = time_ns(2000, [&]() {
+    f.sender.send(frame_packets(frame++));
+    f.loop();
+  });
+  printf("  %-40s %12.1f ns\n", "send and show a frame of 3 universes", ns);
+
+  return host_test::failures;
+}
@@ -0,0 +1,11 @@
+#include "host_test.h"
+
+// The host platform's main() calls these, but the tests have their own main().
+void setup() {}
+void loop() {}
+
+namespace host_test {
+
+int failures = 0;
+
+}  // namespace host_test
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Helpers shared by the host tests, see README.md.
+
+namespace host_test {
+
+/// Number of failed checks so far, returned by main() as the exit code.
+extern int failures;
+
+#define HOST_CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      host_test::failures++; \
+    } \
+  } while (false)
+
+/// Call `func` `iterations` times and return the average time per call in nanoseconds.
+template<typename F> double time_ns(uint32_t iterations, F &&func) {
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; i++)
+    func();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+/// Print one row of a comparison between the previous and the current implementation.
+inline void print_timing(const char *name, double before_ns, double after_ns) {
+  printf("  %-40s %12.1f ns %12.1f ns %8.2fx\n", name, before_ns, after_ns, before_ns / after_ns);
+}
+
+inline void print_header(const char *title) {
+  printf("%s\n  %-40s %15s %15s %9s\n", title, "", "before", "after", "speedup");
+}
+
+}  // namespace host_test
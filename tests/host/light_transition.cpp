@@ -0,0 +1,351 @@
+#include "host_test.h"
+#include "esphome/components/light/addressable_light.h"
+#include "esphome/components/light/transformers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Checks the fixed-point light transitions against the float implementation they replaced, for PWM (brightness
+// only), cold/warm white and 1000 pixel addressable lights, and compares their speed.
+
+using namespace esphome;
+using namespace esphome::light;
+using host_test::time_ns;
+
+namespace {
+
+const int PIXELS = 1000;
+/// Long enough that the few ms that pass between stepping the transitions and applying them don't matter.
+const uint32_t LENGTH = 1000000;
+/// Accuracy relative to the difference between start and end: the smoothing table is accurate to 2e-4, the 16.16
+/// fixed-point values add a little rounding.
+const float TOLERANCE = 2.5e-4f;
+
+/// LightTransitionTransformer before it used fixed-point.
+class FloatTransition : public LightTransformer {
+ public:
+  void start() override {
+    if (!this->start_values_.is_on() && this->target_values_.is_on()) {
+      this->start_values_ = LightColorValues(this->target_values_);
+      this->start_values_.set_brightness(0.0f);
+    }
+    if (this->start_values_.is_on() && !this->target_values_.is_on()) {
+      this->end_values_ = LightColorValues(this->start_values_);
+      this->end_values_.set_brightness(0.0f);
+    } else {
+      this->end_values_ = LightColorValues(this->target_values_);
+    }
+    if (this->start_values_.get_color_mode() != this->target_values_.get_color_mode()) {
+      this->changing_color_mode_ = true;
+      this->intermediate_values_ = this->start_values_;
+      this->intermediate_values_.set_state(false);
+    }
+  }
+
+  optional<LightColorValues> apply() override {
+    float p = this->get_progress_();
+    if (this->changing_color_mode_ && p > 0.5f &&
+        this->intermediate_values_.get_color_mode() != this->target_values_.get_color_mode()) {
+      this->intermediate_values_ = this->target_values_;
+      this->intermediate_values_.set_state(false);
+    }
+    LightColorValues &start = this->changing_color_mode_ && p > 0.5f ? this->intermediate_values_ : this->start_values_;
+    LightColorValues &end = this->changing_color_mode_ && p < 0.5f ? this->intermediate_values_ : this->end_values_;
+    if (this->changing_color_mode_)
+      p = p < 0.5f ? p * 2 : (p - 0.5) * 2;
+    return LightColorValues::lerp(start, end, smoothed_progress(p));
+  }
+
+  static float smoothed_progress(float x) { return x * x * x * (x * (x * 6.0f - 15.0f) + 10.0f); }
+
+ protected:
+  bool changing_color_mode_{false};
+  LightColorValues end_values_{};
+  LightColorValues intermediate_values_{};
+};
+
+class TestLight : public AddressableLight {
+ public:
+  TestLight() : pixels_(PIXELS * 3), effect_data_(PIXELS) {}
+  int32_t size() const override { return PIXELS; }
+  void clear_effect_data() override { std::fill(this->effect_data_.begin(), this->effect_data_.end(), 0); }
+  LightTraits get_traits() override {
+    LightTraits traits;
+    traits.set_supported_color_modes({ColorMode::RGB});
+    return traits;
+  }
+  void write_state(LightState *state) override {}
+  std::vector<uint8_t> &pixels() { return this->pixels_; }
+  void set_local_brightness(uint8_t brightness) { this->correction_.set_local_brightness(brightness); }
+
+  /// led = add + led * inv_alpha8 on all pixels, as AddressableLightTransformer does it with map_channels_().
+  void blend_all(const Color &add, uint8_t inv_alpha8) {
+    for (uint8_t channel = 0; channel < 3; channel++) {
+      uint8_t table[256];
+      for (uint16_t raw = 0; raw < 256; raw++) {
+        uint8_t value = this->correction_.color_uncorrect_channel(channel, raw);
+        uint8_t mapped = std::min(add.raw[channel] + esp_scale8(value, inv_alpha8), 255);
+        table[raw] = this->correction_.color_correct_channel(channel, mapped);
+      }
+      for (size_t i = channel; i < this->pixels_.size(); i += 3)
+        this->pixels_[i] = table[this->pixels_[i]];
+    }
+  }
+
+ protected:
+  ESPColorView get_view_internal(int32_t index) const override {
+    auto *pixel = const_cast<uint8_t *>(&this->pixels_[index * 3]);
+    return {pixel, pixel + 1, pixel + 2, nullptr, const_cast<uint8_t *>(&this->effect_data_[index]),
+            &this->correction_};
+  }
+  bool get_pixel_buffer_internal(ESPPixelBuffer *buffer) const override {
+    buffer->data = const_cast<uint8_t *>(this->pixels_.data());
+    buffer->stride = 3;
+    buffer->offsets[0] = 0;
+    buffer->offsets[1] = 1;
+    buffer->offsets[2] = 2;
+    buffer->channels = 3;
+    return true;
+  }
+
+  std::vector<uint8_t> pixels_;
+  std::vector<uint8_t> effect_data_;
+};
+
+/// AddressableLightTransformer before it used fixed-point.
+class FloatAddressableTransition : public FloatTransition {
+ public:
+  FloatAddressableTransition(TestLight &light) : light_(light) {}
+
+  void start() override {
+    this->target_color_ = color_from_light_color_values(this->target_values_);
+    this->light_.set_local_brightness(255);
+    this->target_color_ *= to_uint8_scale(this->target_values_.get_brightness() * this->target_values_.get_state());
+  }
+
+  optional<LightColorValues> apply() override {
+    float smoothed_progress = FloatTransition::smoothed_progress(this->get_progress_());
+    float denom = (1.0f - smoothed_progress);
+    float alpha = denom == 0.0f ? 1.0f : (smoothed_progress - this->last_transition_progress_) / denom;
+    float alpha255 = alpha * 255.0f;
+    float alpha255int = floorf(alpha255);
+    float alpha255remainder = alpha255 - alpha255int;
+    this->accumulated_alpha_ += alpha255remainder;
+    float alpha_add = floorf(this->accumulated_alpha_);
+    this->accumulated_alpha_ -= alpha_add;
+    alpha255 += alpha_add;
+    alpha255 = clamp(alpha255, 0.0f, 255.0f);
+    auto alpha8 = static_cast<uint8_t>(alpha255);
+    if (alpha8 != 0)
+      this->light_.blend_all(this->target_color_ * alpha8, 255 - alpha8);
+    this->last_transition_progress_ = smoothed_progress;
+    this->light_.schedule_show();
+    return {};
+  }
+
+ protected:
+  TestLight &light_;
+  Color target_color_{};
+  float last_transition_progress_{0.0f};
+  float accumulated_alpha_{0.0f};
+};
+
+/// Exposes the fixed-point smoothing of the transformers.
+class Smoothing : public LightTransformer {
+ public:
+  static uint32_t fixed(uint32_t x) { return smoothed_progress_fixed_(x); }
+};
+
+/// A transformer whose progress can be set, by moving its start time.
+template<typename T> class Stepped : public T {
+ public:
+  using T::T;
+  /// Move the start, so that \p elapsed ms of the transition have passed at \p now.
+  void set_elapsed(uint32_t now, uint32_t elapsed) { this->start_time_ = now - elapsed; }
+};
+
+LightColorValues random_values(std::mt19937 &rng, ColorMode mode) {
+  std::uniform_real_distribution<float> value(0.0f, 1.0f);
+  std::uniform_real_distribution<float> mireds(153.0f, 500.0f);
+  bool on = value(rng) < 0.8f;
+  return LightColorValues(mode, on ? 1.0f : 0.0f, value(rng), value(rng), value(rng), value(rng), value(rng),
+                          value(rng), mireds(rng), value(rng), value(rng));
+}
+
+/// Largest difference between two values, relative to the difference between the start and the end of the transition.
+float relative_error(const LightColorValues &a, const LightColorValues &b, const LightColorValues &start,
+                     const LightColorValues &end) {
+  float (LightColorValues::*getters[])() const = {
+      &LightColorValues::get_state,            &LightColorValues::get_brightness,
+      &LightColorValues::get_color_brightness, &LightColorValues::get_red,
+      &LightColorValues::get_green,            &LightColorValues::get_blue,
+      &LightColorValues::get_white,            &LightColorValues::get_color_temperature,
+      &LightColorValues::get_cold_white,       &LightColorValues::get_warm_white,
+  };
+  float error = 0;
+  for (auto getter : getters) {
+    float range = std::max(std::fabs((end.*getter)() - (start.*getter)()), 1.0f);
+    error = std::max(error, std::fabs((a.*getter)() - (b.*getter)()) / range);
+  }
+  return error;
+}
+
+/// Step both implementations through transitions between random values and return the largest error.
+float compare(ColorMode from_mode, ColorMode to_mode, uint32_t seed) {
+  std::mt19937 rng(seed);
+  float error = 0;
+  for (int transition = 0; transition < 200; transition++) {
+    LightColorValues start = random_values(rng, from_mode), target = random_values(rng, to_mode);
+    Stepped<FloatTransition> before;
+    Stepped<LightTransitionTransformer> after;
+    before.setup(start, target, LENGTH);
+    after.setup(start, target, LENGTH);
+    // an odd number of steps skips the exact middle, where the previous implementation showed the start values in the
+    // color mode of the target while changing the color mode
+    for (uint32_t step = 0; step <= 255; step++) {
+      uint32_t now = millis();
+      before.set_elapsed(now, step * LENGTH / 255);
+      after.set_elapsed(now, step * LENGTH / 255);
+      LightColorValues a = *before.apply(), b = *after.apply();
+      HOST_CHECK(a.get_color_mode() == b.get_color_mode());
+      error = std::max(error, relative_error(a, b, start, target));
+    }
+    // both end on the target
+    HOST_CHECK(relative_error(*after.apply(), *before.apply(), start, target) < 1e-6f);
+  }
+  return error;
+}
+
+struct AddressableFixture {
+  TestLight light;
+  LightState state{&light};
+  AddressableFixture() { this->light.setup_state(&this->state); }
+};
+
+/// Run the same transitions on two lights with the same pixels and return the largest difference of a channel.
+int compare_addressable(uint32_t seed) {
+  std::mt19937 rng(seed);
+  AddressableFixture before_light, after_light;
+  for (auto &pixel : before_light.light.pixels())
+    pixel = rng();
+  after_light.light.pixels() = before_light.light.pixels();
+
+  int max_difference = 0;
+  for (int transition = 0; transition < 20; transition++) {
+    LightColorValues start = random_values(rng, ColorMode::RGB), target = random_values(rng, ColorMode::RGB);
+    Stepped<FloatAddressableTransition> before(before_light.light);
+    Stepped<AddressableLightTransformer> after(after_light.light);
+    before.setup(start, target, LENGTH);
+    after.setup(start, target, LENGTH);
+    // the frames of a transition at 60 fps
+    const uint32_t frames = 60;
+    for (uint32_t frame = 1; frame <= frames; frame++) {
+      uint32_t now = millis();
+      before.set_elapsed(now, frame * LENGTH / frames);
+      after.set_elapsed(now, frame * LENGTH / frames);
+      before.apply();
+      after.apply();
+      auto &a = before_light.light.pixels(), &b = after_light.light.pixels();
+      for (size_t i = 0; i < a.size(); i++)
+        max_difference = std::max(max_difference, std::abs(a[i] - b[i]));
+    }
+    HOST_CHECK(before_light.light.pixels() == after_light.light.pixels());
+  }
+  return max_difference;
+}
+
+template<typename T> double time_step(ColorMode from_mode, ColorMode to_mode) {
+  std::mt19937 rng(7);
+  Stepped<T> transition;
+  transition.setup(random_values(rng, from_mode), random_values(rng, to_mode), LENGTH);
+  const uint32_t now = millis();
+  uint32_t elapsed = 0;
+  float sink = 0;
+  double ns = time_ns(1000000, [&]() {
+    elapsed = (elapsed + 7919) % (LENGTH / 2);
+    transition.set_elapsed(now, elapsed);
+    sink += transition.apply()->get_brightness();
+  });
+  HOST_CHECK(!std::isnan(sink));
+  return ns;
+}
+
+/// Time of the smoothing and interpolation alone, as reading the clock takes a good part of a step on the host.
+template<bool FIXED> double time_interpolation(ColorMode mode) {
+  std::mt19937 rng(7);
+  LightColorValues start = random_values(rng, mode), end = random_values(rng, mode);
+  LightColorValuesLerp lerp;
+  lerp.setup(start, end);
+  uint32_t x = 0;
+  float sink = 0;
+  double ns = time_ns(1000000, [&]() {
+    x = (x + 7919) & 0xFFFF;
+    if (FIXED) {
+      sink += lerp.at(Smoothing::fixed(x)).get_brightness();
+    } else {
+      sink += LightColorValues::lerp(start, end, FloatTransition::smoothed_progress(x / 65536.0f)).get_brightness();
+    }
+  });
+  HOST_CHECK(!std::isnan(sink));
+  return ns;
+}
+
+/// Time per frame of transitions between two colors on a 1000 pixel light, at 60 frames per transition.
+template<typename T> double time_addressable_frame() {
+  AddressableFixture fixture;
+  Stepped<T> transition(fixture.light);
+  std::mt19937 rng(7);
+  LightColorValues colors[2] = {random_values(rng, ColorMode::RGB), random_values(rng, ColorMode::RGB)};
+  colors[0].set_state(1.0f);
+  colors[1].set_state(1.0f);
+  const uint32_t now = millis();
+  uint32_t frame = 0;
+  return time_ns(20000, [&]() {
+    if (frame % 60 == 0)
+      transition.setup(colors[(frame / 60) % 2], colors[(frame / 60 + 1) % 2], LENGTH);
+    frame++;
+    transition.set_elapsed(now, (frame % 60) * LENGTH / 60);
+    transition.apply();
+  });
+}
+
+}  // namespace
+
+int main() {
+  {
+    // PWM lights have a single brightness channel, CWWW lights two white channels
+    float error = compare(ColorMode::BRIGHTNESS, ColorMode::BRIGHTNESS, 1);
+    printf("PWM: largest relative error %.2e\n", error);
+    HOST_CHECK(error < TOLERANCE);
+    error = compare(ColorMode::COLD_WARM_WHITE, ColorMode::COLD_WARM_WHITE, 2);
+    printf("CWWW: largest relative error %.2e\n", error);
+    HOST_CHECK(error < TOLERANCE);
+    error = compare(ColorMode::RGB, ColorMode::COLD_WARM_WHITE, 3);
+    printf("RGB to CWWW: largest relative error %.2e\n", error);
+    HOST_CHECK(error < TOLERANCE);
+  }
+
+  {
+    int difference = compare_addressable(4);
+    printf("addressable: largest difference of a channel %d\n", difference);
+    HOST_CHECK(difference <= 4);
+  }
+
+  host_test::print_header("light_transition (time per step)");
+  host_test::print_timing("PWM", time_step<FloatTransition>(ColorMode::BRIGHTNESS, ColorMode::BRIGHTNESS),
+                          time_step<LightTransitionTransformer>(ColorMode::BRIGHTNESS, ColorMode::BRIGHTNESS));
+  host_test::print_timing(
+      "CWWW", time_step<FloatTransition>(ColorMode::COLD_WARM_WHITE, ColorMode::COLD_WARM_WHITE),
+      time_step<LightTransitionTransformer>(ColorMode::COLD_WARM_WHITE, ColorMode::COLD_WARM_WHITE));
+  host_test::print_timing("PWM, without reading the clock", time_interpolation<false>(ColorMode::BRIGHTNESS),
+                          time_interpolation<true>(ColorMode::BRIGHTNESS));
+  host_test::print_timing("CWWW, without reading the clock", time_interpolation<false>(ColorMode::COLD_WARM_WHITE),
+                          time_interpolation<true>(ColorMode::COLD_WARM_WHITE));
+  host_test::print_timing("addressable, 1000 pixels", time_addressable_frame<FloatAddressableTransition>(),
+                          time_addressable_frame<AddressableLightTransformer>());
+
+  return host_test::failures;
+}
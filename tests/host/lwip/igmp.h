@@ -0,0 +1,10 @@
+#pragma once
+
+#include "ip_addr.h"
+
+static const ip4_addr_t IP4_ADDR_ANY4_VALUE = {0};
+#define IP4_ADDR_ANY4 (&IP4_ADDR_ANY4_VALUE)
+
+/// Defined by the tests that need them, to check the groups that are joined.
+err_t igmp_joingroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr);
+err_t igmp_leavegroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr);
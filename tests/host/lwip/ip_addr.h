@@ -0,0 +1,30 @@
+#pragma once
+
+// The IPv4 part of the lwIP address API that esphome/components/network/ip_address.h uses, so that components built
+// for lwIP can be built for the host tests. Addresses are in network byte order, like in lwIP.
+
+#include <arpa/inet.h>
+#include <cstdint>
+
+typedef uint8_t u8_t;
+typedef int8_t err_t;
+
+struct ip4_addr_t {
+  uint32_t addr;
+};
+typedef ip4_addr_t ip_addr_t;
+
+#define IP_ADDR4(ipaddr, a, b, c, d) \
+  ((ipaddr)->addr = htonl((uint32_t(a) << 24) | (uint32_t(b) << 16) | (uint32_t(c) << 8) | uint32_t(d)))
+#define ip_addr_set_zero(ipaddr) ((ipaddr)->addr = 0)
+#define ip_addr_copy(dest, src) ((dest).addr = (src).addr)
+#define ip_addr_isany(ipaddr) ((ipaddr) == nullptr || (ipaddr)->addr == 0)
+#define ip_addr_cmp(addr1, addr2) ((addr1)->addr == (addr2)->addr)
+#define IP_IS_V4(ipaddr) true
+#define IP_IS_V6(ipaddr) false
+
+inline int ipaddr_aton(const char *cp, ip_addr_t *addr) { return inet_pton(AF_INET, cp, &addr->addr); }
+inline char *ipaddr_ntoa(const ip_addr_t *addr) {
+  static char buf[INET_ADDRSTRLEN];
+  return const_cast<char *>(inet_ntop(AF_INET, &addr->addr, buf, sizeof(buf)));
+}
@@ -0,0 +1,228 @@
+#include "host_test.h"
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/scheduler.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Compares re-arming and cancelling named timeouts with the scheduler as it was before items were indexed by name:
+// every cancel scanned `items_` and `to_add_` with string compares, and every timeout allocated a new item.
+
+using namespace esphome;
+using host_test::time_ns;
+
+namespace {
+
+/// The previous scheduler, reduced to timeouts.
+class LinearScheduler {
+ public:
+  void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> func) {
+    const uint32_t now = millis();
+    if (!name.empty())
+      this->cancel_timeout(component, name);
+    auto item = make_unique<SchedulerItem>();
+    item->component = component;
+    item->name = name;
+    item->timeout = timeout;
+    item->last_execution = now;
+    item->callback = std::move(func);
+    item->remove = false;
+    LockGuard guard{this->lock_};
+    this->to_add_.push_back(std::move(item));
+  }
+  bool cancel_timeout(Component *component, const std::string &name) {
+    LockGuard guard{this->lock_};
+    bool ret = false;
+    for (auto &it : this->items_) {
+      if (it->component == component && it->name == name && !it->remove) {
+        this->to_remove_++;
+        it->remove = true;
+        ret = true;
+      }
+    }
+    for (auto &it : this->to_add_) {
+      if (it->component == component && it->name == name) {
+        it->remove = true;
+        ret = true;
+      }
+    }
+    return ret;
+  }
+  void call() {
+    const uint32_t now = millis();
+    this->process_to_add();
+    if (this->to_remove_ > 10) {
+      std::vector<std::unique_ptr<SchedulerItem>> valid_items;
+      while (!this->empty_()) {
+        LockGuard guard{this->lock_};
+        auto item = std::move(this->items_[0]);
+        this->pop_raw_();
+        valid_items.push_back(std::move(item));
+      }
+      LockGuard guard{this->lock_};
+      this->items_ = std::move(valid_items);
+    }
+    while (!this->empty_()) {
+      auto &item = this->items_[0];
+      if (now - item->last_execution < item->timeout)
+        break;
+      item->callback();
+      this->lock_.lock();
+      auto done = std::move(this->items_[0]);
+      this->pop_raw_();
+      this->lock_.unlock();
+      if (done->remove)
+        this->to_remove_--;
+    }
+    this->process_to_add();
+  }
+  void process_to_add() {
+    LockGuard guard{this->lock_};
+    for (auto &it : this->to_add_) {
+      if (it->remove)
+        continue;
+      this->items_.push_back(std::move(it));
+      std::push_heap(this->items_.begin(), this->items_.end(), cmp);
+    }
+    this->to_add_.clear();
+  }
+
+ protected:
+  struct SchedulerItem {
+    Component *component;
+    std::string name;
+    uint32_t timeout;
+    uint32_t last_execution;
+    std::function<void()> callback;
+    bool remove;
+  };
+
+  static bool cmp(const std::unique_ptr<SchedulerItem> &a, const std::unique_ptr<SchedulerItem> &b) {
+    return a->last_execution + a->timeout > b->last_execution + b->timeout;
+  }
+  bool empty_() {
+    while (!this->items_.empty() && this->items_[0]->remove) {
+      this->to_remove_--;
+      LockGuard guard{this->lock_};
+      this->pop_raw_();
+    }
+    return this->items_.empty();
+  }
+  void pop_raw_() {
+    std::pop_heap(this->items_.begin(), this->items_.end(), cmp);
+    this->items_.pop_back();
+  }
+
+  Mutex lock_;
+  std::vector<std::unique_ptr<SchedulerItem>> items_;
+  std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  uint32_t to_remove_{0};
+};
+
+class TestScheduler : public Scheduler {
+ public:
+  size_t item_count() { return this->items_.size() + this->to_add_.size(); }
+};
+
+Component components[4];
+
+/// Check the cancel and re-arm semantics both schedulers are expected to share.
+template<typename S> void check_semantics(S &s) {
+  int runs[4] = {};
+  s.set_timeout(&components[0], "a", 0, [&runs]() { runs[0]++; });
+  s.set_timeout(&components[0], "a", 0, [&runs]() { runs[1]++; });
+  s.set_timeout(&components[1], "a", 0, [&runs]() { runs[2]++; });
+  s.set_timeout(&components[0], "", 0, [&runs]() { runs[3]++; });
+  s.set_timeout(&components[0], "", 0, [&runs]() { runs[3]++; });
+  HOST_CHECK(s.cancel_timeout(&components[1], "a"));
+  HOST_CHECK(!s.cancel_timeout(&components[2], "a"));
+  s.call();
+  HOST_CHECK(runs[0] == 0);
+  HOST_CHECK(runs[1] == 1);
+  HOST_CHECK(runs[2] == 0);
+  HOST_CHECK(runs[3] == 2);
+  HOST_CHECK(!s.cancel_timeout(&components[0], "a"));
+
+  // a timeout that re-arms itself from its callback
+  int rearmed = 0;
+  s.set_timeout(&components[0], "self", 0, [&s, &rearmed]() {
+    if (++rearmed < 3)
+      s.set_timeout(&components[0], "self", 0, [&rearmed]() { rearmed = 100; });
+  });
+  s.call();
+  s.call();
+  HOST_CHECK(rearmed == 100);
+}
+
+/// Time re-arming timeouts while `count` named timeouts are pending.
+template<typename S> double time_rearm(uint32_t count, const std::vector<std::string> &names) {
+  S s;
+  for (uint32_t i = 0; i < count; i++)
+    s.set_timeout(&components[i % 4], names[i], 60000, []() {});
+  s.call();
+  uint32_t i = 0;
+  return time_ns(200000, [&]() {
+    uint32_t n = (i * 7919) % count;
+    s.set_timeout(&components[n % 4], names[n], 60000, []() {});
+    if (++i % 16 == 0)
+      s.call();
+  });
+}
+
+template<typename S> double time_cancel_missing(uint32_t count, const std::vector<std::string> &names) {
+  S s;
+  for (uint32_t i = 0; i < count; i++)
+    s.set_timeout(&components[i % 4], names[i], 60000, []() {});
+  s.call();
+  const std::string missing = "missing";
+  return time_ns(200000, [&]() { s.cancel_timeout(&components[0], missing); });
+}
+
+}  // namespace
+
+int main() {
+  {
+    LinearScheduler linear;
+    check_semantics(linear);
+    TestScheduler indexed;
+    check_semantics(indexed);
+    // the previous scheduler also reported pending timeouts as cancelled a second time
+    indexed.set_timeout(&components[0], "b", 0, []() {});
+    HOST_CHECK(indexed.cancel_timeout(&components[0], "b"));
+    HOST_CHECK(!indexed.cancel_timeout(&components[0], "b"));
+  }
+
+  {
+    // re-arming must not leave cancelled items behind
+    TestScheduler s;
+    for (int round = 0; round < 100; round++) {
+      for (int i = 0; i < 50; i++)
+        s.set_timeout(&components[0], "t" + to_string(i), 60000, []() {});
+      s.call();
+    }
+    HOST_CHECK(s.item_count() <= 50 + 50 / 4 + 10);
+  }
+
+  std::vector<std::string> names;
+  for (uint32_t i = 0; i < 1000; i++)
+    names.push_back("heartbeat_" + to_string(i));
+
+  host_test::print_header("scheduler");
+  char label[64];
+  for (uint32_t count : {10, 100, 500, 1000}) {
+    snprintf(label, sizeof(label), "re-arm with %u timeouts", count);
+    host_test::print_timing(label, time_rearm<LinearScheduler>(count, names), time_rearm<TestScheduler>(count, names));
+  }
+  for (uint32_t count : {10, 1000}) {
+    snprintf(label, sizeof(label), "cancel missing with %u timeouts", count);
+    host_test::print_timing(label, time_cancel_missing<LinearScheduler>(count, names),
+                            time_cancel_missing<TestScheduler>(count, names));
+  }
+
+  return host_test::failures;
+}
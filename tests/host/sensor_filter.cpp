@@ -0,0 +1,194 @@
+#include "host_test.h"
+#include "esphome/components/sensor/filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Checks the sliding window sensor filters against the implementation they replaced, which kept the window in a
+// std::deque and went over all of it every time a value was sent, and compares their speed.
+
+using namespace esphome;
+using namespace esphome::sensor;
+using host_test::time_ns;
+
+namespace {
+
+enum FilterType { MEDIAN, QUANTILE, MIN, MAX, AVERAGE };
+const char *const FILTER_NAMES[] = {"median", "quantile", "min", "max", "moving average"};
+const float QUANTILE_VALUE = 0.9f;
+
+/// The previous filters.
+class DequeFilter {
+ public:
+  DequeFilter(FilterType type, size_t window_size, size_t send_every, size_t send_first_at)
+      : type_(type), send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+
+  optional<float> new_value(float value) {
+    while (this->queue_.size() >= this->window_size_)
+      this->queue_.pop_front();
+    this->queue_.push_back(value);
+    if (++this->send_at_ >= this->send_every_) {
+      this->send_at_ = 0;
+      return this->compute_();
+    }
+    return {};
+  }
+
+ protected:
+  float compute_() {
+    std::vector<float> valid;
+    for (auto v : this->queue_) {
+      if (!std::isnan(v))
+        valid.push_back(v);
+    }
+    if (valid.empty())
+      return NAN;
+    switch (this->type_) {
+      case MEDIAN:
+        std::sort(valid.begin(), valid.end());
+        if (valid.size() % 2)
+          return valid[valid.size() / 2];
+        return (valid[valid.size() / 2] + valid[(valid.size() / 2) - 1]) / 2.0f;
+      case QUANTILE: {
+        std::sort(valid.begin(), valid.end());
+        size_t position = ceilf(valid.size() * QUANTILE_VALUE) - 1;
+        return valid[position];
+      }
+      case MIN:
+        return *std::min_element(valid.begin(), valid.end());
+      case MAX:
+        return *std::max_element(valid.begin(), valid.end());
+      case AVERAGE:
+      default: {
+        float sum = 0;
+        for (auto v : valid)
+          sum += v;
+        return sum / valid.size();
+      }
+    }
+  }
+
+  FilterType type_;
+  size_t send_every_;
+  size_t send_at_;
+  size_t window_size_;
+  std::deque<float> queue_;
+};
+
+std::unique_ptr<Filter> make_filter(FilterType type, size_t window_size, size_t send_every, size_t send_first_at) {
+  switch (type) {
+    case MEDIAN:
+      return make_unique<MedianFilter>(window_size, send_every, send_first_at);
+    case QUANTILE:
+      return make_unique<QuantileFilter>(window_size, send_every, send_first_at, QUANTILE_VALUE);
+    case MIN:
+      return make_unique<MinFilter>(window_size, send_every, send_first_at);
+    case MAX:
+      return make_unique<MaxFilter>(window_size, send_every, send_first_at);
+    case AVERAGE:
+    default:
+      return make_unique<SlidingWindowMovingAverageFilter>(window_size, send_every, send_first_at);
+  }
+}
+
+std::vector<float> random_values(size_t count, float nan_ratio, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+  std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+  std::vector<float> values;
+  for (size_t i = 0; i < count; i++)
+    values.push_back(chance(rng) < nan_ratio ? NAN : value(rng));
+  return values;
+}
+
+bool same_output(const optional<float> &a, const optional<float> &b, float tolerance) {
+  if (a.has_value() != b.has_value())
+    return false;
+  if (!a.has_value())
+    return true;
+  if (std::isnan(*a) || std::isnan(*b))
+    return std::isnan(*a) && std::isnan(*b);
+  return std::fabs(*a - *b) <= tolerance;
+}
+
+/// Feed the same values to both implementations and count the outputs that differ.
+int compare(FilterType type, size_t window_size, size_t send_every, size_t send_first_at,
+            const std::vector<float> &values) {
+  DequeFilter before(type, window_size, send_every, send_first_at);
+  auto after = make_filter(type, window_size, send_every, send_first_at);
+  // the running sum of the moving average drifts a little from the sum over the window
+  const float tolerance = type == AVERAGE ? 1e-3f : 0.0f;
+  int mismatches = 0;
+  for (float value : values) {
+    if (!same_output(before.new_value(value), after->new_value(value), tolerance))
+      mismatches++;
+  }
+  return mismatches;
+}
+
+}  // namespace
+
+int main() {
+  // Window sizes around and far below the length of the series make the ring buffers wrap around many times, and each
+  // send_first_at shifts which values are sent.
+  for (int type = MEDIAN; type <= AVERAGE; type++) {
+    uint32_t seed = 1;
+    for (size_t window_size : {1, 2, 3, 5, 16, 100, 600}) {
+      for (size_t send_every : {1, 3, 7}) {
+        for (size_t send_first_at = 1; send_first_at <= send_every; send_first_at++) {
+          for (float nan_ratio : {0.0f, 0.2f, 0.9f}) {
+            auto values = random_values(500, nan_ratio, seed++);
+            int mismatches = compare(FilterType(type), window_size, send_every, send_first_at, values);
+            if (mismatches != 0) {
+              printf("%s window_size=%zu send_every=%zu send_first_at=%zu nan_ratio=%.1f: %d mismatches\n",
+                     FILTER_NAMES[type], window_size, send_every, send_first_at, nan_ratio, mismatches);
+            }
+            HOST_CHECK(mismatches == 0);
+          }
+        }
+      }
+    }
+  }
+
+  {
+    // the first value is sent after send_first_at values, then one every send_every values
+    MinFilter filter(5, 4, 2);
+    std::vector<bool> sent;
+    for (int i = 0; i < 10; i++)
+      sent.push_back(filter.new_value(i).has_value());
+    HOST_CHECK(sent == std::vector<bool>({false, true, false, false, false, true, false, false, false, true}));
+  }
+
+  {
+    // an infinite value only affects the average while it's in the window
+    SlidingWindowMovingAverageFilter filter(3, 1, 1);
+    HOST_CHECK(*filter.new_value(INFINITY) == INFINITY);
+    filter.new_value(1.0f);
+    filter.new_value(2.0f);
+    HOST_CHECK(*filter.new_value(3.0f) == 2.0f);
+  }
+
+  host_test::print_header("sensor_filter (time per value, send_every 1)");
+  char label[64];
+  for (int type : {MEDIAN, MIN, AVERAGE}) {
+    for (size_t window_size : {5, 50, 200, 1000}) {
+      auto values = random_values(4096, 0.0f, 42);
+      const uint32_t iterations = window_size >= 200 ? 20000 : 200000;
+      DequeFilter before(FilterType(type), window_size, 1, 1);
+      auto after = make_filter(FilterType(type), window_size, 1, 1);
+      size_t i = 0, j = 0;
+      float sink = 0;
+      double before_ns = time_ns(iterations, [&]() { sink += *before.new_value(values[i++ % values.size()]); });
+      double after_ns = time_ns(iterations, [&]() { sink += *after->new_value(values[j++ % values.size()]); });
+      HOST_CHECK(!std::isnan(sink));
+      snprintf(label, sizeof(label), "%s, window of %zu", FILTER_NAMES[type], window_size);
+      host_test::print_timing(label, before_ns, after_ns);
+    }
+  }
+
+  return host_test::failures;
+}